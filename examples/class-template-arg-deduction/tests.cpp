@@ -1,10 +1,13 @@
 #include "catch.hpp"
+#include "utils/MonotonicArena.hpp"
 #include "utils/RangePrinter.hpp"
+#include "utils/Vector.hpp"
 
 #include <boost/type_index.hpp>
 
 #include <iostream>
 #include <map>
+#include <memory_resource>
 #include <string>
 #include <tuple>
 
@@ -203,18 +206,11 @@ TEST_CASE("Class template argument deduction")
 
 namespace training
 {
-    template <typename T>
-    struct vector
-    {
-        template <typename Iterator>
-        vector(Iterator begin, Iterator end)
-        {
-            /*...*/
-        }
-    };
-
-    template <typename Iterator>
-    vector(Iterator, Iterator)->vector<typename std::iterator_traits<Iterator>::value_type>;
+    // Full allocator-aware vector, its deduction guides are in utils/Vector.hpp:
+    //
+    // template <typename Iterator, typename Allocator = std::allocator<iter_value_t<Iterator>>>
+    // vector(Iterator, Iterator, Allocator = Allocator())->vector<iter_value_t<Iterator>, Allocator>;
+    using utils::vector;
 }
 
 TEST_CASE("Deduction guide")
@@ -226,6 +222,17 @@ TEST_CASE("Deduction guide")
 
     REQUIRE(std::is_same_v<decltype(copy_range1), training::vector<int>>);
 
+    SECTION("allocator is deduced too")
+    {
+        std::pmr::polymorphic_allocator<int> allocator;
+        training::vector copy_range2(std::begin(range), std::end(range), allocator);
+        REQUIRE(std::is_same_v<decltype(copy_range2), training::vector<int, std::pmr::polymorphic_allocator<int>>>);
+
+        utils::MonotonicArena arena;
+        training::vector copy_range3(std::begin(range), std::end(range), &arena);
+        REQUIRE(std::is_same_v<decltype(copy_range3), utils::pmr::vector<int>>);
+    }
+
     SECTION("list-initialisation has priority")
     {
         std::vector v1(std::begin(range), std::end(range));
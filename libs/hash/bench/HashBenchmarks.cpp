@@ -0,0 +1,345 @@
+#include <benchmark/benchmark.h>
+#include "hash/Hash.hpp"
+#include "hash/HashMany.hpp"
+#include "traits/TieFields.hpp"
+
+#include <cstdint>
+#include <functional>
+#include <numeric>
+#include <string>
+#include <tuple>
+#include <unordered_set>
+#include <vector>
+
+// The combiner from exercises/fold-expressions, kept here as the baseline.
+namespace legacy
+{
+template <typename T>
+void hash_combine(std::size_t& seed, const T& arg)
+{
+    seed += std::hash<T>{}(arg) + 2828293 + (seed >> 5) + (seed << 2);
+}
+
+template <typename T, typename... Ts>
+std::size_t hash(const T& arg, const Ts&... args)
+{
+    std::size_t seed{ 0 };
+    (hash_combine(seed, arg), ..., hash_combine(seed, args));
+    return seed;
+}
+}
+
+namespace
+{
+struct Record
+{
+    std::uint64_t id;
+    std::uint32_t x;
+    std::uint32_t y;
+    std::uint64_t timestamp;
+};
+
+std::vector<Record> makeRecords(std::size_t size)
+{
+    std::vector<Record> records(size);
+    for(std::size_t i = 0; i < size; ++i)
+    {
+        records[i] = {i, static_cast<std::uint32_t>(i * 3), static_cast<std::uint32_t>(i * 7), i << 20};
+    }
+    return records;
+}
+
+// The same fields once reflected and once with the tie() member the exercises write by hand.
+struct Employee
+{
+    std::string name;
+    std::string surname;
+    std::uint32_t age;
+    std::uint32_t salary;
+};
+
+struct TiedEmployee
+{
+    std::string name;
+    std::string surname;
+    std::uint32_t age;
+    std::uint32_t salary;
+
+    auto tie() const
+    {
+        return std::tie(name, surname, age, salary);
+    }
+
+    bool operator==(const TiedEmployee& other) const { return tie() == other.tie(); }
+};
+
+template<typename T>
+std::vector<T> makeEmployees(std::size_t size)
+{
+    std::vector<T> employees(size);
+    for(std::size_t i = 0; i < size; ++i)
+    {
+        employees[i] = {"Jan", "Kowalski" + std::to_string(i % 64), static_cast<std::uint32_t>(i % 70),
+                        static_cast<std::uint32_t>(i * 100)};
+    }
+    return employees;
+}
+
+template<typename T, typename Hash>
+void hashEmployees(benchmark::State& state, Hash hashEmployee)
+{
+    const auto employees = makeEmployees<T>(4096);
+    for(auto _ : state)
+    {
+        std::size_t sum{};
+        for(const auto& employee : employees)
+        {
+            sum += hashEmployee(employee);
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * employees.size()));
+}
+
+template<typename T, typename Equal>
+void compareEmployees(benchmark::State& state, Equal equal)
+{
+    const auto employees = makeEmployees<T>(4096);
+    const auto copies = employees;
+    for(auto _ : state)
+    {
+        std::size_t count{};
+        for(std::size_t i = 0; i < employees.size(); ++i)
+        {
+            count += equal(employees[i], copies[i]);
+        }
+        benchmark::DoNotOptimize(count);
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * employees.size()));
+}
+
+std::vector<std::string> makeStrings(std::size_t size, std::size_t length)
+{
+    std::vector<std::string> strings(size);
+    for(std::size_t i = 0; i < size; ++i)
+    {
+        strings[i] = std::string(length, 'x') + std::to_string(i);
+    }
+    return strings;
+}
+
+template<typename Hash>
+std::size_t distinctLowBits(const std::vector<Record>& records, Hash hashRecord)
+{
+    std::unordered_set<std::size_t> buckets;
+    for(const auto& record : records)
+    {
+        buckets.insert(hashRecord(record) & 0xfff);
+    }
+    return buckets.size();
+}
+}
+
+static void BM_LegacyHashFields(benchmark::State& state)
+{
+    const auto records = makeRecords(4096);
+    auto hashRecord = [](const Record& r) { return legacy::hash(r.id, r.x, r.y, r.timestamp); };
+    for(auto _ : state)
+    {
+        std::size_t sum{};
+        for(const auto& record : records)
+        {
+            sum += hashRecord(record);
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * records.size()));
+    state.counters["buckets_of_4096"] = static_cast<double>(distinctLowBits(records, hashRecord));
+}
+BENCHMARK(BM_LegacyHashFields);
+
+static void BM_HashFields(benchmark::State& state)
+{
+    const auto records = makeRecords(4096);
+    auto hashRecord = [](const Record& r) { return hash::hash(r.id, r.x, r.y, r.timestamp); };
+    for(auto _ : state)
+    {
+        std::size_t sum{};
+        for(const auto& record : records)
+        {
+            sum += hashRecord(record);
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * records.size()));
+    state.counters["buckets_of_4096"] = static_cast<double>(distinctLowBits(records, hashRecord));
+}
+BENCHMARK(BM_HashFields);
+
+static void BM_HashRecordAsBlock(benchmark::State& state)
+{
+    const auto records = makeRecords(4096);
+    auto hashRecord = [](const Record& r) { return static_cast<std::size_t>(hash::hashValue(r)); };
+    for(auto _ : state)
+    {
+        std::size_t sum{};
+        for(const auto& record : records)
+        {
+            sum += hashRecord(record);
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * records.size()));
+    state.counters["buckets_of_4096"] = static_cast<double>(distinctLowBits(records, hashRecord));
+}
+BENCHMARK(BM_HashRecordAsBlock);
+
+static void BM_HashTiedAggregate(benchmark::State& state)
+{
+    hashEmployees<TiedEmployee>(state, [](const TiedEmployee& e) { return hash::hash_tuple(e.tie()); });
+}
+BENCHMARK(BM_HashTiedAggregate);
+
+static void BM_HashReflectedAggregate(benchmark::State& state)
+{
+    hashEmployees<Employee>(state, [](const Employee& e) { return static_cast<std::size_t>(hash::hashValue(e)); });
+}
+BENCHMARK(BM_HashReflectedAggregate);
+
+static void BM_CompareTiedAggregate(benchmark::State& state)
+{
+    compareEmployees<TiedEmployee>(state, [](const TiedEmployee& lhs, const TiedEmployee& rhs) { return lhs == rhs; });
+}
+BENCHMARK(BM_CompareTiedAggregate);
+
+static void BM_CompareReflectedAggregate(benchmark::State& state)
+{
+    compareEmployees<Employee>(state, traits::FieldsEqual{});
+}
+BENCHMARK(BM_CompareReflectedAggregate);
+
+static void BM_LegacyHashStrings(benchmark::State& state)
+{
+    const auto strings = makeStrings(1024, static_cast<std::size_t>(state.range(0)));
+    for(auto _ : state)
+    {
+        std::size_t sum{};
+        for(const auto& text : strings)
+        {
+            sum += legacy::hash(text);
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * strings.size() * strings[0].size()));
+}
+BENCHMARK(BM_LegacyHashStrings)->Arg(8)->Arg(64)->Arg(1024);
+
+static void BM_HashStrings(benchmark::State& state)
+{
+    const auto strings = makeStrings(1024, static_cast<std::size_t>(state.range(0)));
+    for(auto _ : state)
+    {
+        std::size_t sum{};
+        for(const auto& text : strings)
+        {
+            sum += hash::hash(text);
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * strings.size() * strings[0].size()));
+}
+BENCHMARK(BM_HashStrings)->Arg(8)->Arg(64)->Arg(1024);
+
+static void BM_LegacyHashVectorElementwise(benchmark::State& state)
+{
+    std::vector<std::uint32_t> values(static_cast<std::size_t>(state.range(0)));
+    std::iota(values.begin(), values.end(), 0u);
+    for(auto _ : state)
+    {
+        std::size_t seed{};
+        for(auto value : values)
+        {
+            legacy::hash_combine(seed, value);
+        }
+        benchmark::DoNotOptimize(seed);
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * values.size() * sizeof(std::uint32_t)));
+}
+BENCHMARK(BM_LegacyHashVectorElementwise)->Arg(1 << 16);
+
+static void BM_HashVectorBulk(benchmark::State& state)
+{
+    std::vector<std::uint32_t> values(static_cast<std::size_t>(state.range(0)));
+    std::iota(values.begin(), values.end(), 0u);
+    for(auto _ : state)
+    {
+        benchmark::DoNotOptimize(hash::hashValue(values));
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * values.size() * sizeof(std::uint32_t)));
+}
+BENCHMARK(BM_HashVectorBulk)->Arg(1 << 16);
+
+static void BM_HashKeysOneByOne(benchmark::State& state)
+{
+    std::vector<std::uint64_t> keys(static_cast<std::size_t>(state.range(0)));
+    std::iota(keys.begin(), keys.end(), 0u);
+    std::vector<std::uint64_t> out(keys.size());
+    for(auto _ : state)
+    {
+        for(std::size_t i = 0; i < keys.size(); ++i)
+        {
+            out[i] = hash::hash(keys[i]);
+        }
+        benchmark::DoNotOptimize(out.data());
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * keys.size()));
+}
+BENCHMARK(BM_HashKeysOneByOne)->Arg(1 << 16);
+
+static void BM_HashMany(benchmark::State& state, hash::HashKernel kernel)
+{
+    if(not hash::isHashKernelSupported(kernel))
+    {
+        return state.SkipWithError("kernel not supported by this CPU");
+    }
+    std::vector<std::uint32_t> keys(static_cast<std::size_t>(state.range(0)));
+    std::iota(keys.begin(), keys.end(), 0u);
+    std::vector<std::uint64_t> out(keys.size());
+    for(auto _ : state)
+    {
+        hash::hash_many(keys, out, kernel);
+        benchmark::DoNotOptimize(out.data());
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * keys.size()));
+}
+BENCHMARK_CAPTURE(BM_HashMany, Scalar, hash::HashKernel::Scalar)->Arg(1 << 16);
+BENCHMARK_CAPTURE(BM_HashMany, Avx2, hash::HashKernel::Avx2)->Arg(1 << 16);
+BENCHMARK_CAPTURE(BM_HashMany, Avx512, hash::HashKernel::Avx512)->Arg(1 << 16);
+
+static void BM_HashColumns(benchmark::State& state, hash::HashKernel kernel)
+{
+    if(not hash::isHashKernelSupported(kernel))
+    {
+        return state.SkipWithError("kernel not supported by this CPU");
+    }
+    const auto records = makeRecords(static_cast<std::size_t>(state.range(0)));
+    std::vector<std::uint64_t> ids, timestamps;
+    std::vector<std::uint32_t> xs, ys;
+    for(const auto& record : records)
+    {
+        ids.push_back(record.id);
+        xs.push_back(record.x);
+        ys.push_back(record.y);
+        timestamps.push_back(record.timestamp);
+    }
+    std::vector<std::uint64_t> out(records.size());
+    for(auto _ : state)
+    {
+        hash::hash_many(std::tie(ids, xs, ys, timestamps), out, kernel);
+        benchmark::DoNotOptimize(out.data());
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * records.size()));
+}
+BENCHMARK_CAPTURE(BM_HashColumns, Scalar, hash::HashKernel::Scalar)->Arg(1 << 16);
+BENCHMARK_CAPTURE(BM_HashColumns, Avx2, hash::HashKernel::Avx2)->Arg(1 << 16);
+BENCHMARK_CAPTURE(BM_HashColumns, Avx512, hash::HashKernel::Avx512)->Arg(1 << 16);
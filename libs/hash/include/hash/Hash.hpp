@@ -0,0 +1,292 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <iterator>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include "hash/WyHash.hpp"
+#include "traits/FieldCount.hpp"
+#include "traits/IsContiguousRange.hpp"
+#include "traits/IsIterable.hpp"
+#include "traits/IsStringLike.hpp"
+#include "traits/IsTupleLike.hpp"
+#include "traits/TieFields.hpp"
+
+namespace hash
+{
+template<typename T>
+std::uint64_t hashValue(const T& value);
+
+namespace detail
+{
+template<typename, typename = void>
+constexpr bool is_std_hashable{};
+
+template<typename T>
+constexpr bool is_std_hashable<T, std::enable_if_t<std::is_default_constructible_v<std::hash<T>>>> = true;
+
+// Objects whose bytes are equal exactly when the objects are, these are hashed as one block.
+// A class with its own std::hash keeps it, the specialization may ignore some of the bytes.
+template<typename T>
+constexpr bool is_bytewise_hashable = std::has_unique_object_representations_v<T> and not std::is_pointer_v<T> and
+                                      not(std::is_class_v<T> and is_std_hashable<T>);
+
+template<typename, typename = void>
+constexpr bool is_bytewise_hashable_range{};
+
+template<typename T>
+constexpr bool is_bytewise_hashable_range<
+    T,
+    std::enable_if_t<traits::is_contiguous_range<const T>>
+> = is_bytewise_hashable<std::remove_cv_t<std::remove_pointer_t<decltype(std::data(std::declval<const T&>()))>>>;
+
+template<typename Tuple, std::size_t... Is>
+std::uint64_t hashTupleImpl(const Tuple& tuple, std::index_sequence<Is...>);
+
+template<typename T, std::size_t... Ks>
+std::uint64_t hashFields(const T& value, std::index_sequence<Ks...>);
+}
+
+namespace detail
+{
+// What hash_combine feeds into combine() for arg. Integers and enums go in as they are, which
+// saves hashing them on their own first; hash() finishes the fold with one more mum so
+// their low bits still avalanche.
+template<typename T>
+inline std::uint64_t combineInput(const T& arg)
+{
+    if constexpr(std::is_integral_v<T> or std::is_enum_v<T>)
+    {
+        return static_cast<std::uint64_t>(arg);
+    }
+    else
+    {
+        return hashValue(arg);
+    }
+}
+
+// The raw input only ever meets the seed, never the constant operand of the mum, so no
+// input can zero the product and wipe out what was folded in before. Xoring input back in
+// keeps it in the result even when seed ^ input ^ secret[0] happens to be zero.
+inline std::uint64_t combine(std::uint64_t seed, std::uint64_t input)
+{
+    return mix(seed ^ input ^ secret[0], secret[1]) ^ input;
+}
+
+inline std::uint64_t finish(std::uint64_t seed)
+{
+    return mix(seed ^ secret[2], secret[3]);
+}
+
+// A run of adjacent fields hashed together, length is 0 for fields inside an earlier run.
+struct FieldBlock
+{
+    std::size_t length;
+    std::size_t bytes;
+};
+
+template<typename Field>
+constexpr std::size_t storedSize = std::is_reference_v<Field> ? sizeof(void*) : sizeof(Field);
+
+template<typename Field>
+constexpr std::size_t storedAlignment = std::is_reference_v<Field> ? alignof(void*) : alignof(Field);
+
+template<typename Field>
+constexpr bool is_block_field = not std::is_reference_v<Field> and is_bytewise_hashable<std::remove_cv_t<Field>>;
+
+constexpr std::size_t alignUp(std::size_t offset, std::size_t alignment)
+{
+    return (offset + alignment - 1) / alignment * alignment;
+}
+
+// Lays the fields out the way the compiler does for an aggregate without bases and joins
+// neighbours that are hashed bytewise and have no padding between them. When the layout
+// does not add up to sizeof(T) (e.g. alignas on a field) every field stays on its own.
+template<typename T, typename... Fields>
+constexpr auto fieldBlocks(traits::TypeList<Fields...>)
+{
+    constexpr std::size_t sizes[]{storedSize<Fields>...};
+    constexpr std::size_t alignments[]{storedAlignment<Fields>...};
+    constexpr bool packable[]{is_block_field<Fields>...};
+
+    std::array<FieldBlock, sizeof...(Fields)> blocks{};
+    std::size_t offset{}, start{};
+    for(std::size_t k = 0; k < sizeof...(Fields); ++k)
+    {
+        const auto aligned = alignUp(offset, alignments[k]);
+        if(k == 0 or not packable[k - 1] or not packable[k] or aligned != offset)
+        {
+            start = k;
+        }
+        blocks[start].length += 1;
+        blocks[start].bytes += sizes[k];
+        offset = aligned + sizes[k];
+    }
+
+    if(alignUp(offset, alignof(T)) != sizeof(T))
+    {
+        for(std::size_t k = 0; k < sizeof...(Fields); ++k)
+        {
+            blocks[k] = {1, sizes[k]};
+        }
+    }
+    return blocks;
+}
+
+template<std::size_t Length, std::size_t Bytes, typename Field>
+inline std::uint64_t combineBlock(std::uint64_t seed, const Field& first)
+{
+    if constexpr(Length == 0)
+    {
+        return seed;
+    }
+    else if constexpr(Length == 1)
+    {
+        return combine(seed, combineInput(first));
+    }
+    else if constexpr(Bytes <= sizeof(std::uint64_t))
+    {
+        // Goes in raw like a single integer field would, one mum for the whole block.
+        std::uint64_t word{};
+        std::memcpy(&word, &first, Bytes);
+        return combine(seed, word);
+    }
+    else
+    {
+        return combine(seed, hashBytes(&first, Bytes));
+    }
+}
+}
+
+// Folds arg into seed with a wyhash mum, unlike the additive combiner from the
+// fold-expressions exercise every bit of seed and arg reaches the whole result.
+template<typename T>
+inline void hash_combine(std::size_t& seed, const T& arg)
+{
+    seed = static_cast<std::size_t>(detail::combine(seed, detail::combineInput(arg)));
+}
+
+template<typename T, typename... Ts>
+inline std::size_t hash(const T& arg, const Ts&... args)
+{
+    std::size_t seed{0};
+    (hash_combine(seed, arg), ..., hash_combine(seed, args));
+    return static_cast<std::size_t>(detail::finish(seed));
+}
+
+// Any tuple-like (std::tuple, std::pair, std::array or a type with tuple_size/get),
+// hash_tuple(std::tie(a, b)) == hash(a, b).
+template<typename Tuple, typename std::enable_if_t<traits::is_tuple_like<Tuple>, int> = 0>
+inline std::size_t hash_tuple(const Tuple& tuple)
+{
+    static_assert(std::tuple_size<Tuple>::value != 0, "hash needs at least one value");
+    return static_cast<std::size_t>(
+        detail::hashTupleImpl(tuple, std::make_index_sequence<std::tuple_size<Tuple>::value>{}));
+}
+
+// Hash of a single value:
+// - strings of any flavour hash their characters, so std::string, std::string_view, C strings
+//   and string literals with equal text hash equally,
+// - integers, enums and other types with unique object representations hash their bytes,
+//   unless they are classes with a std::hash specialization, which always takes precedence,
+//   floating point values are normalised first so 0.0 and -0.0 hash equally,
+// - contiguous ranges of such types are hashed as one block, other ranges element by element,
+// - tuple-likes combine their elements, so do aggregates without a std::hash specialization;
+//   their fields are reached through structured bindings and adjacent fields without padding
+//   between them are hashed as one block, otherwise hashValue(a) == hash_tuple(tieFields(a)),
+// - anything else goes through std::hash.
+template<typename T>
+inline std::uint64_t hashValue(const T& value)
+{
+    if constexpr(traits::is_string_like<T> or (std::is_array_v<T> and std::is_same_v<std::remove_extent_t<T>, char>))
+    {
+        const std::string_view text{value};
+        return hashBytes(text.data(), text.size());
+    }
+    else if constexpr(std::is_integral_v<T> or std::is_enum_v<T>)
+    {
+        return hashWord(static_cast<std::uint64_t>(value));
+    }
+    else if constexpr(std::is_floating_point_v<T>)
+    {
+        const auto normalized = value == T{} ? T{} : value;
+        if constexpr(sizeof(T) == sizeof(std::uint64_t))
+        {
+            std::uint64_t bits;
+            std::memcpy(&bits, &normalized, sizeof(bits));
+            return hashWord(bits);
+        }
+        else
+        {
+            return hashWord(static_cast<std::uint64_t>(std::hash<T>{}(normalized)));
+        }
+    }
+    else if constexpr(detail::is_bytewise_hashable<T>)
+    {
+        return hashBytes(&value, sizeof(T));
+    }
+    else if constexpr(detail::is_bytewise_hashable_range<T>)
+    {
+        return hashBytes(std::data(value), std::size(value) * sizeof(*std::data(value)));
+    }
+    else if constexpr(traits::is_iterable<T>)
+    {
+        std::uint64_t seed{detail::secret[2]};
+        std::size_t size{};
+        for(const auto& element : value)
+        {
+            seed = detail::combine(seed, hashValue(element));
+            ++size;
+        }
+        return detail::finish(detail::combine(seed, size));
+    }
+    else if constexpr(traits::is_tuple_like<T>)
+    {
+        return hash_tuple(value);
+    }
+    else if constexpr(traits::is_reflectable<T> and not detail::is_std_hashable<T>)
+    {
+        return detail::hashFields(value, std::make_index_sequence<traits::field_count<T>>{});
+    }
+    else
+    {
+        return hashWord(static_cast<std::uint64_t>(std::hash<T>{}(value)));
+    }
+}
+
+namespace detail
+{
+template<typename Tuple, std::size_t... Is>
+inline std::uint64_t hashTupleImpl(const Tuple& tuple, std::index_sequence<Is...>)
+{
+    using std::get;
+    return hash(get<Is>(tuple)...);
+}
+
+template<typename T, std::size_t... Ks>
+inline std::uint64_t hashFields(const T& value, std::index_sequence<Ks...>)
+{
+    constexpr auto blocks = fieldBlocks<T>(traits::declared_fields_t<T>{});
+    const auto fields = traits::tieFields(value);
+    std::uint64_t seed{0};
+    ((seed = combineBlock<blocks[Ks].length, blocks[Ks].bytes>(seed, std::get<Ks>(fields))), ...);
+    return finish(seed);
+}
+}
+
+// Drop-in hasher for unordered containers, e.g. std::unordered_set<Key, hash::Hasher>.
+struct Hasher
+{
+    template<typename T>
+    std::size_t operator()(const T& value) const
+    {
+        return static_cast<std::size_t>(hashValue(value));
+    }
+};
+}
@@ -0,0 +1,332 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+#include <stdexcept>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include "hash/Hash.hpp"
+#include "traits/IsContiguousRange.hpp"
+
+#if defined(__GNUC__) && defined(__x86_64__)
+#define HASH_HAS_X86_BATCH_KERNELS 1
+#include <immintrin.h>
+#endif
+
+namespace hash
+{
+enum class HashKernel
+{
+    Scalar,
+    Avx2,  // 4 keys per step
+    Avx512 // 8 keys per step
+};
+
+namespace detail
+{
+template<typename T>
+using column_integer_t = typename std::conditional_t<std::is_enum_v<T>, std::underlying_type<T>, std::enable_if<true, T>>::type;
+
+// Columns loaded straight into the lanes, everything else is run through combineInput() first.
+template<typename T>
+constexpr bool is_direct_column = (std::is_integral_v<T> or std::is_enum_v<T>) and sizeof(T) <= sizeof(std::uint64_t);
+
+template<typename... Columns>
+inline void hashColumnsScalar(std::uint64_t* out, std::size_t first, std::size_t count, const Columns*... columns)
+{
+    for(std::size_t row = first; row < count; ++row)
+    {
+        out[row] = hash(columns[row]...);
+    }
+}
+
+#ifdef HASH_HAS_X86_BATCH_KERNELS
+// mix() on every 64-bit lane: the 128-bit product is put together from four 32x32 products.
+__attribute__((target("avx2"), always_inline))
+inline __m256i mixAvx2(__m256i a, __m256i b)
+{
+    const __m256i lowMask = _mm256_set1_epi64x(0xffffffff);
+    const __m256i aHigh = _mm256_srli_epi64(a, 32);
+    const __m256i bHigh = _mm256_srli_epi64(b, 32);
+    const __m256i lowLow = _mm256_mul_epu32(a, b);
+    const __m256i lowHigh = _mm256_mul_epu32(a, bHigh);
+    const __m256i highLow = _mm256_mul_epu32(aHigh, b);
+    const __m256i highHigh = _mm256_mul_epu32(aHigh, bHigh);
+    const __m256i middle = _mm256_add_epi64(_mm256_add_epi64(_mm256_srli_epi64(lowLow, 32),
+                                                             _mm256_and_si256(lowHigh, lowMask)),
+                                            _mm256_and_si256(highLow, lowMask));
+    const __m256i low = _mm256_or_si256(_mm256_and_si256(lowLow, lowMask), _mm256_slli_epi64(middle, 32));
+    const __m256i high = _mm256_add_epi64(_mm256_add_epi64(highHigh, _mm256_srli_epi64(lowHigh, 32)),
+                                          _mm256_add_epi64(_mm256_srli_epi64(highLow, 32), _mm256_srli_epi64(middle, 32)));
+    return _mm256_xor_si256(low, high);
+}
+
+// combine() on every lane.
+__attribute__((target("avx2"), always_inline))
+inline __m256i combineAvx2(__m256i seed, __m256i input, __m256i secret0, __m256i secret1)
+{
+    return _mm256_xor_si256(mixAvx2(_mm256_xor_si256(_mm256_xor_si256(seed, input), secret0), secret1), input);
+}
+
+// The four values combineInput() would produce for values[0..3].
+template<typename T>
+__attribute__((target("avx2"), always_inline))
+inline __m256i loadLanesAvx2(const T* values)
+{
+    if constexpr(is_direct_column<T>)
+    {
+        constexpr bool isSigned = std::is_signed_v<column_integer_t<T>>;
+        if constexpr(sizeof(T) == 8)
+        {
+            return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(values));
+        }
+        else if constexpr(sizeof(T) == 4)
+        {
+            const __m128i packed = _mm_loadu_si128(reinterpret_cast<const __m128i*>(values));
+            return isSigned ? _mm256_cvtepi32_epi64(packed) : _mm256_cvtepu32_epi64(packed);
+        }
+        else if constexpr(sizeof(T) == 2)
+        {
+            const __m128i packed = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(values));
+            return isSigned ? _mm256_cvtepi16_epi64(packed) : _mm256_cvtepu16_epi64(packed);
+        }
+        else
+        {
+            std::int32_t bytes;
+            std::memcpy(&bytes, values, sizeof(bytes));
+            const __m128i packed = _mm_cvtsi32_si128(bytes);
+            return isSigned ? _mm256_cvtepi8_epi64(packed) : _mm256_cvtepu8_epi64(packed);
+        }
+    }
+    else
+    {
+        return _mm256_set_epi64x(static_cast<long long>(combineInput(values[3])), static_cast<long long>(combineInput(values[2])),
+                                 static_cast<long long>(combineInput(values[1])), static_cast<long long>(combineInput(values[0])));
+    }
+}
+
+template<typename... Columns>
+__attribute__((target("avx2")))
+inline void hashColumnsAvx2(std::uint64_t* out, std::size_t count, const Columns*... columns)
+{
+    const __m256i secret0 = _mm256_set1_epi64x(static_cast<long long>(secret[0]));
+    const __m256i secret1 = _mm256_set1_epi64x(static_cast<long long>(secret[1]));
+    const __m256i secret2 = _mm256_set1_epi64x(static_cast<long long>(secret[2]));
+    const __m256i secret3 = _mm256_set1_epi64x(static_cast<long long>(secret[3]));
+
+    std::size_t row{};
+    for(; row + 4 <= count; row += 4)
+    {
+        __m256i seed = _mm256_setzero_si256();
+        ((seed = combineAvx2(seed, loadLanesAvx2(columns + row), secret0, secret1)), ...);
+        seed = mixAvx2(_mm256_xor_si256(seed, secret2), secret3);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + row), seed);
+    }
+    hashColumnsScalar(out, row, count, columns...);
+}
+
+// GCC 12 warns from inside avx512fintrin.h that the undefined vectors its intrinsics
+// start from may be used uninitialized. They never are, the warning is a false positive.
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+__attribute__((target("avx512f"), always_inline))
+inline __m512i mixAvx512(__m512i a, __m512i b)
+{
+    const __m512i lowMask = _mm512_set1_epi64(0xffffffff);
+    const __m512i aHigh = _mm512_srli_epi64(a, 32);
+    const __m512i bHigh = _mm512_srli_epi64(b, 32);
+    const __m512i lowLow = _mm512_mul_epu32(a, b);
+    const __m512i lowHigh = _mm512_mul_epu32(a, bHigh);
+    const __m512i highLow = _mm512_mul_epu32(aHigh, b);
+    const __m512i highHigh = _mm512_mul_epu32(aHigh, bHigh);
+    const __m512i middle = _mm512_add_epi64(_mm512_add_epi64(_mm512_srli_epi64(lowLow, 32),
+                                                             _mm512_and_si512(lowHigh, lowMask)),
+                                            _mm512_and_si512(highLow, lowMask));
+    const __m512i low = _mm512_or_si512(_mm512_and_si512(lowLow, lowMask), _mm512_slli_epi64(middle, 32));
+    const __m512i high = _mm512_add_epi64(_mm512_add_epi64(highHigh, _mm512_srli_epi64(lowHigh, 32)),
+                                          _mm512_add_epi64(_mm512_srli_epi64(highLow, 32), _mm512_srli_epi64(middle, 32)));
+    return _mm512_xor_si512(low, high);
+}
+
+__attribute__((target("avx512f"), always_inline))
+inline __m512i combineAvx512(__m512i seed, __m512i input, __m512i secret0, __m512i secret1)
+{
+    return _mm512_xor_si512(mixAvx512(_mm512_xor_si512(_mm512_xor_si512(seed, input), secret0), secret1), input);
+}
+
+template<typename T>
+__attribute__((target("avx512f"), always_inline))
+inline __m512i loadLanesAvx512(const T* values)
+{
+    if constexpr(is_direct_column<T>)
+    {
+        constexpr bool isSigned = std::is_signed_v<column_integer_t<T>>;
+        if constexpr(sizeof(T) == 8)
+        {
+            return _mm512_loadu_si512(values);
+        }
+        else if constexpr(sizeof(T) == 4)
+        {
+            const __m256i packed = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(values));
+            return isSigned ? _mm512_cvtepi32_epi64(packed) : _mm512_cvtepu32_epi64(packed);
+        }
+        else if constexpr(sizeof(T) == 2)
+        {
+            const __m128i packed = _mm_loadu_si128(reinterpret_cast<const __m128i*>(values));
+            return isSigned ? _mm512_cvtepi16_epi64(packed) : _mm512_cvtepu16_epi64(packed);
+        }
+        else
+        {
+            const __m128i packed = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(values));
+            return isSigned ? _mm512_cvtepi8_epi64(packed) : _mm512_cvtepu8_epi64(packed);
+        }
+    }
+    else
+    {
+        alignas(64) std::uint64_t inputs[8];
+        for(std::size_t lane = 0; lane < 8; ++lane)
+        {
+            inputs[lane] = combineInput(values[lane]);
+        }
+        return _mm512_load_si512(inputs);
+    }
+}
+
+template<typename... Columns>
+__attribute__((target("avx512f")))
+inline void hashColumnsAvx512(std::uint64_t* out, std::size_t count, const Columns*... columns)
+{
+    const __m512i secret0 = _mm512_set1_epi64(static_cast<long long>(secret[0]));
+    const __m512i secret1 = _mm512_set1_epi64(static_cast<long long>(secret[1]));
+    const __m512i secret2 = _mm512_set1_epi64(static_cast<long long>(secret[2]));
+    const __m512i secret3 = _mm512_set1_epi64(static_cast<long long>(secret[3]));
+
+    std::size_t row{};
+    for(; row + 8 <= count; row += 8)
+    {
+        __m512i seed = _mm512_setzero_si512();
+        ((seed = combineAvx512(seed, loadLanesAvx512(columns + row), secret0, secret1)), ...);
+        seed = mixAvx512(_mm512_xor_si512(seed, secret2), secret3);
+        _mm512_storeu_si512(out + row, seed);
+    }
+    hashColumnsScalar(out, row, count, columns...);
+}
+#pragma GCC diagnostic pop
+
+inline bool cpuSupportsHashKernel(HashKernel kernel)
+{
+    __builtin_cpu_init();
+    switch(kernel)
+    {
+    case HashKernel::Scalar:
+        return true;
+    case HashKernel::Avx2:
+        return __builtin_cpu_supports("avx2");
+    case HashKernel::Avx512:
+        return __builtin_cpu_supports("avx512f");
+    }
+    return false;
+}
+#else
+inline bool cpuSupportsHashKernel(HashKernel kernel)
+{
+    return kernel == HashKernel::Scalar;
+}
+#endif
+
+template<typename Tuple, std::size_t... Is>
+inline std::size_t commonColumnSize(const Tuple& columns, std::index_sequence<Is...>)
+{
+    const std::size_t sizes[]{std::size(std::get<Is>(columns))...};
+    for(auto size : sizes)
+    {
+        if(size != sizes[0])
+        {
+            throw std::invalid_argument{"hash_many: columns differ in length"};
+        }
+    }
+    return sizes[0];
+}
+}
+
+inline bool isHashKernelSupported(HashKernel kernel)
+{
+    static const bool supported[]{true, detail::cpuSupportsHashKernel(HashKernel::Avx2),
+                                  detail::cpuSupportsHashKernel(HashKernel::Avx512)};
+    return supported[static_cast<std::size_t>(kernel)];
+}
+
+// Avx512 when the CPU has it, Scalar otherwise: the 32x32 products Avx2 builds every 128-bit
+// product from cost more than four scalar mulx, so it only pays off as a fallback for CPUs
+// with slow scalar multiplication.
+inline HashKernel defaultHashKernel()
+{
+    static const HashKernel kernel = isHashKernelSupported(HashKernel::Avx512) ? HashKernel::Avx512 : HashKernel::Scalar;
+    return kernel;
+}
+
+// out[row] = hash(std::get<0>(columns)[row], std::get<1>(columns)[row], ...) for every row
+// below count, i.e. hash_tuple() of each row without building the rows. Integers and enums
+// are hashed several rows per instruction, other column types are hashed one by one and only
+// combined in the SIMD lanes. Results equal the scalar hash() bit for bit.
+template<typename... Columns>
+inline void hash_columns(const std::tuple<const Columns*...>& columns, std::size_t count, std::uint64_t* out,
+                         HashKernel kernel = defaultHashKernel())
+{
+    static_assert(sizeof...(Columns) != 0, "hash needs at least one column");
+    std::apply([&](const auto*... column) {
+        switch(kernel)
+        {
+#ifdef HASH_HAS_X86_BATCH_KERNELS
+        case HashKernel::Avx512:
+            return detail::hashColumnsAvx512(out, count, column...);
+        case HashKernel::Avx2:
+            return detail::hashColumnsAvx2(out, count, column...);
+#endif
+        default:
+            return detail::hashColumnsScalar(out, 0, count, column...);
+        }
+    }, columns);
+}
+
+// out[i] = hash(keys[i]) for i below count.
+template<typename Key>
+inline void hash_many(const Key* keys, std::size_t count, std::uint64_t* out, HashKernel kernel = defaultHashKernel())
+{
+    hash_columns(std::tuple<const Key*>{keys}, count, out, kernel);
+}
+
+// Same over contiguous ranges, out has to hold at least as many values as keys.
+template<typename Keys, typename Out, typename std::enable_if_t<traits::is_contiguous_range<const Keys>, int> = 0>
+inline void hash_many(const Keys& keys, Out& out, HashKernel kernel = defaultHashKernel())
+{
+    static_assert(std::is_same_v<std::remove_pointer_t<decltype(std::data(out))>, std::uint64_t>,
+                  "hash_many writes std::uint64_t values");
+    if(std::size(out) < std::size(keys))
+    {
+        throw std::invalid_argument{"hash_many: output is shorter than the keys"};
+    }
+    hash_many(std::data(keys), std::size(keys), std::data(out), kernel);
+}
+
+// Columnar variant over a tuple of contiguous ranges of equal length, e.g.
+// hash_many(std::tie(ids, names), out) gives out[i] == hash(ids[i], names[i]).
+template<typename... Columns, typename Out>
+inline void hash_many(const std::tuple<Columns...>& columns, Out& out, HashKernel kernel = defaultHashKernel())
+{
+    static_assert((traits::is_contiguous_range<const std::remove_reference_t<Columns>> and ...),
+                  "hash_many needs contiguous columns");
+    static_assert(std::is_same_v<std::remove_pointer_t<decltype(std::data(out))>, std::uint64_t>,
+                  "hash_many writes std::uint64_t values");
+    const auto count = detail::commonColumnSize(columns, std::index_sequence_for<Columns...>{});
+    if(std::size(out) < count)
+    {
+        throw std::invalid_argument{"hash_many: output is shorter than the columns"};
+    }
+    hash_columns(std::apply([](const auto&... column) { return std::make_tuple(std::data(column)...); }, columns),
+                 count, std::data(out), kernel);
+}
+}
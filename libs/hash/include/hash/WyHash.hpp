@@ -0,0 +1,107 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+namespace hash
+{
+namespace detail
+{
+constexpr std::uint64_t secret[4]{0x2d358dccaa6c78a5ull, 0x8bb84b93962eacc9ull, 0x4b33a62ed433d4a3ull, 0x4d5a2da51de1aa47ull};
+
+inline std::uint64_t read8(const unsigned char* data)
+{
+    std::uint64_t value;
+    std::memcpy(&value, data, sizeof(value));
+    return value;
+}
+
+inline std::uint64_t read4(const unsigned char* data)
+{
+    std::uint32_t value;
+    std::memcpy(&value, data, sizeof(value));
+    return value;
+}
+
+// One to three bytes folded into a word without branching on the length.
+inline std::uint64_t read3(const unsigned char* data, std::size_t size)
+{
+    return (std::uint64_t{data[0]} << 16) | (std::uint64_t{data[size >> 1]} << 8) | data[size - 1];
+}
+}
+
+// Folded 64x64 -> 128 bit multiplication ("mum"), the mixing step of wyhash. Every input bit
+// reaches every output bit, as long as neither operand is zero.
+inline std::uint64_t mix(std::uint64_t a, std::uint64_t b)
+{
+    const auto product = static_cast<unsigned __int128>(a) * b;
+    return static_cast<std::uint64_t>(product) ^ static_cast<std::uint64_t>(product >> 64);
+}
+
+// Hash of a single 64-bit word, cheaper than hashBytes over its 8 bytes.
+inline std::uint64_t hashWord(std::uint64_t value, std::uint64_t seed = 0)
+{
+    return mix(mix(value ^ detail::secret[0], seed ^ detail::secret[1]) ^ detail::secret[2], value ^ detail::secret[3]);
+}
+
+// wyhash (final version 4) of size bytes at data.
+inline std::uint64_t hashBytes(const void* data, std::size_t size, std::uint64_t seed = 0)
+{
+    using detail::read3;
+    using detail::read4;
+    using detail::read8;
+    using detail::secret;
+
+    auto* bytes = static_cast<const unsigned char*>(data);
+    seed ^= mix(seed ^ secret[0], secret[1]);
+
+    std::uint64_t a{};
+    std::uint64_t b{};
+    if(size <= 16)
+    {
+        if(size >= 4)
+        {
+            const auto shift = (size >> 3) << 2;
+            a = (read4(bytes) << 32) | read4(bytes + shift);
+            b = (read4(bytes + size - 4) << 32) | read4(bytes + size - 4 - shift);
+        }
+        else if(size > 0)
+        {
+            a = read3(bytes, size);
+        }
+    }
+    else
+    {
+        auto remaining = size;
+        if(remaining > 48)
+        {
+            auto seed1 = seed;
+            auto seed2 = seed;
+            do
+            {
+                seed = mix(read8(bytes) ^ secret[1], read8(bytes + 8) ^ seed);
+                seed1 = mix(read8(bytes + 16) ^ secret[2], read8(bytes + 24) ^ seed1);
+                seed2 = mix(read8(bytes + 32) ^ secret[3], read8(bytes + 40) ^ seed2);
+                bytes += 48;
+                remaining -= 48;
+            }
+            while(remaining > 48);
+            seed ^= seed1 ^ seed2;
+        }
+        while(remaining > 16)
+        {
+            seed = mix(read8(bytes) ^ secret[1], read8(bytes + 8) ^ seed);
+            bytes += 16;
+            remaining -= 16;
+        }
+        a = read8(bytes + remaining - 16);
+        b = read8(bytes + remaining - 8);
+    }
+
+    a ^= secret[1];
+    b ^= seed;
+    const auto product = static_cast<unsigned __int128>(a) * b;
+    return mix(static_cast<std::uint64_t>(product) ^ secret[0] ^ size, static_cast<std::uint64_t>(product >> 64) ^ secret[1]);
+}
+}
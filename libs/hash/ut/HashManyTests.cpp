@@ -0,0 +1,119 @@
+#include <gtest/gtest.h>
+#include "hash/HashMany.hpp"
+
+#include <array>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <tuple>
+#include <vector>
+
+using namespace ::testing;
+
+namespace
+{
+enum class Color : std::int16_t
+{
+    Red = -1,
+    Green = 7
+};
+
+struct Point
+{
+    std::int32_t x;
+    std::int32_t y;
+};
+
+constexpr std::array<hash::HashKernel, 3> kernels{hash::HashKernel::Scalar, hash::HashKernel::Avx2,
+                                                  hash::HashKernel::Avx512};
+
+template<typename T, typename Generate>
+std::unique_ptr<T[]> makeKeys(std::size_t size, Generate generate)
+{
+    std::unique_ptr<T[]> keys{new T[size]};
+    for(std::size_t i = 0; i < size; ++i)
+    {
+        keys[i] = generate(i);
+    }
+    return keys;
+}
+
+// Every kernel, and every count around the lane widths, has to reproduce the scalar hash().
+template<typename T, typename Generate>
+void expectScalarResults(Generate generate)
+{
+    for(auto kernel : kernels)
+    {
+        if(not hash::isHashKernelSupported(kernel))
+        {
+            continue;
+        }
+        for(std::size_t count = 0; count <= 37; ++count)
+        {
+            const auto keys = makeKeys<T>(count, generate);
+            std::vector<std::uint64_t> out(count);
+            hash::hash_many(keys.get(), count, out.data(), kernel);
+            for(std::size_t i = 0; i < count; ++i)
+            {
+                ASSERT_EQ(out[i], hash::hash(keys[i])) << "kernel " << static_cast<int>(kernel) << " count " << count;
+            }
+        }
+    }
+}
+}
+
+TEST(HashManyTests, shouldMatchScalarHashForIntegers)
+{
+    std::mt19937_64 random{7};
+    expectScalarResults<std::int8_t>([&](std::size_t) { return static_cast<std::int8_t>(random()); });
+    expectScalarResults<std::uint8_t>([&](std::size_t) { return static_cast<std::uint8_t>(random()); });
+    expectScalarResults<std::int16_t>([&](std::size_t) { return static_cast<std::int16_t>(random()); });
+    expectScalarResults<std::uint16_t>([&](std::size_t) { return static_cast<std::uint16_t>(random()); });
+    expectScalarResults<std::int32_t>([&](std::size_t) { return static_cast<std::int32_t>(random()); });
+    expectScalarResults<std::uint32_t>([&](std::size_t) { return static_cast<std::uint32_t>(random()); });
+    expectScalarResults<std::int64_t>([&](std::size_t) { return static_cast<std::int64_t>(random()); });
+    expectScalarResults<std::uint64_t>([&](std::size_t i) { return i % 2 ? std::numeric_limits<std::uint64_t>::max() : i; });
+    expectScalarResults<char>([&](std::size_t) { return static_cast<char>(random()); });
+    expectScalarResults<bool>([&](std::size_t i) { return i % 3 == 0; });
+    expectScalarResults<Color>([&](std::size_t i) { return i % 2 ? Color::Red : Color::Green; });
+}
+
+TEST(HashManyTests, shouldMatchScalarHashForOtherKeys)
+{
+    expectScalarResults<std::string>([](std::size_t i) { return "Test" + std::to_string(i); });
+    expectScalarResults<double>([](std::size_t i) { return i * 0.5 - 3.0; });
+    expectScalarResults<Point>([](std::size_t i) { return Point{static_cast<std::int32_t>(i), -1}; });
+}
+
+TEST(HashManyTests, shouldHashColumnsLikeHashTuple)
+{
+    const std::vector<std::int64_t> ids{1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11};
+    const std::vector<std::string> names{"a", "b", "c", "d", "e", "f", "g", "h", "i", "j", "k"};
+    const std::array<std::uint8_t, 11> flags{0, 1, 0, 1, 1, 0, 0, 1, 0, 1, 255};
+
+    for(auto kernel : kernels)
+    {
+        if(not hash::isHashKernelSupported(kernel))
+        {
+            continue;
+        }
+        std::vector<std::uint64_t> out(ids.size());
+        hash::hash_many(std::tie(ids, names, flags), out, kernel);
+        for(std::size_t i = 0; i < ids.size(); ++i)
+        {
+            EXPECT_EQ(out[i], hash::hash_tuple(std::tie(ids[i], names[i], flags[i])));
+        }
+    }
+}
+
+TEST(HashManyTests, shouldRejectMismatchedSizes)
+{
+    const std::vector<int> keys{1, 2, 3};
+    const std::vector<int> shorter{1, 2};
+    std::vector<std::uint64_t> out(2);
+    EXPECT_THROW(hash::hash_many(keys, out), std::invalid_argument);
+    EXPECT_THROW(hash::hash_many(std::tie(keys, shorter), out), std::invalid_argument);
+}
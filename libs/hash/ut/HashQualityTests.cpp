@@ -0,0 +1,162 @@
+#include <gtest/gtest.h>
+#include "hash/Hash.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <random>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+using namespace ::testing;
+
+// Checks in the spirit of SMHasher, sized to run in well under a second.
+namespace
+{
+constexpr std::size_t avalancheSamples{5000};
+
+// Flipping any single input bit has to flip every output bit with a probability close to 1/2.
+// Long keys only flip every BitStride-th bit to keep the run time down.
+template<std::size_t InputBits, std::size_t BitStride = 1, typename Hash>
+double worstAvalancheBias(Hash hashKey)
+{
+    std::mt19937_64 random{42};
+    std::vector<std::array<std::size_t, 64>> flips((InputBits + BitStride - 1) / BitStride);
+    for(std::size_t sample = 0; sample < avalancheSamples; ++sample)
+    {
+        std::array<std::uint64_t, (InputBits + 63) / 64> key{};
+        for(auto& word : key)
+        {
+            word = random();
+        }
+        const auto base = hashKey(key);
+        for(std::size_t bit = 0; bit < InputBits; bit += BitStride)
+        {
+            auto flipped = key;
+            flipped[bit / 64] ^= std::uint64_t{1} << (bit % 64);
+            const auto difference = base ^ hashKey(flipped);
+            for(std::size_t out = 0; out < 64; ++out)
+            {
+                flips[bit / BitStride][out] += (difference >> out) & 1;
+            }
+        }
+    }
+
+    double worst{};
+    for(const auto& row : flips)
+    {
+        for(auto count : row)
+        {
+            worst = std::max(worst, std::abs(static_cast<double>(count) / avalancheSamples - 0.5));
+        }
+    }
+    return worst;
+}
+
+template<typename Keys>
+std::size_t countCollisions(const Keys& keys)
+{
+    std::unordered_set<std::uint64_t> hashes;
+    for(const auto& key : keys)
+    {
+        hashes.insert(hash::hashValue(key));
+    }
+    return keys.size() - hashes.size();
+}
+}
+
+TEST(HashQualityTests, shouldAvalancheSingleWords)
+{
+    EXPECT_LT(worstAvalancheBias<64>([](const auto& key) { return hash::hashValue(key[0]); }), 0.04);
+}
+
+TEST(HashQualityTests, shouldAvalancheCombinedValues)
+{
+    EXPECT_LT(worstAvalancheBias<64>([](const auto& key) {
+        return std::uint64_t{hash::hash(static_cast<std::uint32_t>(key[0]), static_cast<std::uint32_t>(key[0] >> 32))};
+    }), 0.04);
+}
+
+TEST(HashQualityTests, shouldAvalancheBytes)
+{
+    EXPECT_LT(worstAvalancheBias<128>([](const auto& key) { return hash::hashBytes(key.data(), 16); }), 0.04);
+    EXPECT_LT((worstAvalancheBias<64 * 8, 7>([](const auto& key) { return hash::hashBytes(key.data(), 64); })), 0.04);
+}
+
+TEST(HashQualityTests, shouldNotCollideOnSequentialKeys)
+{
+    std::vector<std::uint64_t> keys(1 << 18);
+    for(std::size_t i = 0; i < keys.size(); ++i)
+    {
+        keys[i] = i;
+    }
+    EXPECT_EQ(countCollisions(keys), 0u);
+
+    // Low bits pick the bucket in power of two tables, they have to be spread evenly as well.
+    std::vector<std::size_t> buckets(1 << 10);
+    for(auto key : keys)
+    {
+        ++buckets[hash::hashValue(key) & (buckets.size() - 1)];
+    }
+    const auto expected = keys.size() / buckets.size();
+    const auto [least, most] = std::minmax_element(buckets.begin(), buckets.end());
+    EXPECT_GT(*least, expected * 3 / 4);
+    EXPECT_LT(*most, expected * 5 / 4);
+}
+
+TEST(HashQualityTests, shouldNotCollideOnSparseKeys)
+{
+    std::vector<std::string> keys{std::string(32, '\0')};
+    for(std::size_t first = 0; first < 256; ++first)
+    {
+        keys.push_back(keys.front());
+        keys.back()[first / 8] ^= static_cast<char>(1 << (first % 8));
+        for(std::size_t second = first + 1; second < 256; ++second)
+        {
+            std::string key(32, '\0');
+            key[first / 8] ^= static_cast<char>(1 << (first % 8));
+            key[second / 8] ^= static_cast<char>(1 << (second % 8));
+            keys.push_back(key);
+        }
+    }
+    EXPECT_EQ(countCollisions(keys), 0u);
+}
+
+TEST(HashQualityTests, shouldNotCollideOnShortTexts)
+{
+    std::vector<std::string> keys;
+    for(char a = ' '; a <= '~'; ++a)
+    {
+        keys.emplace_back(1, a);
+        for(char b = ' '; b <= '~'; ++b)
+        {
+            keys.push_back({a, b});
+            for(char c = '0'; c <= '9'; ++c)
+            {
+                keys.push_back({a, b, c});
+            }
+        }
+    }
+    keys.emplace_back();
+    EXPECT_EQ(countCollisions(keys), 0u);
+}
+
+// A raw input equal to a constant of the fold must not zero the mum and forget the seed.
+TEST(HashQualityTests, shouldKeepSeedWhenInputMatchesSecret)
+{
+    for(auto key : hash::detail::secret)
+    {
+        std::unordered_set<std::uint64_t> hashes{hash::hash(std::string{"alice"}, key), hash::hash(std::string{"bob"}, key),
+                                                  hash::hash(1, 2, 3, key), hash::hash(key), hash::hash(key, key)};
+        EXPECT_EQ(hashes.size(), 5u);
+
+        std::unordered_set<std::size_t> seeds;
+        for(std::size_t seed : {0ull, 1ull, 2ull, 0xdeadbeefull, ~0ull})
+        {
+            hash::hash_combine(seed, key);
+            seeds.insert(seed);
+        }
+        EXPECT_EQ(seeds.size(), 5u);
+    }
+}
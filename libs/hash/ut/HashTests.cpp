@@ -0,0 +1,162 @@
+#include <gtest/gtest.h>
+#include "hash/Hash.hpp"
+
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <list>
+#include <map>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+using namespace ::testing;
+using namespace std::string_literals;
+
+namespace
+{
+struct Person
+{
+    Person(std::string _name, std::string _surname, unsigned _age)
+        : name(_name), surname(_surname), age(_age)
+    {}
+
+    auto tie() const
+    {
+        return std::tie(name, surname, age);
+    }
+
+private:
+    std::string name;
+    std::string surname;
+    unsigned age;
+};
+
+struct Point
+{
+    int x;
+    int y;
+};
+
+struct Employee
+{
+    std::string full_name;
+    unsigned age;
+    unsigned salary;
+    double bonus;
+};
+
+struct Padded
+{
+    char code;
+    int id;
+};
+
+// Equal whatever the revision, its std::hash only looks at the id.
+struct Versioned
+{
+    std::uint32_t id;
+    std::uint32_t revision;
+};
+}
+
+namespace std
+{
+template<>
+struct hash<Versioned>
+{
+    std::size_t operator()(const Versioned& value) const { return value.id; }
+};
+}
+
+TEST(HashTests, shouldHashArgumentsInOrder)
+{
+    EXPECT_EQ(hash::hash("THX"s, 1011, 105.4), hash::hash("THX"s, 1011, 105.4));
+    EXPECT_NE(hash::hash("THX"s, 1011), hash::hash(1011, "THX"s));
+    EXPECT_NE(hash::hash(0), hash::hash(0, 0));
+    EXPECT_NE(hash::hash("THZ"s, "TXC"s), hash::hash("THZTXC"s));
+}
+
+TEST(HashTests, shouldHashTupleLikes)
+{
+    Person p{"Mariusz", "Kowalski", 25};
+    EXPECT_EQ(hash::hash_tuple(p.tie()), hash::hash("Mariusz"s, "Kowalski"s, 25u));
+    EXPECT_EQ(hash::hash_tuple(std::make_tuple(10.4, 5, "THX"s)), hash::hash(10.4, 5, "THX"s));
+    EXPECT_EQ(hash::hash_tuple(std::make_pair(1, 'a')), hash::hash(1, 'a'));
+    EXPECT_EQ(hash::hash_tuple(std::array<int, 3>{1, 2, 3}), hash::hash(1, 2, 3));
+}
+
+TEST(HashTests, shouldHashEqualValuesEqually)
+{
+    EXPECT_EQ(hash::hashValue("Test"s), hash::hashValue(std::string_view{"Test"}));
+    EXPECT_EQ(hash::hashValue("Test"s), hash::hashValue("Test"));
+    EXPECT_EQ(hash::hashValue(0.0), hash::hashValue(-0.0));
+    EXPECT_EQ(hash::hashValue(0.0f), hash::hashValue(-0.0f));
+    EXPECT_EQ(hash::hashValue(std::list<int>{1, 2}), hash::hashValue(std::list<int>{1, 2}));
+    EXPECT_NE(hash::hashValue(std::list<int>{1, 2}), hash::hashValue(std::list<int>{2, 1}));
+}
+
+TEST(HashTests, shouldHashContiguousTriviallyCopyableDataAsOneBlock)
+{
+    const std::vector<Point> points{{1, 2}, {3, 4}};
+    EXPECT_EQ(hash::hashValue(points), hash::hashBytes(points.data(), points.size() * sizeof(Point)));
+    EXPECT_EQ(hash::hashValue(Point{1, 2}), hash::hashBytes(&points[0], sizeof(Point)));
+
+    const std::vector<int> vec_int{1, 2, 3};
+    EXPECT_EQ(hash::hashValue(vec_int), hash::hashValue(std::array<int, 3>{1, 2, 3}));
+    EXPECT_NE(hash::hashValue(vec_int), hash::hashValue(std::vector<int>{1, 2}));
+}
+
+TEST(HashTests, shouldHashAggregatesThroughTheirFields)
+{
+    const Employee employee{"Jan Kowalski", 40, 20000, 0.5};
+    EXPECT_EQ(hash::hashValue(employee), hash::hashValue(Employee{"Jan Kowalski", 40, 20000, 0.5}));
+    EXPECT_NE(hash::hashValue(employee), hash::hashValue(Employee{"Jan Kowalski", 40, 20001, 0.5}));
+    EXPECT_NE(hash::hashValue(employee), hash::hashValue(Employee{"Jan Kowalski", 20000, 40, 0.5}));
+    EXPECT_EQ(hash::hashValue(Employee{"Jan Kowalski", 40, 20000, 0.0}), hash::hashValue(Employee{"Jan Kowalski", 40, 20000, -0.0}));
+
+    const unsigned block[]{40, 20000};
+    std::uint64_t word;
+    std::memcpy(&word, block, sizeof(word));
+    EXPECT_EQ(hash::hashValue(employee), hash::hash(employee.full_name, word, employee.bonus));
+}
+
+TEST(HashTests, shouldHashPaddedAggregatesFieldByField)
+{
+    const Padded padded{'a', 1};
+    EXPECT_EQ(hash::hashValue(padded), hash::hash('a', 1));
+    EXPECT_EQ(hash::hashValue(padded), hash::hash_tuple(traits::tieFields(padded)));
+}
+
+TEST(HashTests, shouldHashBytesOfEveryLength)
+{
+    std::string text(200, 'x');
+    std::unordered_set<std::uint64_t> hashes;
+    for(std::size_t size = 0; size <= text.size(); ++size)
+    {
+        hashes.insert(hash::hashBytes(text.data(), size));
+    }
+    EXPECT_EQ(hashes.size(), text.size() + 1);
+    EXPECT_NE(hash::hashBytes(text.data(), text.size()), hash::hashBytes(text.data(), text.size(), 1));
+}
+
+TEST(HashTests, shouldWorkAsUnorderedContainerHasher)
+{
+    std::unordered_set<std::pair<std::string, int>, hash::Hasher> set{{"Test", 1}, {"Suite", 2}, {"Test", 1}};
+    EXPECT_EQ(set.size(), 2u);
+    EXPECT_EQ(set.count({"Suite", 2}), 1u);
+}
+
+TEST(HashTests, shouldPreferStdHashOverBytesOfClasses)
+{
+    static_assert(std::has_unique_object_representations_v<Versioned>);
+    EXPECT_EQ(hash::hashValue(Versioned{1, 0}), hash::hashValue(Versioned{1, 7}));
+    EXPECT_EQ(hash::hashValue(Versioned{1, 0}), hash::hashWord(1));
+    EXPECT_EQ(hash::hash(Versioned{2, 0}, 3), hash::hash(Versioned{2, 9}, 3));
+
+    const std::vector<Versioned> values{{1, 0}, {2, 0}};
+    EXPECT_EQ(hash::hashValue(values), hash::hashValue(std::vector<Versioned>{{1, 5}, {2, 6}}));
+}
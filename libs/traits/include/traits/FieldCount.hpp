@@ -0,0 +1,62 @@
+#pragma once
+
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+#include "traits/IsIterable.hpp"
+#include "traits/IsTupleLike.hpp"
+
+namespace traits
+{
+namespace detail
+{
+constexpr std::size_t maxFieldCount{16};
+
+// Stands in for any field in a brace-init probe.
+struct AnyField
+{
+    template<typename T>
+    operator T() const;
+};
+
+template<typename, typename, typename = void>
+constexpr bool is_brace_constructible_from{};
+
+template<typename T, std::size_t... Is>
+constexpr bool is_brace_constructible_from<
+    T,
+    std::index_sequence<Is...>,
+    std::void_t<decltype(T{(void(Is), AnyField{})...})>
+> = true;
+
+template<typename T, std::size_t N>
+constexpr std::size_t countFields()
+{
+    if constexpr(N == 0 or is_brace_constructible_from<T, std::make_index_sequence<N>>)
+    {
+        return N;
+    }
+    else
+    {
+        return countFields<T, N - 1>();
+    }
+}
+}
+
+// Number of fields of an aggregate: the most initializers T{...} accepts. A field never
+// takes more than one initializer, so C array fields (brace elision) and base classes
+// are not counted correctly, the same aggregates structured bindings reject.
+template<typename T>
+constexpr std::size_t field_count = detail::countFields<T, detail::maxFieldCount + 1>();
+
+// Aggregates whose fields tieFields() can reach; arrays, tuple-likes and ranges have
+// their own handling everywhere and are left out.
+template<typename, typename = void>
+constexpr bool is_reflectable{};
+
+template<typename T>
+constexpr bool is_reflectable<
+    T,
+    std::enable_if_t<std::is_aggregate_v<T> and std::is_class_v<T> and not is_tuple_like<T> and not is_iterable<T>>
+> = field_count<T> != 0 and field_count<T> <= detail::maxFieldCount;
+}
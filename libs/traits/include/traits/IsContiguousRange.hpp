@@ -0,0 +1,18 @@
+#pragma once
+
+#include <iterator>
+#include <type_traits>
+#include <utility>
+#include "traits/IsSizedRange.hpp"
+
+namespace traits
+{
+template<typename, typename = void>
+constexpr bool is_contiguous_range{};
+
+template<typename T>
+constexpr bool is_contiguous_range<
+    T,
+    std::void_t<decltype(std::data(std::declval<T&>()))>
+> = is_sized_range<T> and std::is_pointer_v<decltype(std::data(std::declval<T&>()))>;
+}
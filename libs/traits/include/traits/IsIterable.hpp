@@ -1,5 +1,9 @@
 #pragma once
 
+#include <iterator>
+#include <type_traits>
+#include <utility>
+
 namespace traits
 {
 template<typename, typename = void>
@@ -8,6 +12,6 @@ constexpr bool is_iterable{};
 template<typename T>
 constexpr bool is_iterable<
     T,
-    std::void_t<decltype(std::begin(std::declval<T>())), decltype(std::end(std::declval<T>()))>
+    std::void_t<decltype(std::begin(std::declval<T&>())), decltype(std::end(std::declval<T&>()))>
 > = true;
-}
\ No newline at end of file
+}
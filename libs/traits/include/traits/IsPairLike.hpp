@@ -0,0 +1,17 @@
+#pragma once
+
+#include <tuple>
+#include <type_traits>
+#include "traits/IsTupleLike.hpp"
+
+namespace traits
+{
+template<typename T, typename = void>
+constexpr bool is_pair_like{};
+
+template<typename T>
+constexpr bool is_pair_like<
+    T,
+    std::enable_if_t<is_tuple_like<T>>
+> = std::tuple_size<T>::value == 2;
+}
@@ -0,0 +1,21 @@
+#pragma once
+
+#include <iterator>
+#include <type_traits>
+#include <utility>
+#include "traits/IsIterable.hpp"
+
+namespace traits
+{
+template<typename, typename = void>
+constexpr bool is_random_access_range{};
+
+template<typename T>
+constexpr bool is_random_access_range<
+    T,
+    std::enable_if_t<is_iterable<T>>
+> = std::is_base_of_v<
+    std::random_access_iterator_tag,
+    typename std::iterator_traits<decltype(std::begin(std::declval<T&>()))>::iterator_category
+>;
+}
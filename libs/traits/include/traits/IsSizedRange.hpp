@@ -0,0 +1,18 @@
+#pragma once
+
+#include <iterator>
+#include <type_traits>
+#include <utility>
+#include "traits/IsIterable.hpp"
+
+namespace traits
+{
+template<typename, typename = void>
+constexpr bool is_sized_range{};
+
+template<typename T>
+constexpr bool is_sized_range<
+    T,
+    std::void_t<decltype(std::size(std::declval<T&>()))>
+> = is_iterable<T>;
+}
@@ -0,0 +1,11 @@
+#pragma once
+
+#include <string_view>
+#include <type_traits>
+
+namespace traits
+{
+// std::string, std::string_view and C strings, character arrays stay plain ranges.
+template<typename T>
+constexpr bool is_string_like = std::is_convertible_v<const T&, std::string_view> and not std::is_array_v<T>;
+}
@@ -0,0 +1,20 @@
+#pragma once
+
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+namespace traits
+{
+// Moving such an object and destroying the source is equivalent to copying its bytes,
+// so containers may grow with memcpy. Specialize it for types that opt in.
+template<typename T>
+constexpr bool is_trivially_relocatable = std::is_trivially_copyable_v<T>;
+
+template<typename First, typename Second>
+constexpr bool is_trivially_relocatable<std::pair<First, Second>> =
+    is_trivially_relocatable<First> and is_trivially_relocatable<Second>;
+
+template<typename... Ts>
+constexpr bool is_trivially_relocatable<std::tuple<Ts...>> = (is_trivially_relocatable<Ts> and ...);
+}
@@ -0,0 +1,17 @@
+#pragma once
+
+#include <cstddef>
+#include <tuple>
+#include <type_traits>
+
+namespace traits
+{
+template<typename, typename = void>
+constexpr bool is_tuple_like{};
+
+template<typename T>
+constexpr bool is_tuple_like<
+    T,
+    std::void_t<decltype(std::tuple_size<T>::value)>
+> = true;
+}
@@ -0,0 +1,234 @@
+#pragma once
+
+#include <cstddef>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include "traits/FieldCount.hpp"
+
+namespace traits
+{
+template<typename... Ts>
+struct TypeList
+{};
+
+// Tuple of references to the fields of a reflectable aggregate, what a hand-written
+// tie() member returns but reached through structured bindings.
+template<typename T>
+inline auto tieFields(T& value)
+{
+    constexpr auto count = field_count<std::remove_cv_t<T>>;
+    static_assert(is_reflectable<std::remove_cv_t<T>>, "tieFields needs an aggregate with 1 to 16 fields");
+    if constexpr(count == 1)
+    {
+        auto& [f0] = value;
+        return std::tie(f0);
+    }
+    else if constexpr(count == 2)
+    {
+        auto& [f0, f1] = value;
+        return std::tie(f0, f1);
+    }
+    else if constexpr(count == 3)
+    {
+        auto& [f0, f1, f2] = value;
+        return std::tie(f0, f1, f2);
+    }
+    else if constexpr(count == 4)
+    {
+        auto& [f0, f1, f2, f3] = value;
+        return std::tie(f0, f1, f2, f3);
+    }
+    else if constexpr(count == 5)
+    {
+        auto& [f0, f1, f2, f3, f4] = value;
+        return std::tie(f0, f1, f2, f3, f4);
+    }
+    else if constexpr(count == 6)
+    {
+        auto& [f0, f1, f2, f3, f4, f5] = value;
+        return std::tie(f0, f1, f2, f3, f4, f5);
+    }
+    else if constexpr(count == 7)
+    {
+        auto& [f0, f1, f2, f3, f4, f5, f6] = value;
+        return std::tie(f0, f1, f2, f3, f4, f5, f6);
+    }
+    else if constexpr(count == 8)
+    {
+        auto& [f0, f1, f2, f3, f4, f5, f6, f7] = value;
+        return std::tie(f0, f1, f2, f3, f4, f5, f6, f7);
+    }
+    else if constexpr(count == 9)
+    {
+        auto& [f0, f1, f2, f3, f4, f5, f6, f7, f8] = value;
+        return std::tie(f0, f1, f2, f3, f4, f5, f6, f7, f8);
+    }
+    else if constexpr(count == 10)
+    {
+        auto& [f0, f1, f2, f3, f4, f5, f6, f7, f8, f9] = value;
+        return std::tie(f0, f1, f2, f3, f4, f5, f6, f7, f8, f9);
+    }
+    else if constexpr(count == 11)
+    {
+        auto& [f0, f1, f2, f3, f4, f5, f6, f7, f8, f9, f10] = value;
+        return std::tie(f0, f1, f2, f3, f4, f5, f6, f7, f8, f9, f10);
+    }
+    else if constexpr(count == 12)
+    {
+        auto& [f0, f1, f2, f3, f4, f5, f6, f7, f8, f9, f10, f11] = value;
+        return std::tie(f0, f1, f2, f3, f4, f5, f6, f7, f8, f9, f10, f11);
+    }
+    else if constexpr(count == 13)
+    {
+        auto& [f0, f1, f2, f3, f4, f5, f6, f7, f8, f9, f10, f11, f12] = value;
+        return std::tie(f0, f1, f2, f3, f4, f5, f6, f7, f8, f9, f10, f11, f12);
+    }
+    else if constexpr(count == 14)
+    {
+        auto& [f0, f1, f2, f3, f4, f5, f6, f7, f8, f9, f10, f11, f12, f13] = value;
+        return std::tie(f0, f1, f2, f3, f4, f5, f6, f7, f8, f9, f10, f11, f12, f13);
+    }
+    else if constexpr(count == 15)
+    {
+        auto& [f0, f1, f2, f3, f4, f5, f6, f7, f8, f9, f10, f11, f12, f13, f14] = value;
+        return std::tie(f0, f1, f2, f3, f4, f5, f6, f7, f8, f9, f10, f11, f12, f13, f14);
+    }
+    else if constexpr(count == 16)
+    {
+        auto& [f0, f1, f2, f3, f4, f5, f6, f7, f8, f9, f10, f11, f12, f13, f14, f15] = value;
+        return std::tie(f0, f1, f2, f3, f4, f5, f6, f7, f8, f9, f10, f11, f12, f13, f14, f15);
+    }
+}
+
+// Types with a hand-written tie() member, e.g. classes with private fields.
+template<typename, typename = void>
+constexpr bool has_tie_member{};
+
+template<typename T>
+constexpr bool has_tie_member<T, std::void_t<decltype(std::declval<const T&>().tie())>> = true;
+
+// TypeList of the fields as declared, reference fields stay references.
+template<typename T>
+inline auto declaredFields(const T& value)
+{
+    constexpr auto count = field_count<T>;
+    static_assert(is_reflectable<T>, "declaredFields needs an aggregate with 1 to 16 fields");
+    if constexpr(count == 1)
+    {
+        auto& [f0] = value;
+        return TypeList<decltype(f0)>{};
+    }
+    else if constexpr(count == 2)
+    {
+        auto& [f0, f1] = value;
+        return TypeList<decltype(f0), decltype(f1)>{};
+    }
+    else if constexpr(count == 3)
+    {
+        auto& [f0, f1, f2] = value;
+        return TypeList<decltype(f0), decltype(f1), decltype(f2)>{};
+    }
+    else if constexpr(count == 4)
+    {
+        auto& [f0, f1, f2, f3] = value;
+        return TypeList<decltype(f0), decltype(f1), decltype(f2), decltype(f3)>{};
+    }
+    else if constexpr(count == 5)
+    {
+        auto& [f0, f1, f2, f3, f4] = value;
+        return TypeList<decltype(f0), decltype(f1), decltype(f2), decltype(f3), decltype(f4)>{};
+    }
+    else if constexpr(count == 6)
+    {
+        auto& [f0, f1, f2, f3, f4, f5] = value;
+        return TypeList<decltype(f0), decltype(f1), decltype(f2), decltype(f3), decltype(f4), decltype(f5)>{};
+    }
+    else if constexpr(count == 7)
+    {
+        auto& [f0, f1, f2, f3, f4, f5, f6] = value;
+        return TypeList<decltype(f0), decltype(f1), decltype(f2), decltype(f3), decltype(f4), decltype(f5), decltype(f6)>{};
+    }
+    else if constexpr(count == 8)
+    {
+        auto& [f0, f1, f2, f3, f4, f5, f6, f7] = value;
+        return TypeList<decltype(f0), decltype(f1), decltype(f2), decltype(f3), decltype(f4), decltype(f5), decltype(f6), decltype(f7)>{};
+    }
+    else if constexpr(count == 9)
+    {
+        auto& [f0, f1, f2, f3, f4, f5, f6, f7, f8] = value;
+        return TypeList<decltype(f0), decltype(f1), decltype(f2), decltype(f3), decltype(f4), decltype(f5), decltype(f6), decltype(f7), decltype(f8)>{};
+    }
+    else if constexpr(count == 10)
+    {
+        auto& [f0, f1, f2, f3, f4, f5, f6, f7, f8, f9] = value;
+        return TypeList<decltype(f0), decltype(f1), decltype(f2), decltype(f3), decltype(f4), decltype(f5), decltype(f6), decltype(f7), decltype(f8), decltype(f9)>{};
+    }
+    else if constexpr(count == 11)
+    {
+        auto& [f0, f1, f2, f3, f4, f5, f6, f7, f8, f9, f10] = value;
+        return TypeList<decltype(f0), decltype(f1), decltype(f2), decltype(f3), decltype(f4), decltype(f5), decltype(f6), decltype(f7), decltype(f8), decltype(f9), decltype(f10)>{};
+    }
+    else if constexpr(count == 12)
+    {
+        auto& [f0, f1, f2, f3, f4, f5, f6, f7, f8, f9, f10, f11] = value;
+        return TypeList<decltype(f0), decltype(f1), decltype(f2), decltype(f3), decltype(f4), decltype(f5), decltype(f6), decltype(f7), decltype(f8), decltype(f9), decltype(f10), decltype(f11)>{};
+    }
+    else if constexpr(count == 13)
+    {
+        auto& [f0, f1, f2, f3, f4, f5, f6, f7, f8, f9, f10, f11, f12] = value;
+        return TypeList<decltype(f0), decltype(f1), decltype(f2), decltype(f3), decltype(f4), decltype(f5), decltype(f6), decltype(f7), decltype(f8), decltype(f9), decltype(f10), decltype(f11), decltype(f12)>{};
+    }
+    else if constexpr(count == 14)
+    {
+        auto& [f0, f1, f2, f3, f4, f5, f6, f7, f8, f9, f10, f11, f12, f13] = value;
+        return TypeList<decltype(f0), decltype(f1), decltype(f2), decltype(f3), decltype(f4), decltype(f5), decltype(f6), decltype(f7), decltype(f8), decltype(f9), decltype(f10), decltype(f11), decltype(f12), decltype(f13)>{};
+    }
+    else if constexpr(count == 15)
+    {
+        auto& [f0, f1, f2, f3, f4, f5, f6, f7, f8, f9, f10, f11, f12, f13, f14] = value;
+        return TypeList<decltype(f0), decltype(f1), decltype(f2), decltype(f3), decltype(f4), decltype(f5), decltype(f6), decltype(f7), decltype(f8), decltype(f9), decltype(f10), decltype(f11), decltype(f12), decltype(f13), decltype(f14)>{};
+    }
+    else if constexpr(count == 16)
+    {
+        auto& [f0, f1, f2, f3, f4, f5, f6, f7, f8, f9, f10, f11, f12, f13, f14, f15] = value;
+        return TypeList<decltype(f0), decltype(f1), decltype(f2), decltype(f3), decltype(f4), decltype(f5), decltype(f6), decltype(f7), decltype(f8), decltype(f9), decltype(f10), decltype(f11), decltype(f12), decltype(f13), decltype(f14), decltype(f15)>{};
+    }
+}
+
+template<typename T>
+using declared_fields_t = decltype(declaredFields(std::declval<const T&>()));
+
+template<typename T>
+inline bool fieldsEqual(const T& lhs, const T& rhs)
+{
+    return tieFields(lhs) == tieFields(rhs);
+}
+
+// Drop-in equality for unordered containers, e.g. std::unordered_set<Key, hash::Hasher, traits::FieldsEqual>.
+struct FieldsEqual
+{
+    template<typename T>
+    bool operator()(const T& lhs, const T& rhs) const
+    {
+        return fieldsEqual(lhs, rhs);
+    }
+};
+
+// Field-wise comparison for aggregates. Pull them into the aggregate's namespace with
+// using traits::field_operators::operator==; so argument-dependent lookup finds them.
+namespace field_operators
+{
+template<typename T, typename std::enable_if_t<is_reflectable<T>, int> = 0>
+inline bool operator==(const T& lhs, const T& rhs)
+{
+    return fieldsEqual(lhs, rhs);
+}
+
+template<typename T, typename std::enable_if_t<is_reflectable<T>, int> = 0>
+inline bool operator!=(const T& lhs, const T& rhs)
+{
+    return not fieldsEqual(lhs, rhs);
+}
+}
+}
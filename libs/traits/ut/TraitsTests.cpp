@@ -0,0 +1,164 @@
+#include <gtest/gtest.h>
+#include "traits/FieldCount.hpp"
+#include "traits/IsContiguousRange.hpp"
+#include "traits/IsIterable.hpp"
+#include "traits/IsPairLike.hpp"
+#include "traits/IsRandomAccessRange.hpp"
+#include "traits/IsSizedRange.hpp"
+#include "traits/IsStringLike.hpp"
+#include "traits/IsTriviallyRelocatable.hpp"
+#include "traits/IsTupleLike.hpp"
+#include "traits/TieFields.hpp"
+
+#include <array>
+#include <deque>
+#include <forward_list>
+#include <list>
+#include <map>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <vector>
+
+using namespace ::testing;
+
+namespace
+{
+struct Relocatable
+{
+    Relocatable(const Relocatable&) {}
+};
+
+struct Person
+{
+    std::string full_name{};
+    unsigned age{};
+};
+
+struct Stretch
+{
+    std::array<int, 2> start_point2d{};
+    std::array<int, 2> end_point2d{};
+};
+
+struct WithConstructor
+{
+    WithConstructor(int, int) {}
+};
+
+struct Empty
+{};
+
+using traits::field_operators::operator==;
+using traits::field_operators::operator!=;
+}
+
+template<>
+constexpr bool traits::is_trivially_relocatable<Relocatable> = true;
+
+TEST(TraitsTests, shouldDetectIterables)
+{
+    EXPECT_TRUE(traits::is_iterable<std::vector<int>>);
+    EXPECT_TRUE(traits::is_iterable<int[3]>);
+    EXPECT_FALSE(traits::is_iterable<int>);
+}
+
+TEST(TraitsTests, shouldDetectContiguousRanges)
+{
+    EXPECT_TRUE(traits::is_contiguous_range<std::vector<char>>);
+    EXPECT_TRUE((traits::is_contiguous_range<std::array<int, 3>>));
+    EXPECT_TRUE(traits::is_contiguous_range<int[3]>);
+    EXPECT_TRUE(traits::is_contiguous_range<std::string_view>);
+    EXPECT_FALSE(traits::is_contiguous_range<std::vector<bool>>);
+    EXPECT_FALSE(traits::is_contiguous_range<std::deque<int>>);
+    EXPECT_FALSE(traits::is_contiguous_range<std::list<int>>);
+}
+
+TEST(TraitsTests, shouldDetectSizedRanges)
+{
+    EXPECT_TRUE(traits::is_sized_range<std::list<int>>);
+    EXPECT_TRUE((traits::is_sized_range<std::map<int, int>>));
+    EXPECT_TRUE(traits::is_sized_range<int[3]>);
+    EXPECT_FALSE(traits::is_sized_range<std::forward_list<int>>);
+    EXPECT_FALSE(traits::is_sized_range<int>);
+}
+
+TEST(TraitsTests, shouldDetectRandomAccessRanges)
+{
+    EXPECT_TRUE(traits::is_random_access_range<std::deque<int>>);
+    EXPECT_TRUE(traits::is_random_access_range<std::vector<bool>>);
+    EXPECT_TRUE(traits::is_random_access_range<int[3]>);
+    EXPECT_FALSE(traits::is_random_access_range<std::list<int>>);
+    EXPECT_FALSE((traits::is_random_access_range<std::map<int, int>>));
+    EXPECT_FALSE(traits::is_random_access_range<int>);
+}
+
+TEST(TraitsTests, shouldDetectTupleAndPairLikes)
+{
+    EXPECT_TRUE((traits::is_tuple_like<std::tuple<int, char, double>>));
+    EXPECT_TRUE((traits::is_tuple_like<std::array<int, 4>>));
+    EXPECT_TRUE((traits::is_tuple_like<std::pair<int, int>>));
+    EXPECT_FALSE(traits::is_tuple_like<std::vector<int>>);
+
+    EXPECT_TRUE((traits::is_pair_like<std::pair<const int, std::string>>));
+    EXPECT_TRUE((traits::is_pair_like<std::tuple<int, int>>));
+    EXPECT_FALSE((traits::is_pair_like<std::tuple<int, int, int>>));
+    EXPECT_FALSE(traits::is_pair_like<int>);
+}
+
+TEST(TraitsTests, shouldDetectStringLikes)
+{
+    EXPECT_TRUE(traits::is_string_like<std::string>);
+    EXPECT_TRUE(traits::is_string_like<std::string_view>);
+    EXPECT_TRUE(traits::is_string_like<const char*>);
+    EXPECT_FALSE(traits::is_string_like<char[4]>);
+    EXPECT_FALSE(traits::is_string_like<std::vector<char>>);
+}
+
+TEST(TraitsTests, shouldDetectTriviallyRelocatables)
+{
+    EXPECT_TRUE(traits::is_trivially_relocatable<int>);
+    EXPECT_TRUE((traits::is_trivially_relocatable<std::pair<int, double>>));
+    EXPECT_TRUE((traits::is_trivially_relocatable<std::tuple<int, char>>));
+    EXPECT_TRUE(traits::is_trivially_relocatable<Relocatable>);
+    EXPECT_TRUE((traits::is_trivially_relocatable<std::pair<Relocatable, int>>));
+    EXPECT_FALSE((traits::is_trivially_relocatable<std::pair<std::string, int>>));
+    EXPECT_FALSE(traits::is_trivially_relocatable<std::string>);
+}
+
+TEST(TraitsTests, shouldCountAggregateFields)
+{
+    EXPECT_EQ(traits::field_count<Person>, 2u);
+    EXPECT_EQ(traits::field_count<Stretch>, 2u);
+    EXPECT_EQ((traits::field_count<std::pair<std::string, Person>>), 2u);
+    EXPECT_TRUE(traits::is_reflectable<Person>);
+    EXPECT_TRUE(traits::is_reflectable<Stretch>);
+    EXPECT_FALSE(traits::is_reflectable<WithConstructor>);
+    EXPECT_FALSE(traits::is_reflectable<Empty>);
+    EXPECT_FALSE((traits::is_reflectable<std::array<int, 2>>));
+    EXPECT_FALSE((traits::is_reflectable<std::pair<int, int>>));
+    EXPECT_FALSE(traits::is_reflectable<int>);
+}
+
+TEST(TraitsTests, shouldTieAggregateFields)
+{
+    Person person{"Jan Kowalski", 40};
+    const auto fields = traits::tieFields(person);
+    EXPECT_EQ(&std::get<0>(fields), &person.full_name);
+    EXPECT_EQ(std::get<1>(fields), 40u);
+    EXPECT_TRUE((std::is_same_v<traits::declared_fields_t<Person>, traits::TypeList<const std::string, const unsigned>>));
+
+    std::get<1>(traits::tieFields(person)) = 41;
+    EXPECT_EQ(person.age, 41u);
+}
+
+TEST(TraitsTests, shouldCompareAggregatesFieldByField)
+{
+    const Person person{"Jan Kowalski", 40};
+    EXPECT_TRUE(traits::fieldsEqual(person, Person{"Jan Kowalski", 40}));
+    EXPECT_FALSE(traits::FieldsEqual{}(person, Person{"Jan Kowalski", 41}));
+    EXPECT_EQ(person, (Person{"Jan Kowalski", 40}));
+    EXPECT_NE(person, (Person{"Mariusz Kowalski", 40}));
+    EXPECT_EQ((Stretch{{1, 2}, {3, 3}}), (Stretch{{1, 2}, {3, 3}}));
+}
@@ -0,0 +1,79 @@
+#include <benchmark/benchmark.h>
+#include "utils/AsyncLog.hpp"
+#include "utils/RangePrinter.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <numeric>
+#include <streambuf>
+#include <vector>
+
+namespace
+{
+// Swallows everything, keeps the sink cost out of both measurements.
+class NullBuffer : public std::streambuf
+{
+protected:
+    int_type overflow(int_type c) override { return c; }
+    std::streamsize xsputn(const char*, std::streamsize count) override { return count; }
+};
+
+std::vector<int> makeVector(std::size_t size)
+{
+    std::vector<int> vec(size);
+    std::iota(vec.begin(), vec.end(), -static_cast<int>(size / 2));
+    return vec;
+}
+
+// Times every call separately and reports the median and the 99th percentile.
+template<typename Call>
+void measureLatency(benchmark::State& state, Call call)
+{
+    std::vector<std::int64_t> latencies;
+    latencies.reserve(1 << 20);
+    for(auto _ : state)
+    {
+        const auto start = std::chrono::steady_clock::now();
+        call();
+        const auto stop = std::chrono::steady_clock::now();
+        if(latencies.size() < latencies.capacity())
+        {
+            latencies.push_back(std::chrono::duration_cast<std::chrono::nanoseconds>(stop - start).count());
+        }
+    }
+
+    std::sort(latencies.begin(), latencies.end());
+    auto percentile = [&latencies](std::size_t permille) {
+        return latencies.empty() ? 0.0 : static_cast<double>(latencies[latencies.size() * permille / 1000]);
+    };
+    state.counters["p50_ns"] = percentile(500);
+    state.counters["p99_ns"] = percentile(990);
+}
+}
+
+// What the examples do today: format on the calling thread straight into std::cout.
+static void BM_InlineCoutLatency(benchmark::State& state)
+{
+    const auto vec = makeVector(static_cast<std::size_t>(state.range(0)));
+    NullBuffer null;
+    auto* previous = std::cout.rdbuf(&null);
+    measureLatency(state, [&vec] { std::cout << utils::printRange(vec) << '\n'; });
+    std::cout.rdbuf(previous);
+}
+BENCHMARK(BM_InlineCoutLatency)->Arg(16)->Arg(256);
+
+static void BM_AsyncLogLatency(benchmark::State& state, utils::OverflowPolicy policy)
+{
+    const auto vec = makeVector(static_cast<std::size_t>(state.range(0)));
+    NullBuffer null;
+    std::ostream sink{&null};
+    utils::AsyncLog log{sink, {1 << 16, policy}};
+    measureLatency(state, [&log, &vec] { log.log(vec); });
+    log.flush();
+    state.counters["dropped"] = static_cast<double>(log.dropped());
+}
+BENCHMARK_CAPTURE(BM_AsyncLogLatency, Drop, utils::OverflowPolicy::Drop)->Arg(16)->Arg(256);
+BENCHMARK_CAPTURE(BM_AsyncLogLatency, Block, utils::OverflowPolicy::Block)->Arg(16)->Arg(256);
+BENCHMARK_CAPTURE(BM_AsyncLogLatency, Grow, utils::OverflowPolicy::Grow)->Arg(16)->Arg(256);
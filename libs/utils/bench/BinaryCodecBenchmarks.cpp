@@ -0,0 +1,131 @@
+#include <benchmark/benchmark.h>
+#include "utils/BinaryCodec.hpp"
+#include "utils/RangeFormatter.hpp"
+#include "utils/RangeParser.hpp"
+
+#include <map>
+#include <numeric>
+#include <string>
+#include <vector>
+
+namespace
+{
+std::vector<int> makeVector(std::size_t size)
+{
+    std::vector<int> vec(size);
+    std::iota(vec.begin(), vec.end(), -static_cast<int>(size / 2));
+    return vec;
+}
+
+std::map<int, std::vector<std::string>> makeMapWithVectors(std::size_t size)
+{
+    std::map<int, std::vector<std::string>> map;
+    for(std::size_t i = 0; i < size; ++i)
+    {
+        map.emplace(static_cast<int>(i), std::vector<std::string>{"Test", "Suite", std::to_string(i)});
+    }
+    return map;
+}
+
+// Reports the encoded size next to the speed, the text counterpart is formatRange().
+template<typename Encode>
+void encode(benchmark::State& state, Encode encodeOnce)
+{
+    std::size_t size{};
+    for(auto _ : state)
+    {
+        auto bytes = encodeOnce();
+        size = bytes.size();
+        benchmark::DoNotOptimize(bytes.data());
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * size));
+    state.counters["encoded_bytes"] = static_cast<double>(size);
+}
+
+template<typename Container, typename Decode>
+void decode(benchmark::State& state, const std::string& bytes, Decode decodeOnce)
+{
+    for(auto _ : state)
+    {
+        auto value = decodeOnce(bytes);
+        benchmark::DoNotOptimize(value);
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * bytes.size()));
+}
+}
+
+static void BM_EncodeVectorAsText(benchmark::State& state)
+{
+    const auto vec = makeVector(static_cast<std::size_t>(state.range(0)));
+    encode(state, [&vec] { return utils::formatRange(vec); });
+}
+BENCHMARK(BM_EncodeVectorAsText)->Arg(1 << 16);
+
+static void BM_EncodeVectorAsBinary(benchmark::State& state)
+{
+    const auto vec = makeVector(static_cast<std::size_t>(state.range(0)));
+    encode(state, [&vec] { return utils::encodeBinary(vec); });
+}
+BENCHMARK(BM_EncodeVectorAsBinary)->Arg(1 << 16);
+
+static void BM_EncodeVectorAsVarint(benchmark::State& state)
+{
+    const auto vec = makeVector(static_cast<std::size_t>(state.range(0)));
+    encode(state, [&vec] { return utils::encodeBinary<utils::IntegerEncoding::Varint>(vec); });
+}
+BENCHMARK(BM_EncodeVectorAsVarint)->Arg(1 << 16);
+
+static void BM_EncodeMapAsText(benchmark::State& state)
+{
+    const auto map = makeMapWithVectors(static_cast<std::size_t>(state.range(0)));
+    encode(state, [&map] { return utils::formatRange(map); });
+}
+BENCHMARK(BM_EncodeMapAsText)->Arg(1 << 12);
+
+static void BM_EncodeMapAsBinary(benchmark::State& state)
+{
+    const auto map = makeMapWithVectors(static_cast<std::size_t>(state.range(0)));
+    encode(state, [&map] { return utils::encodeBinary(map); });
+}
+BENCHMARK(BM_EncodeMapAsBinary)->Arg(1 << 12);
+
+static void BM_DecodeVectorFromText(benchmark::State& state)
+{
+    const auto text = utils::formatRange(makeVector(static_cast<std::size_t>(state.range(0))));
+    decode<std::vector<int>>(state, text, [](const std::string& bytes) { return utils::parseRange<std::vector<int>>(bytes); });
+}
+BENCHMARK(BM_DecodeVectorFromText)->Arg(1 << 16);
+
+static void BM_DecodeVectorFromBinary(benchmark::State& state)
+{
+    const auto bytes = utils::encodeBinary(makeVector(static_cast<std::size_t>(state.range(0))));
+    decode<std::vector<int>>(state, bytes, [](const std::string& bytes) { return utils::decodeBinary<std::vector<int>>(bytes); });
+}
+BENCHMARK(BM_DecodeVectorFromBinary)->Arg(1 << 16);
+
+static void BM_DecodeVectorView(benchmark::State& state)
+{
+    const auto bytes = utils::encodeBinary(makeVector(static_cast<std::size_t>(state.range(0))));
+    decode<utils::ArrayView<int>>(state, bytes, [](const std::string& bytes) {
+        return utils::decodeBinary<utils::ArrayView<int>>(bytes);
+    });
+}
+BENCHMARK(BM_DecodeVectorView)->Arg(1 << 16);
+
+static void BM_DecodeMapFromText(benchmark::State& state)
+{
+    const auto text = utils::formatRange(makeMapWithVectors(static_cast<std::size_t>(state.range(0))));
+    decode<std::map<int, std::vector<std::string>>>(state, text, [](const std::string& bytes) {
+        return utils::parseRange<std::map<int, std::vector<std::string>>>(bytes);
+    });
+}
+BENCHMARK(BM_DecodeMapFromText)->Arg(1 << 12);
+
+static void BM_DecodeMapFromBinary(benchmark::State& state)
+{
+    const auto bytes = utils::encodeBinary(makeMapWithVectors(static_cast<std::size_t>(state.range(0))));
+    decode<std::map<int, std::vector<std::string>>>(state, bytes, [](const std::string& bytes) {
+        return utils::decodeBinary<std::map<int, std::vector<std::string>>>(bytes);
+    });
+}
+BENCHMARK(BM_DecodeMapFromBinary)->Arg(1 << 12);
@@ -0,0 +1,44 @@
+#include <benchmark/benchmark.h>
+#include "utils/CompressedPair.hpp"
+#include "utils/Vector.hpp"
+
+#include <utility>
+#include <vector>
+
+namespace
+{
+// Grows a vector from empty, so most of the time goes into reallocations.
+template<typename Vector>
+void grow(benchmark::State& state)
+{
+    const auto size = static_cast<int>(state.range(0));
+    for(auto _ : state)
+    {
+        Vector vec;
+        for(int i = 0; i < size; ++i)
+        {
+            vec.emplace_back(i, 0.5 * i);
+        }
+        benchmark::DoNotOptimize(vec.data());
+    }
+    state.SetItemsProcessed(state.iterations() * size);
+}
+}
+
+static void BM_StdVectorGrowStdPair(benchmark::State& state)
+{
+    grow<std::vector<std::pair<int, double>>>(state);
+}
+BENCHMARK(BM_StdVectorGrowStdPair)->Arg(1 << 10)->Arg(1 << 16);
+
+static void BM_StdVectorGrowCompressedPair(benchmark::State& state)
+{
+    grow<std::vector<utils::compressed_pair<int, double>>>(state);
+}
+BENCHMARK(BM_StdVectorGrowCompressedPair)->Arg(1 << 10)->Arg(1 << 16);
+
+static void BM_VectorGrowCompressedPair(benchmark::State& state)
+{
+    grow<utils::vector<utils::compressed_pair<int, double>>>(state);
+}
+BENCHMARK(BM_VectorGrowCompressedPair)->Arg(1 << 10)->Arg(1 << 16);
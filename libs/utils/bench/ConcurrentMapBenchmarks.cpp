@@ -0,0 +1,157 @@
+#include <benchmark/benchmark.h>
+#include "hash/Hash.hpp"
+#include "utils/ConcurrentMap.hpp"
+
+#include <cstddef>
+#include <mutex>
+#include <random>
+#include <string>
+#include <tuple>
+#include <unordered_map>
+#include <vector>
+
+namespace
+{
+class Person
+{
+public:
+    Person(std::string name, std::string surname, unsigned age)
+        : name_{std::move(name)}, surname_{std::move(surname)}, age_{age}
+    {}
+
+    auto tie() const
+    {
+        return std::tie(name_, surname_, age_);
+    }
+
+private:
+    std::string name_;
+    std::string surname_;
+    unsigned age_;
+};
+
+constexpr std::size_t peopleCount{1 << 16};
+
+const std::vector<Person>& people()
+{
+    static const auto people = [] {
+        std::vector<Person> people;
+        people.reserve(peopleCount);
+        for(std::size_t i = 0; i < peopleCount; ++i)
+        {
+            people.emplace_back("Name " + std::to_string(i % 1000), "Surname " + std::to_string(i / 1000),
+                                static_cast<unsigned>(18 + i % 50));
+        }
+        return people;
+    }();
+    return people;
+}
+
+// What the code did so far: hash_tuple(p.tie()) as the key of an unordered_map behind one mutex.
+class LockedUnorderedMap
+{
+public:
+    void write(const Person& person, int value)
+    {
+        std::lock_guard lock{mutex_};
+        map_[hash::hash_tuple(person.tie())] = value;
+    }
+
+    bool read(const Person& person) const
+    {
+        std::lock_guard lock{mutex_};
+        return map_.find(hash::hash_tuple(person.tie())) != map_.end();
+    }
+
+private:
+    mutable std::mutex mutex_;
+    std::unordered_map<std::size_t, int> map_;
+};
+
+class ShardedMap
+{
+public:
+    void write(const Person& person, int value) { map_.insert_or_assign(person, value); }
+
+    // Heterogeneous: the tuple of references is looked up without building a Person.
+    bool read(const Person& person) const { return map_.contains(person.tie()); }
+
+private:
+    utils::concurrent_map<Person, int> map_;
+};
+
+// Every thread reads or writes random people, writePercent of the operations write.
+template<typename Map>
+void runMixed(benchmark::State& state, Map& map)
+{
+    const auto writePercent = static_cast<unsigned>(state.range(0));
+    if(state.thread_index() == 0)
+    {
+        for(std::size_t i = 0; i < peopleCount; i += 2)
+        {
+            map.write(people()[i], 0);
+        }
+    }
+
+    std::mt19937 generator{static_cast<unsigned>(state.thread_index())};
+    std::uniform_int_distribution<std::size_t> person{0, peopleCount - 1};
+    std::uniform_int_distribution<unsigned> percent{0, 99};
+    for(auto _ : state)
+    {
+        const auto& key = people()[person(generator)];
+        if(percent(generator) < writePercent)
+        {
+            map.write(key, 1);
+        }
+        else
+        {
+            benchmark::DoNotOptimize(map.read(key));
+        }
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+}
+
+static void BM_LockedUnorderedMapMixed(benchmark::State& state)
+{
+    static LockedUnorderedMap map;
+    runMixed(state, map);
+}
+BENCHMARK(BM_LockedUnorderedMapMixed)->Arg(10)->Arg(50)->ThreadRange(1, 16)->UseRealTime();
+
+static void BM_ConcurrentMapMixed(benchmark::State& state)
+{
+    static ShardedMap map;
+    runMixed(state, map);
+}
+BENCHMARK(BM_ConcurrentMapMixed)->Arg(10)->Arg(50)->ThreadRange(1, 16)->UseRealTime();
+
+static void BM_ConcurrentMapInsert(benchmark::State& state)
+{
+    for(auto _ : state)
+    {
+        utils::concurrent_map<Person, int> map;
+        for(std::size_t i = 0; i < peopleCount; ++i)
+        {
+            map.try_emplace(people()[i], static_cast<int>(i));
+        }
+        benchmark::DoNotOptimize(map.size());
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(peopleCount));
+}
+BENCHMARK(BM_ConcurrentMapInsert);
+
+static void BM_UnorderedMapInsert(benchmark::State& state)
+{
+    for(auto _ : state)
+    {
+        std::unordered_map<std::size_t, int> map;
+        for(std::size_t i = 0; i < peopleCount; ++i)
+        {
+            map.emplace(hash::hash_tuple(people()[i].tie()), static_cast<int>(i));
+        }
+        benchmark::DoNotOptimize(map.size());
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(peopleCount));
+}
+BENCHMARK(BM_UnorderedMapInsert);
@@ -0,0 +1,88 @@
+#include <benchmark/benchmark.h>
+#include "utils/FdSink.hpp"
+#include "utils/RangePrinter.hpp"
+
+#include <fstream>
+#include <numeric>
+#include <string>
+#include <vector>
+
+#include <fcntl.h>
+#include <unistd.h>
+
+namespace
+{
+std::vector<std::string> makeStrings(std::size_t size, std::size_t length)
+{
+    return std::vector<std::string>(size, std::string(length, 'x'));
+}
+
+std::vector<int> makeVector(std::size_t size)
+{
+    std::vector<int> vec(size);
+    std::iota(vec.begin(), vec.end(), -static_cast<int>(size / 2));
+    return vec;
+}
+
+template<typename Range>
+void printToOfstream(benchmark::State& state, const Range& range)
+{
+    std::ofstream os{"/dev/null"};
+    for(auto _ : state)
+    {
+        os << utils::printRange(range);
+        os.flush();
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * utils::formattedSize(range)));
+}
+
+template<typename Range>
+void printToFdSink(benchmark::State& state, const Range& range, utils::FdBackend backend)
+{
+    const int fd = ::open("/dev/null", O_WRONLY | O_CLOEXEC);
+    {
+        utils::FdSink sink{fd, backend};
+        for(auto _ : state)
+        {
+            sink << utils::printRange(range);
+            sink.flush();
+        }
+    }
+    ::close(fd);
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * utils::formattedSize(range)));
+}
+}
+
+static void BM_PrintStringsToOfstream(benchmark::State& state)
+{
+    printToOfstream(state, makeStrings(1024, static_cast<std::size_t>(state.range(0))));
+}
+BENCHMARK(BM_PrintStringsToOfstream)->Arg(16)->Arg(256)->Arg(4096);
+
+static void BM_PrintStringsToFdSink(benchmark::State& state)
+{
+    printToFdSink(state, makeStrings(1024, static_cast<std::size_t>(state.range(0))), utils::FdBackend::Writev);
+}
+BENCHMARK(BM_PrintStringsToFdSink)->Arg(16)->Arg(256)->Arg(4096);
+
+static void BM_PrintVectorToOfstream(benchmark::State& state)
+{
+    printToOfstream(state, makeVector(static_cast<std::size_t>(state.range(0))));
+}
+BENCHMARK(BM_PrintVectorToOfstream)->Arg(1 << 16);
+
+static void BM_PrintVectorToFdSink(benchmark::State& state)
+{
+    printToFdSink(state, makeVector(static_cast<std::size_t>(state.range(0))), utils::FdBackend::Writev);
+}
+BENCHMARK(BM_PrintVectorToFdSink)->Arg(1 << 16);
+
+static void BM_PrintStringsToUringFdSink(benchmark::State& state)
+{
+    if(not utils::isFdBackendSupported(utils::FdBackend::Uring))
+    {
+        return state.SkipWithError("built without liburing");
+    }
+    printToFdSink(state, makeStrings(1024, static_cast<std::size_t>(state.range(0))), utils::FdBackend::Uring);
+}
+BENCHMARK(BM_PrintStringsToUringFdSink)->Arg(4096);
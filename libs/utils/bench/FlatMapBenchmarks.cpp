@@ -0,0 +1,190 @@
+#include <benchmark/benchmark.h>
+#include "utils/FlatMap.hpp"
+#include "utils/FlatSet.hpp"
+#include "utils/RangePrinter.hpp"
+
+#include <algorithm>
+#include <map>
+#include <random>
+#include <set>
+#include <sstream>
+#include <vector>
+
+namespace
+{
+std::vector<int> makeKeys(std::size_t size, unsigned seed = 42)
+{
+    std::mt19937 generator{seed};
+    std::uniform_int_distribution<int> key{0, 1 << 30};
+    std::vector<int> keys(size);
+    std::generate(keys.begin(), keys.end(), [&] { return key(generator); });
+    return keys;
+}
+
+template<typename Map>
+Map makeMap(const std::vector<int>& keys)
+{
+    Map map;
+    for(auto key : keys)
+    {
+        map[key] = key / 2;
+    }
+    return map;
+}
+
+// Half of the probes hit, in random order so the searches do not share a cache path.
+std::vector<int> makeProbes(const std::vector<int>& keys)
+{
+    auto probes = makeKeys(keys.size(), 7);
+    std::copy(keys.begin(), keys.begin() + static_cast<std::ptrdiff_t>(keys.size() / 2), probes.begin());
+    std::shuffle(probes.begin(), probes.end(), std::mt19937{3});
+    return probes;
+}
+
+template<typename Find>
+void lookUp(benchmark::State& state, const std::vector<int>& probes, Find find)
+{
+    for(auto _ : state)
+    {
+        long found{};
+        for(auto probe : probes)
+        {
+            found += find(probe);
+        }
+        benchmark::DoNotOptimize(found);
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(probes.size()));
+}
+
+template<typename Printer>
+void printToStream(benchmark::State& state, Printer&& printer)
+{
+    std::ostringstream os;
+    for(auto _ : state)
+    {
+        os.str({});
+        os << printer;
+        benchmark::DoNotOptimize(os.tellp());
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * os.tellp());
+}
+}
+
+static void BM_StdMapFind(benchmark::State& state)
+{
+    const auto keys = makeKeys(static_cast<std::size_t>(state.range(0)));
+    const auto map = makeMap<std::map<int, int>>(keys);
+    lookUp(state, makeProbes(keys), [&map](int key) { return map.find(key) != map.end(); });
+}
+BENCHMARK(BM_StdMapFind)->Arg(1 << 10)->Arg(1 << 16)->Arg(1 << 20);
+
+static void BM_SortedVectorStdLowerBound(benchmark::State& state)
+{
+    auto keys = makeKeys(static_cast<std::size_t>(state.range(0)));
+    const auto probes = makeProbes(keys);
+    std::sort(keys.begin(), keys.end());
+    lookUp(state, probes, [&keys](int key) {
+        const auto it = std::lower_bound(keys.begin(), keys.end(), key);
+        return it != keys.end() and *it == key;
+    });
+}
+BENCHMARK(BM_SortedVectorStdLowerBound)->Arg(1 << 10)->Arg(1 << 16)->Arg(1 << 20);
+
+static void BM_FlatMapFind(benchmark::State& state)
+{
+    const auto keys = makeKeys(static_cast<std::size_t>(state.range(0)));
+    const utils::flat_map map{keys, keys};
+    lookUp(state, makeProbes(keys), [&map](int key) { return map.contains(key); });
+}
+BENCHMARK(BM_FlatMapFind)->Arg(1 << 10)->Arg(1 << 16)->Arg(1 << 20);
+
+static void BM_StdMapBuild(benchmark::State& state)
+{
+    const auto keys = makeKeys(static_cast<std::size_t>(state.range(0)));
+    for(auto _ : state)
+    {
+        benchmark::DoNotOptimize(makeMap<std::map<int, int>>(keys).size());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_StdMapBuild)->Arg(1 << 16);
+
+static void BM_FlatMapBuildOneByOne(benchmark::State& state)
+{
+    const auto keys = makeKeys(static_cast<std::size_t>(state.range(0)));
+    for(auto _ : state)
+    {
+        benchmark::DoNotOptimize(makeMap<utils::flat_map<int, int>>(keys).size());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_FlatMapBuildOneByOne)->Arg(1 << 16);
+
+static void BM_FlatMapBuildBulk(benchmark::State& state)
+{
+    const auto keys = makeKeys(static_cast<std::size_t>(state.range(0)));
+    for(auto _ : state)
+    {
+        benchmark::DoNotOptimize(utils::flat_map{keys, keys}.size());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_FlatMapBuildBulk)->Arg(1 << 16);
+
+// Adds range(0) new keys to a map of 1 << 16 keys.
+static void BM_FlatMapInsertBatch(benchmark::State& state)
+{
+    const auto keys = makeKeys(1 << 16);
+    const utils::flat_map base{keys, keys};
+    std::vector<std::pair<int, int>> batch;
+    for(auto key : makeKeys(static_cast<std::size_t>(state.range(0)), 11))
+    {
+        batch.emplace_back(key, key);
+    }
+    for(auto _ : state)
+    {
+        state.PauseTiming();
+        auto map = base;
+        state.ResumeTiming();
+        map.insert(batch.begin(), batch.end());
+        benchmark::DoNotOptimize(map.size());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_FlatMapInsertBatch)->Arg(1 << 6)->Arg(1 << 10);
+
+static void BM_FlatMapInsertOneByOne(benchmark::State& state)
+{
+    const auto keys = makeKeys(1 << 16);
+    const utils::flat_map base{keys, keys};
+    const auto batch = makeKeys(static_cast<std::size_t>(state.range(0)), 11);
+    for(auto _ : state)
+    {
+        state.PauseTiming();
+        auto map = base;
+        state.ResumeTiming();
+        for(auto key : batch)
+        {
+            map.try_emplace(key, key);
+        }
+        benchmark::DoNotOptimize(map.size());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_FlatMapInsertOneByOne)->Arg(1 << 6)->Arg(1 << 10);
+
+static void BM_PrintStdSet(benchmark::State& state)
+{
+    const auto keys = makeKeys(static_cast<std::size_t>(state.range(0)));
+    const std::set<int> set(keys.begin(), keys.end());
+    printToStream(state, utils::printRange(set));
+}
+BENCHMARK(BM_PrintStdSet)->Arg(1 << 12);
+
+static void BM_PrintFlatSet(benchmark::State& state)
+{
+    const auto keys = makeKeys(static_cast<std::size_t>(state.range(0)));
+    const utils::flat_set<int> set(keys.begin(), keys.end());
+    printToStream(state, utils::printRange(set));
+}
+BENCHMARK(BM_PrintFlatSet)->Arg(1 << 12);
@@ -0,0 +1,53 @@
+#include <benchmark/benchmark.h>
+#include "utils/Generator.hpp"
+#include "utils/RangePrinter.hpp"
+
+#include <optional>
+#include <sstream>
+#include <vector>
+
+namespace
+{
+utils::generator<int> countTo(int last)
+{
+    return utils::generator<int>{[next = 0, last]() mutable {
+        return next < last ? std::optional<int>{next++} : std::nullopt;
+    }};
+}
+
+template<typename Printer>
+void printToStream(benchmark::State& state, Printer makePrinter)
+{
+    std::ostringstream os;
+    for(auto _ : state)
+    {
+        os.str({});
+        os << makePrinter();
+        benchmark::DoNotOptimize(os.tellp());
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * os.tellp());
+}
+}
+
+// What callers had to do so far: materialize the produced values, then print the vector.
+static void BM_CollectThenPrint(benchmark::State& state)
+{
+    const auto count = static_cast<int>(state.range(0));
+    std::vector<int> values;
+    printToStream(state, [&] {
+        values.clear();
+        for(auto value : countTo(count))
+        {
+            values.push_back(value);
+        }
+        return utils::printRange(values);
+    });
+}
+BENCHMARK(BM_CollectThenPrint)->Arg(1 << 10)->Arg(1 << 20);
+
+static void BM_PrintGenerator(benchmark::State& state)
+{
+    const auto count = static_cast<int>(state.range(0));
+    printToStream(state, [&] { return utils::printRange(countTo(count)); });
+}
+BENCHMARK(BM_PrintGenerator)->Arg(1 << 10)->Arg(1 << 20);
@@ -0,0 +1,104 @@
+#include <benchmark/benchmark.h>
+#include "utils/IdSet.hpp"
+
+#include <cstddef>
+#include <random>
+#include <utility>
+#include <vector>
+
+namespace
+{
+// Message ids scattered over a million values, or packed three apart.
+constexpr unsigned sparseId(std::size_t i)
+{
+    return static_cast<unsigned>(i * 2654435761u % 1000003u);
+}
+
+constexpr unsigned denseId(std::size_t i)
+{
+    return static_cast<unsigned>(1000 + 3 * i);
+}
+
+// Half of the queries are members of the pack.
+template<typename MakeId>
+std::vector<unsigned> makeQueries(std::size_t packSize, MakeId makeId)
+{
+    std::mt19937 generator{42};
+    std::uniform_int_distribution<std::size_t> member{0, packSize - 1};
+    std::uniform_int_distribution<unsigned> any{0, 1000003u};
+    std::vector<unsigned> queries(4096);
+    for(std::size_t i = 0; i < queries.size(); ++i)
+    {
+        queries[i] = i % 2 == 0 ? makeId(member(generator)) : any(generator);
+    }
+    return queries;
+}
+
+template<typename Lookup>
+void lookUp(benchmark::State& state, const std::vector<unsigned>& queries)
+{
+    for(auto _ : state)
+    {
+        std::size_t found{};
+        for(auto id : queries)
+        {
+            found += Lookup::index(id);
+        }
+        benchmark::DoNotOptimize(found);
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * queries.size()));
+}
+
+template<utils::IdStrategy Strategy, std::size_t... Is>
+void lookUpSparse(benchmark::State& state, std::index_sequence<Is...>)
+{
+    lookUp<utils::IdLookup<Strategy, sparseId(Is)...>>(state, makeQueries(sizeof...(Is), sparseId));
+}
+
+template<std::size_t... Is>
+void lookUpSparseIdSet(benchmark::State& state, std::index_sequence<Is...>)
+{
+    lookUp<utils::IdSet<sparseId(Is)...>>(state, makeQueries(sizeof...(Is), sparseId));
+}
+
+template<utils::IdStrategy Strategy, std::size_t... Is>
+void lookUpDense(benchmark::State& state, std::index_sequence<Is...>)
+{
+    lookUp<utils::IdLookup<Strategy, denseId(Is)...>>(state, makeQueries(sizeof...(Is), denseId));
+}
+}
+
+template<utils::IdStrategy Strategy, std::size_t N>
+static void BM_SparseIds(benchmark::State& state)
+{
+    lookUpSparse<Strategy>(state, std::make_index_sequence<N>{});
+}
+
+template<std::size_t N>
+static void BM_SparseIdSet(benchmark::State& state)
+{
+    lookUpSparseIdSet(state, std::make_index_sequence<N>{});
+}
+
+template<utils::IdStrategy Strategy, std::size_t N>
+static void BM_DenseIds(benchmark::State& state)
+{
+    lookUpDense<Strategy>(state, std::make_index_sequence<N>{});
+}
+
+#define ID_SET_BENCHMARKS(N)                                                          \
+    BENCHMARK_TEMPLATE(BM_SparseIds, utils::IdStrategy::Linear, N);                   \
+    BENCHMARK_TEMPLATE(BM_SparseIds, utils::IdStrategy::BinarySearch, N);             \
+    BENCHMARK_TEMPLATE(BM_SparseIds, utils::IdStrategy::PerfectHash, N);              \
+    BENCHMARK_TEMPLATE(BM_SparseIdSet, N);                                            \
+    BENCHMARK_TEMPLATE(BM_DenseIds, utils::IdStrategy::Linear, N);                    \
+    BENCHMARK_TEMPLATE(BM_DenseIds, utils::IdStrategy::Bitset, N);
+
+ID_SET_BENCHMARKS(1)
+ID_SET_BENCHMARKS(2)
+ID_SET_BENCHMARKS(4)
+ID_SET_BENCHMARKS(8)
+ID_SET_BENCHMARKS(16)
+ID_SET_BENCHMARKS(64)
+ID_SET_BENCHMARKS(256)
+ID_SET_BENCHMARKS(1024)
@@ -0,0 +1,195 @@
+#include <benchmark/benchmark.h>
+#include "utils/JsonEscape.hpp"
+#include "utils/RangePrinter.hpp"
+
+#include <map>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#ifdef UTILS_BENCH_HAS_JSONCPP
+#include <json/json.h>
+#endif
+
+namespace
+{
+// Mostly clean text, every 16th string holds a quote and a line break to escape.
+std::string makeText(std::size_t index, std::size_t size)
+{
+    std::string text = "event " + std::to_string(index) + ": ";
+    while(text.size() < size)
+    {
+        text += "user logged in from host-" + std::to_string(index % 97) + ", ";
+    }
+    text.resize(size);
+    if(index % 16 == 0)
+    {
+        text[size / 2] = '"';
+        text[size / 3] = '\n';
+    }
+    return text;
+}
+
+std::map<std::string, std::vector<int>> makeMap(std::size_t size)
+{
+    std::map<std::string, std::vector<int>> map;
+    for(std::size_t i = 0; i < size; ++i)
+    {
+        map.emplace(makeText(i, 24), std::vector<int>{static_cast<int>(i), static_cast<int>(i * 7), -1});
+    }
+    return map;
+}
+
+std::vector<std::string> makeLines(std::size_t size)
+{
+    std::vector<std::string> lines;
+    for(std::size_t i = 0; i < size; ++i)
+    {
+        lines.push_back(makeText(i, 256));
+    }
+    return lines;
+}
+
+template<typename Print>
+void printToStream(benchmark::State& state, Print print)
+{
+    std::ostringstream os;
+    for(auto _ : state)
+    {
+        os.str({});
+        print(os);
+        benchmark::DoNotOptimize(os.tellp());
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * os.tellp());
+}
+
+#ifdef UTILS_BENCH_HAS_JSONCPP
+Json::Value toJson(const std::map<std::string, std::vector<int>>& map)
+{
+    Json::Value array{Json::arrayValue};
+    for(const auto& [key, values] : map)
+    {
+        Json::Value pair{Json::arrayValue};
+        pair.append(key);
+        Json::Value numbers{Json::arrayValue};
+        for(auto value : values)
+        {
+            numbers.append(value);
+        }
+        pair.append(std::move(numbers));
+        array.append(std::move(pair));
+    }
+    return array;
+}
+
+Json::Value toJson(const std::vector<std::string>& lines)
+{
+    Json::Value array{Json::arrayValue};
+    for(const auto& line : lines)
+    {
+        array.append(line);
+    }
+    return array;
+}
+
+std::unique_ptr<Json::StreamWriter> compactWriter()
+{
+    Json::StreamWriterBuilder builder;
+    builder["indentation"] = "";
+    return std::unique_ptr<Json::StreamWriter>{builder.newStreamWriter()};
+}
+
+// Both sides have to print the same document, jsoncpp reads printRange's output back.
+template<typename Range>
+bool printsSameJson(benchmark::State& state, const Range& range)
+{
+    std::ostringstream os;
+    os << utils::printRange<utils::JsonStyle>(range);
+    Json::Value parsed;
+    std::istringstream in{os.str()};
+    if(not Json::parseFromStream(Json::CharReaderBuilder{}, in, &parsed, nullptr) or parsed != toJson(range))
+    {
+        state.SkipWithError("printRange<JsonStyle> and jsoncpp disagree");
+        return false;
+    }
+    return true;
+}
+
+template<typename Range>
+void writeWithJsoncpp(benchmark::State& state, const Range& range, bool convert)
+{
+    const auto writer = compactWriter();
+    const auto value = toJson(range);
+    printToStream(state, [&](std::ostream& os) {
+        writer->write(convert ? toJson(range) : value, &os);
+    });
+}
+#endif
+}
+
+static void BM_PrintJsonMap(benchmark::State& state)
+{
+    const auto map = makeMap(static_cast<std::size_t>(state.range(0)));
+    printToStream(state, [&map](std::ostream& os) { os << utils::printRange<utils::JsonStyle>(map); });
+}
+BENCHMARK(BM_PrintJsonMap)->Arg(1 << 12);
+
+static void BM_PrintJsonLines(benchmark::State& state)
+{
+    const auto lines = makeLines(static_cast<std::size_t>(state.range(0)));
+    printToStream(state, [&lines](std::ostream& os) { os << utils::printRange<utils::JsonStyle>(lines); });
+}
+BENCHMARK(BM_PrintJsonLines)->Arg(1 << 12);
+
+#ifdef UTILS_BENCH_HAS_JSONCPP
+// jsoncpp needs a Json::Value, ToValue includes building it from the containers.
+static void BM_JsoncppWriteMap(benchmark::State& state)
+{
+    const auto map = makeMap(static_cast<std::size_t>(state.range(0)));
+    if(printsSameJson(state, map))
+    {
+        writeWithJsoncpp(state, map, false);
+    }
+}
+BENCHMARK(BM_JsoncppWriteMap)->Arg(1 << 12);
+
+static void BM_JsoncppToValueAndWriteMap(benchmark::State& state)
+{
+    writeWithJsoncpp(state, makeMap(static_cast<std::size_t>(state.range(0))), true);
+}
+BENCHMARK(BM_JsoncppToValueAndWriteMap)->Arg(1 << 12);
+
+static void BM_JsoncppWriteLines(benchmark::State& state)
+{
+    const auto lines = makeLines(static_cast<std::size_t>(state.range(0)));
+    if(printsSameJson(state, lines))
+    {
+        writeWithJsoncpp(state, lines, false);
+    }
+}
+BENCHMARK(BM_JsoncppWriteLines)->Arg(1 << 12);
+#endif
+
+// Escaping alone, range(0) picks the EscapeKernel.
+static void BM_EscapeJsonLines(benchmark::State& state)
+{
+    const auto kernel = static_cast<utils::EscapeKernel>(state.range(0));
+    if(not utils::isEscapeKernelSupported(kernel))
+    {
+        state.SkipWithError("kernel not supported by this CPU");
+        return;
+    }
+    const auto lines = makeLines(1 << 12);
+    std::size_t bytes{};
+    for(auto _ : state)
+    {
+        bytes = 0;
+        for(const auto& line : lines)
+        {
+            utils::escapeJson(line, [&bytes](std::string_view piece) { bytes += piece.size(); }, kernel);
+        }
+        benchmark::DoNotOptimize(bytes);
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * bytes));
+}
+BENCHMARK(BM_EscapeJsonLines)->DenseRange(0, 2);
@@ -0,0 +1,97 @@
+#include <benchmark/benchmark.h>
+#include "utils/Matches.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <random>
+#include <utility>
+#include <vector>
+
+namespace
+{
+std::vector<int> makeVector(std::size_t size)
+{
+    std::mt19937 generator{42};
+    std::uniform_int_distribution<int> distribution{0, 1023};
+    std::vector<int> vec(size);
+    std::generate(vec.begin(), vec.end(), [&] { return distribution(generator); });
+    return vec;
+}
+
+// The exercise's version: one std::count pass per value.
+template<typename Container, typename Arg, typename... Args>
+std::size_t countPasses(const Container& c, Arg arg, Args... args)
+{
+    return (std::count(std::begin(c), std::end(c), arg) + ... + std::count(std::begin(c), std::end(c), args));
+}
+
+template<std::size_t... Is>
+void matchSentinels(benchmark::State& state, std::index_sequence<Is...>, utils::MatchKernel kernel)
+{
+    if(not utils::isMatchKernelSupported(kernel))
+    {
+        return state.SkipWithError("kernel is not supported by this CPU");
+    }
+    const auto vec = makeVector(static_cast<std::size_t>(state.range(0)));
+    for(auto _ : state)
+    {
+        benchmark::DoNotOptimize(utils::matches(kernel, vec, static_cast<int>(Is * 7)...));
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * vec.size() * sizeof(int)));
+}
+
+template<std::size_t... Is>
+void countSentinels(benchmark::State& state, std::index_sequence<Is...>)
+{
+    const auto vec = makeVector(static_cast<std::size_t>(state.range(0)));
+    for(auto _ : state)
+    {
+        benchmark::DoNotOptimize(countPasses(vec, static_cast<int>(Is * 7)...));
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * vec.size() * sizeof(int)));
+}
+}
+
+template<std::size_t N>
+static void BM_CountPasses(benchmark::State& state)
+{
+    countSentinels(state, std::make_index_sequence<N>{});
+}
+BENCHMARK_TEMPLATE(BM_CountPasses, 8)->Arg(1 << 20);
+BENCHMARK_TEMPLATE(BM_CountPasses, 16)->Arg(1 << 20);
+
+template<std::size_t N>
+static void BM_MatchesScalar(benchmark::State& state)
+{
+    matchSentinels(state, std::make_index_sequence<N>{}, utils::MatchKernel::Scalar);
+}
+BENCHMARK_TEMPLATE(BM_MatchesScalar, 8)->Arg(1 << 20);
+BENCHMARK_TEMPLATE(BM_MatchesScalar, 16)->Arg(1 << 20);
+
+template<std::size_t N>
+static void BM_MatchesAvx2(benchmark::State& state)
+{
+    matchSentinels(state, std::make_index_sequence<N>{}, utils::MatchKernel::Avx2);
+}
+BENCHMARK_TEMPLATE(BM_MatchesAvx2, 8)->Arg(1 << 20);
+BENCHMARK_TEMPLATE(BM_MatchesAvx2, 16)->Arg(1 << 20);
+
+template<std::size_t N>
+static void BM_MatchesAvx512(benchmark::State& state)
+{
+    matchSentinels(state, std::make_index_sequence<N>{}, utils::MatchKernel::Avx512);
+}
+BENCHMARK_TEMPLATE(BM_MatchesAvx512, 8)->Arg(1 << 20);
+BENCHMARK_TEMPLATE(BM_MatchesAvx512, 16)->Arg(1 << 20);
+
+static void BM_MatchCounts(benchmark::State& state)
+{
+    const auto vec = makeVector(static_cast<std::size_t>(state.range(0)));
+    for(auto _ : state)
+    {
+        benchmark::DoNotOptimize(utils::matchCounts(vec, 0, 7, 14, 21, 28, 35, 42, 49));
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * vec.size() * sizeof(int)));
+}
+BENCHMARK(BM_MatchCounts)->Arg(1 << 20);
@@ -0,0 +1,167 @@
+#include <benchmark/benchmark.h>
+#include "utils/IntegerFormatting.hpp"
+#include "utils/ParallelRangeFormatter.hpp"
+#include "utils/RangeFormatter.hpp"
+
+#include <limits>
+#include <map>
+#include <numeric>
+#include <random>
+#include <sstream>
+#include <vector>
+
+namespace
+{
+std::vector<int> makeVector(std::size_t size)
+{
+    std::vector<int> vec(size);
+    std::iota(vec.begin(), vec.end(), -static_cast<int>(size / 2));
+    return vec;
+}
+
+std::map<int, int> makeMap(std::size_t size)
+{
+    std::map<int, int> map;
+    for(std::size_t i = 0; i < size; ++i)
+    {
+        map.emplace(static_cast<int>(i), static_cast<int>(i * 7));
+    }
+    return map;
+}
+
+template<typename Range>
+void printToStream(benchmark::State& state, const Range& range)
+{
+    std::ostringstream os;
+    for(auto _ : state)
+    {
+        os.str({});
+        os << utils::printRange(range);
+        benchmark::DoNotOptimize(os.tellp());
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * os.tellp());
+}
+
+template<typename Range>
+void formatToBuffer(benchmark::State& state, const Range& range)
+{
+    std::vector<char> buffer(32 * std::size(range) + 2);
+    std::size_t size{};
+    for(auto _ : state)
+    {
+        auto result = utils::formatRangeTo(buffer.data(), buffer.data() + buffer.size(), range);
+        size = static_cast<std::size_t>(result.ptr - buffer.data());
+        benchmark::DoNotOptimize(buffer.data());
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * size));
+}
+}
+
+static void BM_PrintVectorToStream(benchmark::State& state)
+{
+    printToStream(state, makeVector(state.range(0)));
+}
+BENCHMARK(BM_PrintVectorToStream)->Arg(1 << 10)->Arg(1 << 16);
+
+static void BM_FormatVectorToBuffer(benchmark::State& state)
+{
+    formatToBuffer(state, makeVector(state.range(0)));
+}
+BENCHMARK(BM_FormatVectorToBuffer)->Arg(1 << 10)->Arg(1 << 16);
+
+static void BM_PrintMapToStream(benchmark::State& state)
+{
+    printToStream(state, makeMap(state.range(0)));
+}
+BENCHMARK(BM_PrintMapToStream)->Arg(1 << 10)->Arg(1 << 16);
+
+static void BM_FormatMapToBuffer(benchmark::State& state)
+{
+    formatToBuffer(state, makeMap(state.range(0)));
+}
+BENCHMARK(BM_FormatMapToBuffer)->Arg(1 << 10)->Arg(1 << 16);
+
+namespace
+{
+std::map<int, std::vector<std::string>> makeMapWithVector(std::size_t size)
+{
+    std::map<int, std::vector<std::string>> map;
+    for(std::size_t i = 0; i < size; ++i)
+    {
+        map.emplace(static_cast<int>(i), std::vector<std::string>{"Test", "Suite", std::to_string(i)});
+    }
+    return map;
+}
+}
+
+static void BM_PrintMapWithVectorToStringStream(benchmark::State& state)
+{
+    const auto map = makeMapWithVector(state.range(0));
+    for(auto _ : state)
+    {
+        std::ostringstream os;
+        os << utils::printRange(map);
+        benchmark::DoNotOptimize(os.str());
+    }
+}
+BENCHMARK(BM_PrintMapWithVectorToStringStream)->Arg(1 << 10)->Arg(1 << 17);
+
+static void BM_FormatMapWithVectorToString(benchmark::State& state)
+{
+    const auto map = makeMapWithVector(state.range(0));
+    for(auto _ : state)
+    {
+        benchmark::DoNotOptimize(utils::formatRange(map));
+    }
+}
+BENCHMARK(BM_FormatMapWithVectorToString)->Arg(1 << 10)->Arg(1 << 17);
+
+static void BM_FormatDoublesParallel(benchmark::State& state)
+{
+    std::vector<double> vec(1 << 22);
+    for(std::size_t i = 0; i < vec.size(); ++i)
+    {
+        vec[i] = static_cast<double>(i) * 1.000001;
+    }
+
+    for(auto _ : state)
+    {
+        benchmark::DoNotOptimize(utils::formatRangeParallel(vec, state.range(0)));
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * vec.size()));
+}
+BENCHMARK(BM_FormatDoublesParallel)
+    ->DenseRange(1, std::max(1u, std::thread::hardware_concurrency()))
+    ->UseRealTime()
+    ->Unit(benchmark::kMillisecond);
+
+static void BM_FormatIntegersKernel(benchmark::State& state)
+{
+    const auto kernel = static_cast<utils::IntegerKernel>(state.range(0));
+    if(not utils::isIntegerKernelSupported(kernel))
+    {
+        state.SkipWithError("kernel not supported by this CPU");
+        return;
+    }
+
+    std::mt19937_64 engine{2020};
+    std::uniform_int_distribution<long long> distribution{std::numeric_limits<long long>::min(),
+                                                          std::numeric_limits<long long>::max()};
+    std::vector<long long> vec(1 << 16);
+    for(auto& value : vec)
+    {
+        value = distribution(engine) >> state.range(1);
+    }
+
+    std::vector<char> buffer(vec.size() * (utils::maxFormattedIntegerSize<long long> + 2) + utils::formatIntegersPadding);
+    for(auto _ : state)
+    {
+        benchmark::DoNotOptimize(utils::formatIntegers(vec.data(), vec.data() + vec.size(), ", ", buffer.data(), kernel));
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * vec.size()));
+}
+BENCHMARK(BM_FormatIntegersKernel)
+    ->ArgsProduct({{static_cast<int>(utils::IntegerKernel::Scalar),
+                    static_cast<int>(utils::IntegerKernel::Sse2),
+                    static_cast<int>(utils::IntegerKernel::Avx2)},
+                   {0, 32, 48}});
@@ -0,0 +1,44 @@
+#include <benchmark/benchmark.h>
+#include "utils/RangeFormatter.hpp"
+#include "utils/RangeParser.hpp"
+
+#include <map>
+#include <string>
+#include <string_view>
+#include <vector>
+
+static void BM_ParseIntegerVector(benchmark::State& state)
+{
+    std::vector<int> vec(static_cast<std::size_t>(state.range(0)));
+    for(std::size_t i = 0; i < vec.size(); ++i)
+    {
+        vec[i] = static_cast<int>(i * 2654435761u);
+    }
+    const auto text = utils::formatRange(vec);
+
+    for(auto _ : state)
+    {
+        auto parsed = utils::parseRange<std::vector<int>>(text);
+        benchmark::DoNotOptimize(parsed);
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * text.size()));
+}
+BENCHMARK(BM_ParseIntegerVector)->Arg(1 << 20);
+
+static void BM_ParseMapWithStringViews(benchmark::State& state)
+{
+    std::map<int, std::vector<std::string>> map;
+    for(int i = 0; i < state.range(0); ++i)
+    {
+        map.emplace(i, std::vector<std::string>{"Test", "Suite", "with a somewhat longer string payload " + std::to_string(i)});
+    }
+    const auto text = utils::formatRange(map);
+
+    for(auto _ : state)
+    {
+        auto parsed = utils::parseRange<std::vector<std::pair<int, std::vector<std::string_view>>>>(text);
+        benchmark::DoNotOptimize(parsed);
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * text.size()));
+}
+BENCHMARK(BM_ParseMapWithStringViews)->Arg(1 << 16);
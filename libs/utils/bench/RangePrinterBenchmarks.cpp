@@ -0,0 +1,91 @@
+#include <benchmark/benchmark.h>
+#include "utils/RangePrinter.hpp"
+
+#include <map>
+#include <numeric>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace
+{
+std::map<std::string, double> makeMap(std::size_t size)
+{
+    std::map<std::string, double> map;
+    for(std::size_t i = 0; i < size; ++i)
+    {
+        map.emplace("key" + std::to_string(i), static_cast<double>(i) / 4);
+    }
+    return map;
+}
+
+// What ends up in a log line: every key holds a few names.
+std::map<int, std::vector<std::string>> makeNestedMap(std::size_t size)
+{
+    std::map<int, std::vector<std::string>> map;
+    for(std::size_t i = 0; i < size; ++i)
+    {
+        map.emplace_hint(map.end(), static_cast<int>(i), std::vector<std::string>{"name", std::to_string(i)});
+    }
+    return map;
+}
+
+template<typename Printer>
+void printToStream(benchmark::State& state, Printer&& printer)
+{
+    std::ostringstream os;
+    for(auto _ : state)
+    {
+        os.str({});
+        os << printer;
+        benchmark::DoNotOptimize(os.tellp());
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * os.tellp());
+}
+}
+
+static void BM_PrintWithRuntimeDelimiter(benchmark::State& state)
+{
+    const auto map = makeMap(static_cast<std::size_t>(state.range(0)));
+    printToStream(state, utils::printRange(map, ","));
+}
+BENCHMARK(BM_PrintWithRuntimeDelimiter)->Arg(1 << 12);
+
+static void BM_PrintWithCompileTimeStyle(benchmark::State& state)
+{
+    const auto map = makeMap(static_cast<std::size_t>(state.range(0)));
+    printToStream(state, utils::printRange<utils::CompactStyle>(map));
+}
+BENCHMARK(BM_PrintWithCompileTimeStyle)->Arg(1 << 12);
+
+static void BM_PrintWholeNestedMap(benchmark::State& state)
+{
+    const auto map = makeNestedMap(static_cast<std::size_t>(state.range(0)));
+    printToStream(state, utils::printRange(map));
+}
+BENCHMARK(BM_PrintWholeNestedMap)->Arg(1 << 10)->Arg(1 << 20);
+
+static void BM_PrintNestedMapHeadAndTail(benchmark::State& state)
+{
+    const auto map = makeNestedMap(static_cast<std::size_t>(state.range(0)));
+    printToStream(state, utils::printRange(map, {8, 2}));
+}
+BENCHMARK(BM_PrintNestedMapHeadAndTail)->Arg(1 << 10)->Arg(1 << 20);
+
+static void BM_PrintVectorHeadAndTail(benchmark::State& state)
+{
+    std::vector<int> numbers(static_cast<std::size_t>(state.range(0)));
+    std::iota(numbers.begin(), numbers.end(), 0);
+    printToStream(state, utils::printRange(numbers, {8, 2}));
+}
+BENCHMARK(BM_PrintVectorHeadAndTail)->Arg(1 << 10)->Arg(10'000'000);
+
+static void BM_PrintVectorFirstKilobyte(benchmark::State& state)
+{
+    std::vector<int> numbers(static_cast<std::size_t>(state.range(0)));
+    std::iota(numbers.begin(), numbers.end(), 0);
+    utils::PrintLimits limits;
+    limits.maxBytes = 1024;
+    printToStream(state, utils::printRange(numbers, limits));
+}
+BENCHMARK(BM_PrintVectorFirstKilobyte)->Arg(1 << 10)->Arg(10'000'000);
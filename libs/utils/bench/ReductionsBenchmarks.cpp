@@ -0,0 +1,112 @@
+#include <benchmark/benchmark.h>
+#include "utils/Reductions.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <numeric>
+#include <random>
+#include <vector>
+
+namespace
+{
+// Magnitudes spread over 16 decades with both signs, which is where plain + loses digits.
+std::vector<double> makeDoubles(std::size_t size)
+{
+    std::mt19937 generator{42};
+    std::uniform_real_distribution<double> mantissa{-1.0, 1.0};
+    std::uniform_int_distribution<int> exponent{-8, 8};
+    std::vector<double> vec(size);
+    std::generate(vec.begin(), vec.end(), [&] { return std::ldexp(mantissa(generator), 3 * exponent(generator)); });
+    return vec;
+}
+
+std::vector<int> makeIntegers(std::size_t size)
+{
+    std::mt19937 generator{42};
+    std::uniform_int_distribution<int> distribution{-(1 << 30), 1 << 30};
+    std::vector<int> vec(size);
+    std::generate(vec.begin(), vec.end(), [&] { return distribution(generator); });
+    return vec;
+}
+
+// Sum in long double with compensation, the reference the relative errors are reported against.
+long double referenceSum(const std::vector<double>& vec)
+{
+    const std::vector<long double> wide(vec.begin(), vec.end());
+    return utils::sum(utils::ReduceKernel::Scalar, wide);
+}
+
+template<typename T, typename Reduce>
+void reduce(benchmark::State& state, const std::vector<T>& vec, Reduce reduceOnce)
+{
+    decltype(reduceOnce()) result{};
+    for(auto _ : state)
+    {
+        result = reduceOnce();
+        benchmark::DoNotOptimize(result);
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * vec.size() * sizeof(T)));
+    if constexpr(std::is_floating_point_v<T>)
+    {
+        const auto reference = referenceSum(vec);
+        state.counters["relative_error"] = static_cast<double>(std::fabs((result - reference) / reference));
+    }
+}
+}
+
+static void BM_AccumulateDoubles(benchmark::State& state)
+{
+    const auto vec = makeDoubles(static_cast<std::size_t>(state.range(0)));
+    reduce(state, vec, [&vec] { return std::accumulate(vec.begin(), vec.end(), 0.0); });
+}
+BENCHMARK(BM_AccumulateDoubles)->Arg(1 << 12)->Arg(1 << 22);
+
+static void BM_SumDoubles(benchmark::State& state, utils::ReduceKernel kernel)
+{
+    if(not utils::isReduceKernelSupported(kernel))
+    {
+        return state.SkipWithError("kernel is not supported by this CPU");
+    }
+    const auto vec = makeDoubles(static_cast<std::size_t>(state.range(0)));
+    reduce(state, vec, [&vec, kernel] { return utils::sum(kernel, vec); });
+}
+BENCHMARK_CAPTURE(BM_SumDoubles, Scalar, utils::ReduceKernel::Scalar)->Arg(1 << 12)->Arg(1 << 22);
+BENCHMARK_CAPTURE(BM_SumDoubles, Avx2, utils::ReduceKernel::Avx2)->Arg(1 << 12)->Arg(1 << 22);
+
+static void BM_SumDoublesParallel(benchmark::State& state)
+{
+    const auto vec = makeDoubles(static_cast<std::size_t>(state.range(0)));
+    reduce(state, vec, [&vec] { return utils::sumParallel(vec); });
+}
+BENCHMARK(BM_SumDoublesParallel)->Arg(1 << 22)->UseRealTime();
+
+static void BM_VarianceDoubles(benchmark::State& state)
+{
+    const auto vec = makeDoubles(static_cast<std::size_t>(state.range(0)));
+    for(auto _ : state)
+    {
+        benchmark::DoNotOptimize(utils::variance(vec));
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * vec.size() * sizeof(double)));
+}
+BENCHMARK(BM_VarianceDoubles)->Arg(1 << 12)->Arg(1 << 22);
+
+static void BM_AccumulateIntegers(benchmark::State& state)
+{
+    const auto vec = makeIntegers(static_cast<std::size_t>(state.range(0)));
+    reduce(state, vec, [&vec] { return std::accumulate(vec.begin(), vec.end(), std::int64_t{}); });
+}
+BENCHMARK(BM_AccumulateIntegers)->Arg(1 << 12)->Arg(1 << 22);
+
+static void BM_SumIntegers(benchmark::State& state, utils::ReduceKernel kernel)
+{
+    if(not utils::isReduceKernelSupported(kernel))
+    {
+        return state.SkipWithError("kernel is not supported by this CPU");
+    }
+    const auto vec = makeIntegers(static_cast<std::size_t>(state.range(0)));
+    reduce(state, vec, [&vec, kernel] { return utils::sum(kernel, vec); });
+}
+BENCHMARK_CAPTURE(BM_SumIntegers, Scalar, utils::ReduceKernel::Scalar)->Arg(1 << 12)->Arg(1 << 22);
+BENCHMARK_CAPTURE(BM_SumIntegers, Avx2, utils::ReduceKernel::Avx2)->Arg(1 << 12)->Arg(1 << 22);
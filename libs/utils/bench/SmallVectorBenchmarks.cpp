@@ -0,0 +1,79 @@
+#include <benchmark/benchmark.h>
+#include "utils/SmallVector.hpp"
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+namespace
+{
+struct Handle
+{
+    std::unique_ptr<int> value;
+};
+
+// Builds a short-lived collection of size elements per iteration, the way a function
+// collecting a few results into a local vector would.
+template<typename Container>
+void buildAndDrop(benchmark::State& state)
+{
+    const auto size = static_cast<int>(state.range(0));
+    for(auto _ : state)
+    {
+        Container container;
+        for(int i = 0; i < size; ++i)
+        {
+            container.push_back(i);
+        }
+        benchmark::DoNotOptimize(container.data());
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * size);
+}
+
+template<typename Container>
+void growHandles(benchmark::State& state)
+{
+    const auto size = static_cast<int>(state.range(0));
+    for(auto _ : state)
+    {
+        Container container;
+        for(int i = 0; i < size; ++i)
+        {
+            container.push_back(Handle{nullptr});
+        }
+        benchmark::DoNotOptimize(container.data());
+    }
+    state.SetItemsProcessed(state.iterations() * size);
+}
+}
+
+template<>
+constexpr bool traits::is_trivially_relocatable<Handle> = true;
+
+static void BM_StdVectorShortLived(benchmark::State& state)
+{
+    buildAndDrop<std::vector<int>>(state);
+}
+BENCHMARK(BM_StdVectorShortLived)->Arg(4)->Arg(8)->Arg(16)->Arg(64);
+
+static void BM_SmallVectorShortLived(benchmark::State& state)
+{
+    buildAndDrop<utils::small_vector<int, 16>>(state);
+}
+BENCHMARK(BM_SmallVectorShortLived)->Arg(4)->Arg(8)->Arg(16)->Arg(64);
+
+
+// Handles are unique_ptr wrappers marked trivially relocatable, std::vector moves and
+// destroys them one by one when it grows.
+static void BM_StdVectorGrowHandles(benchmark::State& state)
+{
+    growHandles<std::vector<Handle>>(state);
+}
+BENCHMARK(BM_StdVectorGrowHandles)->Arg(1 << 10)->Arg(1 << 16);
+
+static void BM_SmallVectorGrowHandles(benchmark::State& state)
+{
+    growHandles<utils::small_vector<Handle, 4>>(state);
+}
+BENCHMARK(BM_SmallVectorGrowHandles)->Arg(1 << 10)->Arg(1 << 16);
@@ -0,0 +1,119 @@
+#include <benchmark/benchmark.h>
+#include "utils/Reductions.hpp"
+#include "utils/SoaVector.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace
+{
+struct Employee
+{
+    std::string full_name{};
+    unsigned age{};
+    unsigned salary{};
+};
+
+template<typename Container>
+Container makeEmployees(std::size_t size)
+{
+    std::mt19937 generator{42};
+    std::uniform_int_distribution<unsigned> age{18, 67};
+    std::uniform_int_distribution<unsigned> salary{3000, 30000};
+    Container employees;
+    employees.reserve(size);
+    for(std::size_t i = 0; i < size; ++i)
+    {
+        employees.push_back(Employee{"Employee " + std::to_string(i), age(generator), salary(generator)});
+    }
+    return employees;
+}
+
+void reportRows(benchmark::State& state)
+{
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+}
+
+static void BM_SumSalariesAos(benchmark::State& state)
+{
+    const auto employees = makeEmployees<std::vector<Employee>>(static_cast<std::size_t>(state.range(0)));
+    for(auto _ : state)
+    {
+        std::uint64_t total{};
+        for(const auto& employee : employees)
+        {
+            total += employee.salary;
+        }
+        benchmark::DoNotOptimize(total);
+    }
+    reportRows(state);
+}
+BENCHMARK(BM_SumSalariesAos)->Arg(1 << 12)->Arg(1 << 20);
+
+static void BM_SumSalariesSoa(benchmark::State& state)
+{
+    const auto employees = makeEmployees<utils::soa_vector<Employee>>(static_cast<std::size_t>(state.range(0)));
+    for(auto _ : state)
+    {
+        std::uint64_t total{};
+        for(auto salary : employees.column<2>())
+        {
+            total += salary;
+        }
+        benchmark::DoNotOptimize(total);
+    }
+    reportRows(state);
+}
+BENCHMARK(BM_SumSalariesSoa)->Arg(1 << 12)->Arg(1 << 20);
+
+static void BM_SumSalariesSoaKernel(benchmark::State& state)
+{
+    const auto employees = makeEmployees<utils::soa_vector<Employee>>(static_cast<std::size_t>(state.range(0)));
+    for(auto _ : state)
+    {
+        benchmark::DoNotOptimize(utils::sum(employees.column<2>()));
+    }
+    reportRows(state);
+}
+BENCHMARK(BM_SumSalariesSoaKernel)->Arg(1 << 12)->Arg(1 << 20);
+
+static void BM_CountOver30Aos(benchmark::State& state)
+{
+    const auto employees = makeEmployees<std::vector<Employee>>(static_cast<std::size_t>(state.range(0)));
+    for(auto _ : state)
+    {
+        benchmark::DoNotOptimize(std::count_if(employees.begin(), employees.end(),
+                                               [](const Employee& employee) { return employee.age > 30; }));
+    }
+    reportRows(state);
+}
+BENCHMARK(BM_CountOver30Aos)->Arg(1 << 12)->Arg(1 << 20);
+
+static void BM_CountOver30Soa(benchmark::State& state)
+{
+    const auto employees = makeEmployees<utils::soa_vector<Employee>>(static_cast<std::size_t>(state.range(0)));
+    for(auto _ : state)
+    {
+        const auto ages = employees.column<1>();
+        benchmark::DoNotOptimize(std::count_if(ages.begin(), ages.end(), [](unsigned age) { return age > 30; }));
+    }
+    reportRows(state);
+}
+BENCHMARK(BM_CountOver30Soa)->Arg(1 << 12)->Arg(1 << 20);
+
+// Row proxies fold away, a filter through them still reads only the age column.
+static void BM_CountOver30SoaRows(benchmark::State& state)
+{
+    const auto employees = makeEmployees<utils::soa_vector<Employee>>(static_cast<std::size_t>(state.range(0)));
+    for(auto _ : state)
+    {
+        benchmark::DoNotOptimize(std::count_if(employees.begin(), employees.end(),
+                                               [](const auto& row) { return row.template get<1>() > 30; }));
+    }
+    reportRows(state);
+}
+BENCHMARK(BM_CountOver30SoaRows)->Arg(1 << 12)->Arg(1 << 20);
@@ -0,0 +1,119 @@
+#include <benchmark/benchmark.h>
+#include "utils/MonotonicArena.hpp"
+#include "utils/PoolResource.hpp"
+#include "utils/Vector.hpp"
+
+#include <cstddef>
+#include <memory_resource>
+#include <string>
+#include <vector>
+
+namespace
+{
+constexpr int vectorsPerRequest{64};
+constexpr int elementsPerVector{32};
+
+// Stands in for std::allocator and counts what reaches the heap.
+struct CountingResource : std::pmr::memory_resource
+{
+    std::size_t allocations{};
+
+    void* do_allocate(std::size_t bytes, std::size_t alignment) override
+    {
+        ++allocations;
+        return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+    }
+
+    void do_deallocate(void* pointer, std::size_t bytes, std::size_t alignment) override
+    {
+        std::pmr::new_delete_resource()->deallocate(pointer, bytes, alignment);
+    }
+
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override
+    {
+        return this == &other;
+    }
+};
+
+// One request: builds a batch of vectors element by element and drops them all.
+template<typename Vector, typename... Args>
+void buildRequest(const Args&... args)
+{
+    std::vector<Vector> vectors;
+    vectors.reserve(vectorsPerRequest);
+    for(int v = 0; v < vectorsPerRequest; ++v)
+    {
+        auto& vector = vectors.emplace_back(args...);
+        for(int i = 0; i < elementsPerVector; ++i)
+        {
+            vector.push_back(i);
+        }
+        benchmark::DoNotOptimize(vector.data());
+    }
+}
+
+void reportRequests(benchmark::State& state, std::size_t allocations)
+{
+    state.SetItemsProcessed(state.iterations() * vectorsPerRequest * elementsPerVector);
+    state.counters["allocations_per_request"] = static_cast<double>(allocations) / static_cast<double>(state.iterations());
+}
+}
+
+static void BM_StdVectorRequest(benchmark::State& state)
+{
+    for(auto _ : state)
+    {
+        buildRequest<std::vector<int>>();
+    }
+    state.SetItemsProcessed(state.iterations() * vectorsPerRequest * elementsPerVector);
+}
+BENCHMARK(BM_StdVectorRequest);
+
+static void BM_VectorRequestStdAllocator(benchmark::State& state)
+{
+    for(auto _ : state)
+    {
+        buildRequest<utils::vector<int>>();
+    }
+    state.SetItemsProcessed(state.iterations() * vectorsPerRequest * elementsPerVector);
+}
+BENCHMARK(BM_VectorRequestStdAllocator);
+
+static void BM_VectorRequest(benchmark::State& state)
+{
+    CountingResource heap;
+    for(auto _ : state)
+    {
+        buildRequest<utils::pmr::vector<int>>(&heap);
+    }
+    reportRequests(state, heap.allocations);
+}
+BENCHMARK(BM_VectorRequest);
+
+static void BM_VectorRequestOnArena(benchmark::State& state)
+{
+    CountingResource heap;
+    utils::MonotonicArena arena{4096, &heap};
+    for(auto _ : state)
+    {
+        buildRequest<utils::pmr::vector<int>>(&arena);
+        arena.reset();
+    }
+    reportRequests(state, heap.allocations);
+}
+BENCHMARK(BM_VectorRequestOnArena);
+
+static void BM_VectorRequestOnPool(benchmark::State& state)
+{
+    CountingResource heap;
+    utils::MonotonicArena arena{4096, &heap};
+    for(auto _ : state)
+    {
+        utils::PoolResource pool{&arena};
+        buildRequest<utils::pmr::vector<int>>(&pool);
+        pool.release();
+        arena.reset();
+    }
+    reportRequests(state, heap.allocations);
+}
+BENCHMARK(BM_VectorRequestOnPool);
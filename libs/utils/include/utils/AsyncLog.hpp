@@ -0,0 +1,449 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <climits>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <ostream>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "utils/RangeFormatter.hpp"
+
+namespace utils
+{
+// What log() does when the ring buffer is full.
+enum class OverflowPolicy
+{
+    Drop,  // give the record up and count it in dropped()
+    Block, // spin until the background thread frees a slot
+    Grow   // chain a ring twice as large, memory is given back when the log is destroyed
+};
+
+struct AsyncLogOptions
+{
+    std::size_t capacity{1024};
+    OverflowPolicy policy{OverflowPolicy::Block};
+    std::chrono::microseconds idleSleep{50};
+};
+
+namespace detail
+{
+constexpr std::size_t logSlotSize{128};
+constexpr std::size_t logSlotStorageSize{logSlotSize - 2 * sizeof(void*)};
+
+// Pre-sized ring entry. process formats the captured record into out and destroys it,
+// a null out only destroys it. It returns false when formatting threw.
+struct alignas(logSlotSize) LogSlot
+{
+    std::atomic<std::size_t> sequence;
+    bool (*process)(void* storage, std::string* out);
+    alignas(std::max_align_t) unsigned char storage[logSlotStorageSize];
+};
+
+static_assert(sizeof(LogSlot) == logSlotSize);
+
+// Values writeValue() can not format, e.g. types with just an operator<<, go through the
+// std::ostream ValuePrinter, which prints them the way printRange() does.
+template<typename T>
+inline void formatLogValue(StringWriter& writer, const T& value)
+{
+    if constexpr(is_writer_formattable<T>)
+    {
+        writeValue(writer, makeValuePrinter(value));
+    }
+    else
+    {
+        std::ostringstream stream;
+        stream << makeValuePrinter(value);
+        writer.write(stream.str());
+    }
+}
+
+template<typename... Args>
+struct LogRecord
+{
+    void format(std::string& out) const
+    {
+        StringWriter writer{out};
+        std::apply([&writer](const auto&... values) { (formatLogValue(writer, values), ...); }, args);
+        writer.put('\n');
+    }
+
+    std::tuple<Args...> args;
+};
+
+// Records which do not fit into a slot are allocated and the slot keeps the pointer.
+template<typename Record>
+constexpr bool fits_log_slot = sizeof(Record) <= logSlotStorageSize and alignof(Record) <= alignof(std::max_align_t);
+
+// Written instead of a record whose formatting threw.
+constexpr std::string_view unformattedRecord{"<record could not be formatted>\n"};
+
+// An exception from a user operator<< or an allocation must not leave the background
+// thread, the partial text of the record is replaced by unformattedRecord.
+template<typename Record>
+bool formatRecord(const Record& record, std::string* out)
+{
+    if(not out)
+    {
+        return true;
+    }
+    const auto size = out->size();
+    try
+    {
+        record.format(*out);
+        return true;
+    }
+    catch(...)
+    {
+        out->resize(size);
+    }
+    try
+    {
+        out->append(unformattedRecord);
+    }
+    catch(...)
+    {
+    }
+    return false;
+}
+
+template<typename Record>
+bool processRecord(void* storage, std::string* out)
+{
+    if constexpr(fits_log_slot<Record>)
+    {
+        auto* record = std::launder(static_cast<Record*>(storage));
+        const bool formatted = formatRecord(*record, out);
+        record->~Record();
+        return formatted;
+    }
+    else
+    {
+        std::unique_ptr<Record> record{*static_cast<Record**>(storage)};
+        return formatRecord(*record, out);
+    }
+}
+
+inline bool skipRecord(void*, std::string*) { return true; }
+
+enum class ClaimStatus
+{
+    Claimed,
+    Full,
+    Closed
+};
+
+// Bounded multi-producer single-consumer ring (Vyukov's sequence-per-slot scheme).
+// Closing freezes the enqueue position, the consumer then drains what was claimed
+// before it and moves on to next().
+class LogRing
+{
+public:
+    explicit LogRing(std::size_t capacity)
+        : slots_{new LogSlot[capacity]}, mask_{capacity - 1}
+    {
+        for(std::size_t index = 0; index < capacity; ++index)
+        {
+            slots_[index].sequence.store(index, std::memory_order_relaxed);
+        }
+    }
+
+    std::size_t capacity() const { return mask_ + 1; }
+
+    ClaimStatus claim(LogSlot*& slot, std::size_t& position)
+    {
+        position = enqueue_.load(std::memory_order_relaxed);
+        for(;;)
+        {
+            if(position & closedBit)
+            {
+                return ClaimStatus::Closed;
+            }
+            slot = &slots_[position & mask_];
+            const auto sequence = slot->sequence.load(std::memory_order_acquire);
+            const auto difference = static_cast<std::intptr_t>(sequence) - static_cast<std::intptr_t>(position);
+            if(difference == 0)
+            {
+                if(enqueue_.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+                {
+                    return ClaimStatus::Claimed;
+                }
+            }
+            else if(difference < 0)
+            {
+                return ClaimStatus::Full;
+            }
+            else
+            {
+                position = enqueue_.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    static void publish(LogSlot& slot, std::size_t position)
+    {
+        slot.sequence.store(position + 1, std::memory_order_release);
+    }
+
+    // Consumer side, null when the next record is not published yet.
+    LogSlot* front()
+    {
+        auto& slot = slots_[dequeue_ & mask_];
+        return slot.sequence.load(std::memory_order_acquire) == dequeue_ + 1 ? &slot : nullptr;
+    }
+
+    void pop(LogSlot& slot)
+    {
+        slot.sequence.store(dequeue_ + capacity(), std::memory_order_release);
+        ++dequeue_;
+    }
+
+    void close(LogRing& next)
+    {
+        next_.store(&next, std::memory_order_release);
+        enqueue_.fetch_or(closedBit, std::memory_order_acq_rel);
+    }
+
+    // Consumer side, true once the ring is closed and everything claimed before was popped.
+    bool drained() const
+    {
+        const auto position = enqueue_.load(std::memory_order_acquire);
+        return (position & closedBit) and dequeue_ == (position & ~closedBit);
+    }
+
+    LogRing* next() const { return next_.load(std::memory_order_acquire); }
+
+private:
+    static constexpr std::size_t closedBit{std::size_t{1} << (sizeof(std::size_t) * CHAR_BIT - 1)};
+
+    std::unique_ptr<LogSlot[]> slots_;
+    std::size_t mask_;
+    std::atomic<LogRing*> next_{};
+    alignas(logSlotSize) std::atomic<std::size_t> enqueue_{};
+    alignas(logSlotSize) std::size_t dequeue_{};
+};
+
+inline std::size_t roundUpToPowerOfTwo(std::size_t value)
+{
+    std::size_t result{1};
+    while(result < value)
+    {
+        result <<= 1;
+    }
+    return result;
+}
+}
+
+// Deferred formatting logger. log() only moves or copies its arguments into a pre-sized
+// slot of a lock-free ring, the ValuePrinter formatting and the writes to sink happen on
+// a background thread. Each call becomes one line, arguments are written back to back.
+// Pointers (C strings included) are captured as they are and must outlive the record.
+class AsyncLog
+{
+public:
+    explicit AsyncLog(std::ostream& sink, AsyncLogOptions options = {})
+        : sink_{sink}, policy_{options.policy}, idleSleep_{options.idleSleep}
+    {
+        rings_.push_back(std::make_unique<detail::LogRing>(detail::roundUpToPowerOfTwo(options.capacity)));
+        current_.store(rings_.front().get(), std::memory_order_relaxed);
+        worker_ = std::thread{[this] { run(); }};
+    }
+
+    AsyncLog(const AsyncLog&) = delete;
+    AsyncLog& operator=(const AsyncLog&) = delete;
+
+    // Everything logged before destruction is still written out.
+    ~AsyncLog()
+    {
+        stop_.store(true, std::memory_order_release);
+        worker_.join();
+    }
+
+    // Returns false when the record was dropped because of OverflowPolicy::Drop.
+    template<typename... Args>
+    bool log(Args&&... args)
+    {
+        return push<detail::LogRecord<std::decay_t<Args>...>>(std::forward<Args>(args)...);
+    }
+
+    // Waits until every record published so far reached the sink.
+    void flush()
+    {
+        const auto target = published_.load(std::memory_order_acquire);
+        while(written_.load(std::memory_order_acquire) < target)
+        {
+            std::this_thread::sleep_for(idleSleep_);
+        }
+    }
+
+    std::size_t dropped() const { return dropped_.load(std::memory_order_relaxed); }
+
+    // Records whose formatting threw, each was written as a placeholder line.
+    std::size_t failed() const { return failed_.load(std::memory_order_relaxed); }
+
+private:
+    static constexpr std::size_t writeThreshold{1 << 16};
+
+    template<typename Record, typename... Args>
+    bool push(Args&&... args)
+    {
+        for(;;)
+        {
+            auto* ring = current_.load(std::memory_order_acquire);
+            detail::LogSlot* slot;
+            std::size_t position;
+            switch(ring->claim(slot, position))
+            {
+            case detail::ClaimStatus::Claimed:
+                emplace<Record>(*slot, position, std::forward<Args>(args)...);
+                return true;
+            case detail::ClaimStatus::Closed:
+                break;
+            case detail::ClaimStatus::Full:
+                if(policy_ == OverflowPolicy::Drop)
+                {
+                    dropped_.fetch_add(1, std::memory_order_relaxed);
+                    return false;
+                }
+                if(policy_ == OverflowPolicy::Grow)
+                {
+                    grow(*ring);
+                }
+                else
+                {
+                    std::this_thread::yield();
+                }
+                break;
+            }
+        }
+    }
+
+    // A claimed slot has to be published even when capturing throws, otherwise the
+    // consumer would wait for it forever.
+    template<typename Record, typename... Args>
+    void emplace(detail::LogSlot& slot, std::size_t position, Args&&... args)
+    {
+        try
+        {
+            if constexpr(detail::fits_log_slot<Record>)
+            {
+                ::new(static_cast<void*>(slot.storage)) Record{{std::forward<Args>(args)...}};
+            }
+            else
+            {
+                ::new(static_cast<void*>(slot.storage)) Record*{new Record{{std::forward<Args>(args)...}}};
+            }
+            slot.process = &detail::processRecord<Record>;
+        }
+        catch(...)
+        {
+            // The consumer counts the skipped slot as written, flush() has to expect it.
+            slot.process = &detail::skipRecord;
+            published_.fetch_add(1, std::memory_order_release);
+            detail::LogRing::publish(slot, position);
+            throw;
+        }
+        // Counted before the consumer can see it, so written_ never runs ahead of
+        // published_ and flush() can not return before a record of its caller is written.
+        published_.fetch_add(1, std::memory_order_release);
+        detail::LogRing::publish(slot, position);
+    }
+
+    void grow(detail::LogRing& full)
+    {
+        std::lock_guard<std::mutex> lock{growMutex_};
+        if(current_.load(std::memory_order_relaxed) != &full)
+        {
+            return;
+        }
+        rings_.push_back(std::make_unique<detail::LogRing>(full.capacity() * 2));
+        full.close(*rings_.back());
+        current_.store(rings_.back().get(), std::memory_order_release);
+    }
+
+    detail::LogSlot* nextSlot(detail::LogRing*& ring)
+    {
+        for(;;)
+        {
+            if(auto* slot = ring->front())
+            {
+                return slot;
+            }
+            if(not ring->drained())
+            {
+                return nullptr;
+            }
+            ring = ring->next();
+        }
+    }
+
+    void write(std::string& text, std::size_t& pending)
+    {
+        sink_.write(text.data(), static_cast<std::streamsize>(text.size()));
+        sink_.flush();
+        text.clear();
+        written_.fetch_add(std::exchange(pending, 0), std::memory_order_release);
+    }
+
+    void run()
+    {
+        auto* ring = current_.load(std::memory_order_acquire);
+        std::string text;
+        std::size_t pending{};
+        for(;;)
+        {
+            const auto stopping = stop_.load(std::memory_order_acquire);
+            while(auto* slot = nextSlot(ring))
+            {
+                if(not slot->process(slot->storage, &text))
+                {
+                    failed_.fetch_add(1, std::memory_order_relaxed);
+                }
+                ring->pop(*slot);
+                ++pending;
+                if(text.size() >= writeThreshold)
+                {
+                    write(text, pending);
+                }
+            }
+
+            if(pending != 0)
+            {
+                write(text, pending);
+            }
+            else if(stopping)
+            {
+                return;
+            }
+            else
+            {
+                std::this_thread::sleep_for(idleSleep_);
+            }
+        }
+    }
+
+    std::ostream& sink_;
+    const OverflowPolicy policy_;
+    const std::chrono::microseconds idleSleep_;
+    std::atomic<detail::LogRing*> current_{};
+    std::mutex growMutex_;
+    std::vector<std::unique_ptr<detail::LogRing>> rings_;
+    alignas(detail::logSlotSize) std::atomic<std::size_t> published_{};
+    alignas(detail::logSlotSize) std::atomic<std::size_t> written_{};
+    std::atomic<std::size_t> dropped_{};
+    std::atomic<std::size_t> failed_{};
+    std::atomic<bool> stop_{};
+    std::thread worker_;
+};
+}
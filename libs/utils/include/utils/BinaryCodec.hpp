@@ -0,0 +1,477 @@
+#pragma once
+
+#include <algorithm>
+#include <charconv>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <type_traits>
+#include <utility>
+#include "traits/IsContiguousRange.hpp"
+#include "traits/IsIterable.hpp"
+#include "traits/IsStringLike.hpp"
+#include "utils/RangeParser.hpp"
+
+namespace utils
+{
+// How integers outside of length prefixes are stored. Fixed keeps ranges of them
+// as aligned raw blocks (one memcpy each way, zero-copy ArrayView decoding), Varint
+// writes zigzag LEB128 and trades that for size when the values are small.
+enum class IntegerEncoding
+{
+    Fixed,
+    Varint
+};
+
+// Read-only view of a run of values inside an encoded buffer.
+template<typename T>
+class ArrayView
+{
+public:
+    ArrayView() = default;
+    ArrayView(const T* data, std::size_t size)
+        : data_{data}, size_{size}
+    {}
+
+    const T* data() const { return data_; }
+    std::size_t size() const { return size_; }
+    bool empty() const { return size_ == 0; }
+    const T* begin() const { return data_; }
+    const T* end() const { return data_ + size_; }
+    const T& operator[](std::size_t index) const { return data_[index]; }
+
+private:
+    const T* data_{};
+    std::size_t size_{};
+};
+
+namespace detail
+{
+template<typename>
+constexpr bool is_array_view{};
+
+template<typename T>
+constexpr bool is_array_view<ArrayView<T>> = true;
+
+// Values written as their object representation: arithmetic types, enums and trivially
+// copyable types the dispatch knows nothing else about. Pointers are not, their addresses
+// mean nothing to the decoding side; neither can it tell pointers inside such types.
+template<typename T>
+constexpr bool is_binary_leaf = std::is_trivially_copyable_v<T> and not is_std_pair<T> and
+                                not traits::is_iterable<T> and not traits::is_string_like<T> and
+                                not std::is_pointer_v<T> and not std::is_member_pointer_v<T>;
+
+// Element type of a range as encodeValue() sees it: what the iterator yields, unless that
+// is a proxy it does not know such as the bit reference of std::vector<bool>, which stands
+// for the value type.
+template<typename Iterator,
+         typename Reference = std::remove_cv_t<std::remove_reference_t<decltype(*std::declval<Iterator&>())>>>
+using encoded_element_t = std::conditional_t<
+    is_std_pair<Reference> or traits::is_string_like<Reference> or is_array_view<Reference> or
+        traits::is_iterable<Reference> or is_binary_leaf<Reference> or std::is_pointer_v<Reference>,
+    Reference,
+    std::remove_cv_t<typename std::iterator_traits<Iterator>::value_type>>;
+
+template<typename T, IntegerEncoding Encoding>
+constexpr bool is_varint_leaf = Encoding == IntegerEncoding::Varint and std::is_integral_v<T> and
+                                not std::is_same_v<T, bool> and sizeof(T) > 1;
+
+// Ranges of these are stored as count, padding up to alignof(T), then the raw values.
+template<typename T, IntegerEncoding Encoding>
+constexpr bool is_binary_block = is_binary_leaf<T> and not is_varint_leaf<T, Encoding>;
+
+template<typename T>
+inline auto zigzag(T value)
+{
+    using Unsigned = std::make_unsigned_t<T>;
+    if constexpr(std::is_signed_v<T>)
+    {
+        return static_cast<Unsigned>((static_cast<Unsigned>(value) << 1) ^ static_cast<Unsigned>(value >> (sizeof(T) * 8 - 1)));
+    }
+    else
+    {
+        return value;
+    }
+}
+
+template<typename T>
+inline T unzigzag(std::make_unsigned_t<T> value)
+{
+    if constexpr(std::is_signed_v<T>)
+    {
+        return static_cast<T>((value >> 1) ^ (~(value & 1) + 1));
+    }
+    else
+    {
+        return value;
+    }
+}
+
+inline std::size_t alignmentPadding(std::size_t offset, std::size_t alignment)
+{
+    return (alignment - offset % alignment) % alignment;
+}
+
+// Mirrors the ValuePrinter dispatch: pairs are their two fields, strings and ranges are a
+// varint count followed by the bytes or the elements, leaves are their raw bytes in native
+// byte order. Padding is computed from the offset to where the encoding started.
+template<IntegerEncoding Encoding>
+class BinaryEncoder
+{
+public:
+    explicit BinaryEncoder(std::string& out)
+        : out_{out}, start_{out.size()}, size_{out.size()}
+    {}
+
+    // out_ is grown geometrically ahead of size_, this trims it to what was written.
+    void finish()
+    {
+        out_.resize(size_);
+    }
+
+    template<typename T>
+    void encodeValue(const T& value)
+    {
+        if constexpr(is_std_pair<T>)
+        {
+            encodeValue(value.first);
+            encodeValue(value.second);
+        }
+        else if constexpr(traits::is_string_like<T>)
+        {
+            const std::string_view text{value};
+            encodeVarint(text.size());
+            appendBytes(text.data(), text.size());
+        }
+        else if constexpr(is_array_view<T> or traits::is_iterable<T>)
+        {
+            encodeRange(value);
+        }
+        else if constexpr(is_varint_leaf<T, Encoding>)
+        {
+            encodeVarint(zigzag(value));
+        }
+        else if constexpr(is_binary_leaf<T>)
+        {
+            appendBytes(&value, sizeof(T));
+        }
+        else if constexpr(std::is_pointer_v<T> or std::is_member_pointer_v<T>)
+        {
+            static_assert(dependent_false<T>, "encodeBinary does not write pointers, encode what they point to");
+        }
+        else
+        {
+            static_assert(dependent_false<T>, "type is not supported by encodeBinary");
+        }
+    }
+
+    void encodeVarint(std::uint64_t value)
+    {
+        auto* out = reserve(maxVarintSize);
+        for(; value >= 0x80; value >>= 7)
+        {
+            *out++ = static_cast<char>(value | 0x80);
+        }
+        *out++ = static_cast<char>(value);
+        size_ = static_cast<std::size_t>(out - out_.data());
+    }
+
+private:
+    template<typename Range>
+    void encodeRange(const Range& range)
+    {
+        using Element = encoded_element_t<decltype(std::begin(range))>;
+        const auto size = static_cast<std::size_t>(std::distance(std::begin(range), std::end(range)));
+        encodeVarint(size);
+        if constexpr(is_binary_block<Element, Encoding>)
+        {
+            const auto padding = alignmentPadding(size_ - start_, alignof(Element));
+            std::memset(reserve(padding), 0, padding);
+            size_ += padding;
+            if constexpr(traits::is_contiguous_range<const Range>)
+            {
+                return appendBytes(std::data(range), size * sizeof(Element));
+            }
+        }
+        for(auto&& element : range)
+        {
+            const Element& value = element;
+            encodeValue(value);
+        }
+    }
+
+    static constexpr std::size_t maxVarintSize{10};
+
+    char* reserve(std::size_t size)
+    {
+        if(out_.size() - size_ < size)
+        {
+            out_.resize(std::max(2 * out_.size(), size_ + size));
+        }
+        return out_.data() + size_;
+    }
+
+    // Empty ranges pass a null data, which memcpy must not get even for zero bytes.
+    void appendBytes(const void* data, std::size_t size)
+    {
+        if(size == 0)
+        {
+            return;
+        }
+        std::memcpy(reserve(size), data, size);
+        size_ += size;
+    }
+
+    std::string& out_;
+    std::size_t start_;
+    std::size_t size_;
+};
+
+template<typename, typename = void>
+constexpr bool is_resizable_contiguous{};
+
+template<typename T>
+constexpr bool is_resizable_contiguous<
+    T,
+    std::void_t<decltype(std::declval<T&>().resize(std::size_t{}))>
+> = traits::is_contiguous_range<T>;
+
+template<typename, typename = void>
+constexpr bool is_reservable{};
+
+template<typename T>
+constexpr bool is_reservable<T, std::void_t<decltype(std::declval<T&>().reserve(std::size_t{}))>> = true;
+
+template<IntegerEncoding Encoding>
+class BinaryDecoder
+{
+public:
+    BinaryDecoder(const char* first, const char* last)
+        : first_{first}, current_{first}, last_{last}
+    {}
+
+    const char* current() const { return current_; }
+    bool failed() const { return failed_; }
+
+    template<typename T>
+    void decodeValue(T& value)
+    {
+        if constexpr(is_std_pair<T>)
+        {
+            decodeValue(value.first);
+            decodeValue(value.second);
+        }
+        else if constexpr(is_parsed_string<T>)
+        {
+            const auto size = decodeVarint();
+            if(failed_ or size > remaining())
+            {
+                return fail();
+            }
+            value = T(current_, size);
+            current_ += size;
+        }
+        else if constexpr(is_array_view<T>)
+        {
+            decodeView(value);
+        }
+        else if constexpr(traits::is_iterable<T>)
+        {
+            decodeRange(value);
+        }
+        else if constexpr(is_varint_leaf<T, Encoding>)
+        {
+            value = unzigzag<T>(static_cast<std::make_unsigned_t<T>>(decodeVarint()));
+        }
+        else if constexpr(std::is_same_v<T, bool>)
+        {
+            if(remaining() == 0 or static_cast<unsigned char>(*current_) > 1)
+            {
+                return fail();
+            }
+            value = *current_++ == 1;
+        }
+        else if constexpr(is_binary_leaf<T>)
+        {
+            readBytes(&value, sizeof(T));
+        }
+        else if constexpr(std::is_pointer_v<T> or std::is_member_pointer_v<T>)
+        {
+            static_assert(dependent_false<T>, "decodeBinary does not read pointers");
+        }
+        else
+        {
+            static_assert(dependent_false<T>, "type is not supported by decodeBinary");
+        }
+    }
+
+private:
+    template<typename Container>
+    void decodeRange(Container& container)
+    {
+        using Element = parsed_type_t<typename Container::value_type>;
+        const auto size = decodeVarint();
+        // Every element takes at least one byte, which bounds what a corrupted count may reserve.
+        if(failed_ or size > remaining())
+        {
+            return fail();
+        }
+        if constexpr(is_binary_block<Element, Encoding>)
+        {
+            if(not skipPadding(alignof(Element)))
+            {
+                return;
+            }
+            if constexpr(is_resizable_contiguous<Container> and not std::is_same_v<Element, bool>)
+            {
+                if(size > remaining() / sizeof(Element))
+                {
+                    return fail();
+                }
+                const auto offset = std::size(container);
+                container.resize(offset + size);
+                return readBytes(std::data(container) + offset, size * sizeof(Element));
+            }
+        }
+        if constexpr(is_reservable<Container>)
+        {
+            container.reserve(std::size(container) + size);
+        }
+        for(std::size_t index = 0; index < size; ++index)
+        {
+            Element element{};
+            decodeValue(element);
+            if(failed_)
+            {
+                return;
+            }
+            container.insert(container.end(), std::move(element));
+        }
+    }
+
+    // Points into the input, which has to be aligned for T at the decoded offset.
+    template<typename T>
+    void decodeView(ArrayView<T>& view)
+    {
+        static_assert(is_binary_block<T, Encoding>, "ArrayView needs raw blocks of trivially copyable values");
+        const auto size = decodeVarint();
+        if(failed_ or not skipPadding(alignof(T)) or size > remaining() / sizeof(T) or
+           reinterpret_cast<std::uintptr_t>(current_) % alignof(T) != 0)
+        {
+            return fail();
+        }
+        view = ArrayView<T>{reinterpret_cast<const T*>(current_), size};
+        current_ += size * sizeof(T);
+    }
+
+    std::uint64_t decodeVarint()
+    {
+        std::uint64_t value{};
+        for(unsigned shift = 0; shift < 64; shift += 7)
+        {
+            if(current_ == last_)
+            {
+                break;
+            }
+            const auto byte = static_cast<unsigned char>(*current_++);
+            value |= static_cast<std::uint64_t>(byte & 0x7f) << shift;
+            if((byte & 0x80) == 0)
+            {
+                return value;
+            }
+        }
+        fail();
+        return 0;
+    }
+
+    bool skipPadding(std::size_t alignment)
+    {
+        const auto padding = alignmentPadding(static_cast<std::size_t>(current_ - first_), alignment);
+        if(padding > remaining())
+        {
+            fail();
+            return false;
+        }
+        current_ += padding;
+        return true;
+    }
+
+    void readBytes(void* data, std::size_t size)
+    {
+        if(size > remaining())
+        {
+            return fail();
+        }
+        if(size == 0)
+        {
+            return;
+        }
+        std::memcpy(data, current_, size);
+        current_ += size;
+    }
+
+    std::size_t remaining() const { return static_cast<std::size_t>(last_ - current_); }
+
+    void fail()
+    {
+        failed_ = true;
+        current_ = last_;
+    }
+
+    const char* first_;
+    const char* current_;
+    const char* last_;
+    bool failed_{};
+};
+}
+
+// Appends the binary encoding of value to out.
+template<IntegerEncoding Encoding = IntegerEncoding::Fixed, typename T>
+inline void encodeBinaryTo(std::string& out, const T& value)
+{
+    detail::BinaryEncoder<Encoding> encoder{out};
+    encoder.encodeValue(value);
+    encoder.finish();
+}
+
+template<IntegerEncoding Encoding = IntegerEncoding::Fixed, typename T>
+inline std::string encodeBinary(const T& value)
+{
+    std::string out;
+    encodeBinaryTo<Encoding>(out, value);
+    return out;
+}
+
+// Decodes a value written by encodeBinary at [first, last) into value, containers are
+// appended to. std::string_view and ArrayView results point into the input, e.g. into
+// MappedFile::view(). On failure returns {last, invalid_argument}.
+template<IntegerEncoding Encoding = IntegerEncoding::Fixed, typename T>
+inline std::from_chars_result decodeBinaryFrom(const char* first, const char* last, T& value)
+{
+    detail::BinaryDecoder<Encoding> decoder{first, last};
+    decoder.decodeValue(value);
+    if(decoder.failed())
+    {
+        return {last, std::errc::invalid_argument};
+    }
+    return {decoder.current(), std::errc{}};
+}
+
+// Decodes the whole input as a single value, nothing may follow it.
+template<typename T, IntegerEncoding Encoding = IntegerEncoding::Fixed>
+inline std::optional<T> decodeBinary(std::string_view bytes)
+{
+    T value{};
+    auto [ptr, ec] = decodeBinaryFrom<Encoding>(bytes.data(), bytes.data() + bytes.size(), value);
+    if(ec != std::errc{} or ptr != bytes.data() + bytes.size())
+    {
+        return std::nullopt;
+    }
+    return value;
+}
+}
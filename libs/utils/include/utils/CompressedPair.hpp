@@ -0,0 +1,158 @@
+#pragma once
+
+#include <cstddef>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include "traits/IsTriviallyRelocatable.hpp"
+
+namespace utils
+{
+namespace detail
+{
+// Empty members become base classes and take no space. Index keeps the two bases apart
+// when both members have the same type.
+template<typename T, std::size_t Index, bool = std::is_empty_v<T> and not std::is_final_v<T>>
+class CompressedPairElement
+{
+public:
+    constexpr CompressedPairElement() = default;
+
+    template<typename Arg>
+    constexpr CompressedPairElement(std::in_place_t, Arg&& arg)
+        : value_(std::forward<Arg>(arg))
+    {}
+
+    constexpr T& get() { return value_; }
+    constexpr const T& get() const { return value_; }
+
+private:
+    T value_{};
+};
+
+template<typename T, std::size_t Index>
+class CompressedPairElement<T, Index, true> : private T
+{
+public:
+    constexpr CompressedPairElement() = default;
+
+    template<typename Arg>
+    constexpr CompressedPairElement(std::in_place_t, Arg&& arg)
+        : T(std::forward<Arg>(arg))
+    {}
+
+    constexpr T& get() { return *this; }
+    constexpr const T& get() const { return *this; }
+};
+}
+
+// Pair whose empty members (stateless allocators, comparators, hashers) take no space.
+// Copies and moves are the members' own, so it is trivially copyable whenever they are,
+// and it is a tuple-like for structured bindings and the hash library.
+template<typename First, typename Second>
+class compressed_pair : private detail::CompressedPairElement<First, 0>, private detail::CompressedPairElement<Second, 1>
+{
+    using FirstBase = detail::CompressedPairElement<First, 0>;
+    using SecondBase = detail::CompressedPairElement<Second, 1>;
+
+public:
+    using first_type = First;
+    using second_type = Second;
+
+    constexpr compressed_pair() = default;
+
+    constexpr compressed_pair(const First& first, const Second& second)
+        : FirstBase{std::in_place, first}, SecondBase{std::in_place, second}
+    {}
+
+    template<typename F, typename S,
+             typename = std::enable_if_t<std::is_constructible_v<First, F> and std::is_constructible_v<Second, S>>>
+    constexpr compressed_pair(F&& first, S&& second)
+        : FirstBase{std::in_place, std::forward<F>(first)}, SecondBase{std::in_place, std::forward<S>(second)}
+    {}
+
+    constexpr First& first() { return FirstBase::get(); }
+    constexpr const First& first() const { return FirstBase::get(); }
+    constexpr Second& second() { return SecondBase::get(); }
+    constexpr const Second& second() const { return SecondBase::get(); }
+
+    void swap(compressed_pair& other)
+    {
+        using std::swap;
+        swap(first(), other.first());
+        swap(second(), other.second());
+    }
+
+    friend void swap(compressed_pair& lhs, compressed_pair& rhs)
+    {
+        lhs.swap(rhs);
+    }
+
+    friend constexpr bool operator==(const compressed_pair& lhs, const compressed_pair& rhs)
+    {
+        return lhs.first() == rhs.first() and lhs.second() == rhs.second();
+    }
+
+    friend constexpr bool operator!=(const compressed_pair& lhs, const compressed_pair& rhs)
+    {
+        return not(lhs == rhs);
+    }
+};
+
+template<typename First, typename Second>
+compressed_pair(First, Second) -> compressed_pair<First, Second>;
+
+template<std::size_t Index, typename First, typename Second>
+constexpr auto& get(compressed_pair<First, Second>& pair)
+{
+    static_assert(Index < 2, "compressed_pair has two elements");
+    if constexpr(Index == 0)
+    {
+        return pair.first();
+    }
+    else
+    {
+        return pair.second();
+    }
+}
+
+template<std::size_t Index, typename First, typename Second>
+constexpr const auto& get(const compressed_pair<First, Second>& pair)
+{
+    static_assert(Index < 2, "compressed_pair has two elements");
+    if constexpr(Index == 0)
+    {
+        return pair.first();
+    }
+    else
+    {
+        return pair.second();
+    }
+}
+
+template<std::size_t Index, typename First, typename Second>
+constexpr auto&& get(compressed_pair<First, Second>&& pair)
+{
+    return std::move(get<Index>(pair));
+}
+}
+
+namespace std
+{
+template<typename First, typename Second>
+struct tuple_size<utils::compressed_pair<First, Second>> : std::integral_constant<std::size_t, 2>
+{};
+
+template<std::size_t Index, typename First, typename Second>
+struct tuple_element<Index, utils::compressed_pair<First, Second>>
+{
+    using type = std::conditional_t<Index == 0, First, Second>;
+};
+}
+
+namespace traits
+{
+template<typename First, typename Second>
+constexpr bool is_trivially_relocatable<utils::compressed_pair<First, Second>> =
+    is_trivially_relocatable<First> and is_trivially_relocatable<Second>;
+}
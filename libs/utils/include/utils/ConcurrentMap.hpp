@@ -0,0 +1,699 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <shared_mutex>
+#include <thread>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "hash/Hash.hpp"
+#include "traits/IsStringLike.hpp"
+#include "traits/IsTupleLike.hpp"
+#include "traits/TieFields.hpp"
+#include "utils/CompressedPair.hpp"
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+namespace utils
+{
+namespace detail
+{
+// Keys with a tie() member are hashed and compared through it, so a tuple of the same
+// values finds them without building a key.
+template<typename T>
+inline decltype(auto) lookupKey(const T& value)
+{
+    if constexpr(traits::has_tie_member<T>)
+    {
+        return value.tie();
+    }
+    else
+    {
+        return (value);
+    }
+}
+}
+
+// Transparent hasher for concurrent_map: tuple-likes and tie() go through hash::hash_tuple,
+// anything else through hash::hashValue, so a Person and std::tie(name, surname, age) or a
+// std::string and a std::string_view hash equally. Other queries, e.g. an int for a double
+// key, are turned into the key by concurrent_map first.
+struct TiedHash
+{
+    using is_transparent = void;
+
+    template<typename T>
+    std::size_t operator()(const T& value) const
+    {
+        const auto& key = detail::lookupKey(value);
+        if constexpr(traits::is_tuple_like<std::decay_t<decltype(key)>>)
+        {
+            return hash::hash_tuple(key);
+        }
+        else
+        {
+            return static_cast<std::size_t>(hash::hashValue(key));
+        }
+    }
+};
+
+struct TiedEqual
+{
+    using is_transparent = void;
+
+    template<typename T, typename U>
+    bool operator()(const T& lhs, const U& rhs) const
+    {
+        return detail::lookupKey(lhs) == detail::lookupKey(rhs);
+    }
+};
+
+namespace detail
+{
+template<typename T>
+using lookup_key_t = std::decay_t<decltype(lookupKey(std::declval<const std::decay_t<T>&>()))>;
+
+template<typename Key, typename Query>
+constexpr bool hashesAlike();
+
+template<typename Key, typename Query, std::size_t... Is>
+constexpr bool elementsHashAlike(std::index_sequence<Is...>)
+{
+    return (hashesAlike<std::tuple_element_t<Is, Key>, std::tuple_element_t<Is, Query>>() and ...);
+}
+
+// Whether TiedHash gives a Key and a Query equal to it the same hash. Integers go in as
+// they are widened to 64 bits, which keeps them equal only within one signedness, and 1
+// and 1.0 hash apart altogether.
+template<typename Key, typename Query>
+constexpr bool hashesAlike()
+{
+    using K = lookup_key_t<Key>;
+    using Q = lookup_key_t<Query>;
+    if constexpr(std::is_same_v<K, Q>)
+    {
+        return true;
+    }
+    else if constexpr(std::is_integral_v<K> and std::is_integral_v<Q>)
+    {
+        return std::is_signed_v<K> == std::is_signed_v<Q>;
+    }
+    else if constexpr(traits::is_string_like<K> and traits::is_string_like<Q>)
+    {
+        return true;
+    }
+    else if constexpr(traits::is_tuple_like<K> and traits::is_tuple_like<Q>)
+    {
+        if constexpr(std::tuple_size<K>::value == std::tuple_size<Q>::value)
+        {
+            return elementsHashAlike<K, Q>(std::make_index_sequence<std::tuple_size<K>::value>{});
+        }
+        else
+        {
+            return false;
+        }
+    }
+    else
+    {
+        return false;
+    }
+}
+}
+
+namespace detail
+{
+// Control byte of a swiss table slot: the 7 low hash bits when the slot is full,
+// otherwise one of these. Both have the sign bit set, full slots never do.
+constexpr std::int8_t emptyControl{-128};
+constexpr std::int8_t deletedControl{-2};
+constexpr std::size_t groupWidth{16};
+constexpr std::size_t cacheLineSize{64};
+
+// 16 control bytes compared at once, bit i of a mask stands for slot i of the group.
+class ControlGroup
+{
+public:
+    explicit ControlGroup(const std::int8_t* control)
+#if defined(__SSE2__)
+        : bytes_{_mm_loadu_si128(reinterpret_cast<const __m128i*>(control))}
+#else
+        : control_{control}
+#endif
+    {}
+
+    std::uint32_t match(std::int8_t h2) const
+    {
+#if defined(__SSE2__)
+        return static_cast<std::uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(bytes_, _mm_set1_epi8(h2))));
+#else
+        return matchIf([h2](std::int8_t control) { return control == h2; });
+#endif
+    }
+
+    std::uint32_t matchEmpty() const
+    {
+        return match(emptyControl);
+    }
+
+    // Empty or deleted, i.e. every control byte below -1.
+    std::uint32_t matchFree() const
+    {
+#if defined(__SSE2__)
+        return static_cast<std::uint32_t>(_mm_movemask_epi8(_mm_cmpgt_epi8(_mm_set1_epi8(-1), bytes_)));
+#else
+        return matchIf([](std::int8_t control) { return control < -1; });
+#endif
+    }
+
+private:
+#if defined(__SSE2__)
+    __m128i bytes_;
+#else
+    template<typename Predicate>
+    std::uint32_t matchIf(Predicate predicate) const
+    {
+        std::uint32_t mask{};
+        for(std::size_t slot = 0; slot < groupWidth; ++slot)
+        {
+            mask |= static_cast<std::uint32_t>(predicate(control_[slot])) << slot;
+        }
+        return mask;
+    }
+
+    const std::int8_t* control_;
+#endif
+};
+
+// Visits every group once when the group count is a power of two: 0, 1, 3, 6, ...
+class ProbeSequence
+{
+public:
+    ProbeSequence(std::size_t hash, std::size_t groupMask)
+        : group_{hash & groupMask}, groupMask_{groupMask}
+    {}
+
+    std::size_t offset() const { return group_ * groupWidth; }
+
+    void next()
+    {
+        group_ = (group_ + ++step_) & groupMask_;
+    }
+
+private:
+    std::size_t group_;
+    std::size_t groupMask_;
+    std::size_t step_{};
+};
+
+inline std::int8_t h2(std::size_t hash)
+{
+    return static_cast<std::int8_t>(hash & 0x7F);
+}
+
+inline std::size_t h1(std::size_t hash)
+{
+    return hash >> 7;
+}
+
+// Open addressing table with one control byte per slot, probed a group at a time.
+// Up to 7/8 of the slots hold keys or tombstones, which keeps an empty slot in reach
+// of every probe. Not thread safe, concurrent_map locks around it.
+template<typename Key, typename Value>
+class SwissTable
+{
+public:
+    using Slot = std::pair<Key, Value>;
+
+    SwissTable() = default;
+    SwissTable(const SwissTable&) = delete;
+    SwissTable& operator=(const SwissTable&) = delete;
+
+    ~SwissTable()
+    {
+        destroySlots();
+        deallocate(control_, slots_, capacity_);
+    }
+
+    std::size_t size() const { return size_; }
+    std::size_t capacity() const { return capacity_; }
+
+    template<typename Equal>
+    Slot* find(std::size_t hash, Equal equal) const
+    {
+        if(capacity_ == 0)
+        {
+            return nullptr;
+        }
+        for(ProbeSequence probe{h1(hash), capacity_ / groupWidth - 1};; probe.next())
+        {
+            const ControlGroup group{control_ + probe.offset()};
+            for(auto mask = group.match(h2(hash)); mask != 0; mask &= mask - 1)
+            {
+                auto* slot = slots_ + probe.offset() + static_cast<std::size_t>(__builtin_ctz(mask));
+                if(equal(slot->first))
+                {
+                    return slot;
+                }
+            }
+            if(group.matchEmpty() != 0)
+            {
+                return nullptr;
+            }
+        }
+    }
+
+    // The key must not be in the table yet, hashOf rehashes the keys when it grows.
+    template<typename HashOf, typename... Args>
+    Slot& emplace(std::size_t hash, const HashOf& hashOf, Args&&... args)
+    {
+        if(growthLeft_ == 0)
+        {
+            // Mostly tombstones: rebuild in place instead of doubling.
+            rehash(size_ < maxLoad(capacity_) / 2 ? capacity_ : std::max(2 * capacity_, groupWidth), hashOf);
+        }
+        const auto index = findFree(control_, capacity_, hash);
+        ::new(static_cast<void*>(slots_ + index)) Slot(std::forward<Args>(args)...);
+        // Counted once the slot is built, a throwing constructor leaves the table as it was.
+        if(control_[index] == emptyControl)
+        {
+            --growthLeft_;
+        }
+        else
+        {
+            --deleted_;
+        }
+        control_[index] = h2(hash);
+        ++size_;
+        return slots_[index];
+    }
+
+    void erase(Slot* slot)
+    {
+        slot->~Slot();
+        control_[static_cast<std::size_t>(slot - slots_)] = deletedControl;
+        --size_;
+        ++deleted_;
+    }
+
+    template<typename HashOf>
+    void reserve(std::size_t size, const HashOf& hashOf)
+    {
+        auto capacity = std::max(capacity_, groupWidth);
+        while(maxLoad(capacity) < size)
+        {
+            capacity *= 2;
+        }
+        if(capacity != capacity_)
+        {
+            rehash(capacity, hashOf);
+        }
+    }
+
+    void clear()
+    {
+        destroySlots();
+        std::fill(control_, control_ + capacity_, emptyControl);
+        size_ = 0;
+        deleted_ = 0;
+        growthLeft_ = maxLoad(capacity_);
+    }
+
+    template<typename Visitor>
+    void forEach(Visitor visitor) const
+    {
+        for(std::size_t index = 0; index < capacity_; ++index)
+        {
+            if(control_[index] >= 0)
+            {
+                visitor(slots_[index]);
+            }
+        }
+    }
+
+private:
+    static std::size_t maxLoad(std::size_t capacity) { return capacity - capacity / 8; }
+
+    static std::size_t findFree(const std::int8_t* control, std::size_t capacity, std::size_t hash)
+    {
+        for(ProbeSequence probe{h1(hash), capacity / groupWidth - 1};; probe.next())
+        {
+            if(const auto mask = ControlGroup{control + probe.offset()}.matchFree(); mask != 0)
+            {
+                return probe.offset() + static_cast<std::size_t>(__builtin_ctz(mask));
+            }
+        }
+    }
+
+    static void deallocate(std::int8_t* control, Slot* slots, std::size_t capacity)
+    {
+        if(capacity != 0)
+        {
+            std::allocator<std::int8_t>{}.deallocate(control, capacity);
+            std::allocator<Slot>{}.deallocate(slots, capacity);
+        }
+    }
+
+    void destroySlots()
+    {
+        if constexpr(not std::is_trivially_destructible_v<Slot>)
+        {
+            forEach([](Slot& slot) { slot.~Slot(); });
+        }
+    }
+
+    // Slots are copied unless their move can not throw, and the old ones are destroyed
+    // once all are in the new table, so a throw leaves the table as it was. The keys were
+    // hashed before, hashOf is not expected to throw for them now.
+    template<typename HashOf>
+    void rehash(std::size_t capacity, const HashOf& hashOf)
+    {
+        auto* control = std::allocator<std::int8_t>{}.allocate(capacity);
+        Slot* slots;
+        try
+        {
+            slots = std::allocator<Slot>{}.allocate(capacity);
+        }
+        catch(...)
+        {
+            std::allocator<std::int8_t>{}.deallocate(control, capacity);
+            throw;
+        }
+        std::fill(control, control + capacity, emptyControl);
+        try
+        {
+            forEach([&](Slot& slot) {
+                const auto hash = hashOf(slot.first);
+                const auto index = findFree(control, capacity, hash);
+                ::new(static_cast<void*>(slots + index)) Slot(std::move_if_noexcept(slot));
+                control[index] = h2(hash);
+            });
+        }
+        catch(...)
+        {
+            for(std::size_t index = 0; index < capacity; ++index)
+            {
+                if(control[index] >= 0)
+                {
+                    slots[index].~Slot();
+                }
+            }
+            deallocate(control, slots, capacity);
+            throw;
+        }
+        destroySlots();
+        deallocate(control_, slots_, capacity_);
+        control_ = control;
+        slots_ = slots;
+        capacity_ = capacity;
+        deleted_ = 0;
+        growthLeft_ = maxLoad(capacity) - size_;
+    }
+
+    std::int8_t* control_{};
+    Slot* slots_{};
+    std::size_t capacity_{};
+    std::size_t size_{};
+    std::size_t deleted_{};
+    std::size_t growthLeft_{};
+};
+
+template<typename, typename = void>
+constexpr bool is_transparent{};
+
+template<typename T>
+constexpr bool is_transparent<T, std::void_t<typename T::is_transparent>> = true;
+
+inline std::size_t defaultShardCount()
+{
+    return 4 * std::max(1u, std::thread::hardware_concurrency());
+}
+}
+
+// Hash map for many threads: keys are spread over shards by the top hash bits and each
+// shard is a swiss table behind its own reader-writer lock, so readers of a shard run
+// together and writers only wait for threads that picked the same shard. Lookups are
+// heterogeneous when Hash and KeyEqual are transparent, as the defaults are. Values are
+// handed out by copy or to a visitor under the lock, never by reference.
+template<typename Key, typename Value, typename Hash = TiedHash, typename KeyEqual = TiedEqual>
+class concurrent_map
+{
+    using Table = detail::SwissTable<Key, Value>;
+
+    struct alignas(detail::cacheLineSize) Shard
+    {
+        mutable std::shared_mutex mutex;
+        Table table;
+    };
+
+    static constexpr bool is_transparent = detail::is_transparent<Hash> and detail::is_transparent<KeyEqual>;
+
+public:
+    using key_type = Key;
+    using mapped_type = Value;
+    using value_type = std::pair<Key, Value>;
+    using size_type = std::size_t;
+    using hasher = Hash;
+    using key_equal = KeyEqual;
+
+    // The shard count is rounded up to a power of two.
+    explicit concurrent_map(size_type shards = detail::defaultShardCount(), const Hash& hash = Hash(),
+                            const KeyEqual& equal = KeyEqual())
+        : functions_{hash, equal}
+    {
+        while(shardCount_ < shards)
+        {
+            shardCount_ *= 2;
+        }
+        shardShift_ = static_cast<unsigned>(std::numeric_limits<size_type>::digits - __builtin_ctzll(shardCount_));
+        shards_ = std::make_unique<Shard[]>(shardCount_);
+    }
+
+    concurrent_map(const concurrent_map&) = delete;
+    concurrent_map& operator=(const concurrent_map&) = delete;
+
+    // Returns false and leaves the map as it was when key is already there.
+    template<typename... Args>
+    bool try_emplace(const Key& key, Args&&... args)
+    {
+        return emplaceUnique(key, std::forward<Args>(args)...);
+    }
+
+    template<typename... Args>
+    bool try_emplace(Key&& key, Args&&... args)
+    {
+        return emplaceUnique(std::move(key), std::forward<Args>(args)...);
+    }
+
+    bool insert(const value_type& value) { return try_emplace(value.first, value.second); }
+    bool insert(value_type&& value) { return try_emplace(std::move(value.first), std::move(value.second)); }
+
+    // Returns true when key was inserted, false when its value was replaced.
+    template<typename V>
+    bool insert_or_assign(const Key& key, V&& value)
+    {
+        return assign(key, std::forward<V>(value));
+    }
+
+    template<typename V>
+    bool insert_or_assign(Key&& key, V&& value)
+    {
+        return assign(std::move(key), std::forward<V>(value));
+    }
+
+    template<typename Query>
+    std::optional<Value> find(const Query& query) const
+    {
+        std::optional<Value> result;
+        visit(query, [&result](const Value& value) { result = value; });
+        return result;
+    }
+
+    template<typename Query>
+    bool contains(const Query& query) const
+    {
+        return visit(query, [](const Value&) {});
+    }
+
+    // Calls visitor(const Value&) under the shard's shared lock, false when query is missing.
+    template<typename Query, typename Visitor>
+    bool visit(const Query& query, Visitor visitor) const
+    {
+        const auto& key = lookupArgument(query);
+        const auto hash = hashOf(key);
+        const auto& shard = shardFor(hash);
+        std::shared_lock lock{shard.mutex};
+        if(const auto* slot = findIn(shard, hash, key))
+        {
+            visitor(std::as_const(slot->second));
+            return true;
+        }
+        return false;
+    }
+
+    // Calls visitor(Value&) under the shard's exclusive lock, false when query is missing.
+    template<typename Query, typename Visitor>
+    bool update(const Query& query, Visitor visitor)
+    {
+        const auto& key = lookupArgument(query);
+        const auto hash = hashOf(key);
+        auto& shard = shardFor(hash);
+        std::unique_lock lock{shard.mutex};
+        if(auto* slot = findIn(shard, hash, key))
+        {
+            visitor(slot->second);
+            return true;
+        }
+        return false;
+    }
+
+    template<typename Query>
+    size_type erase(const Query& query)
+    {
+        const auto& key = lookupArgument(query);
+        const auto hash = hashOf(key);
+        auto& shard = shardFor(hash);
+        std::unique_lock lock{shard.mutex};
+        if(auto* slot = findIn(shard, hash, key))
+        {
+            shard.table.erase(slot);
+            return 1;
+        }
+        return 0;
+    }
+
+    // Exact only while no other thread writes.
+    size_type size() const
+    {
+        size_type size{};
+        forEachShard([&size](const Shard& shard) { size += shard.table.size(); });
+        return size;
+    }
+
+    bool empty() const { return size() == 0; }
+
+    void clear()
+    {
+        for(size_type index = 0; index < shardCount_; ++index)
+        {
+            std::unique_lock lock{shards_[index].mutex};
+            shards_[index].table.clear();
+        }
+    }
+
+    // Assumes the keys spread evenly over the shards.
+    void reserve(size_type size)
+    {
+        const auto perShard = (size + shardCount_ - 1) / shardCount_;
+        for(size_type index = 0; index < shardCount_; ++index)
+        {
+            std::unique_lock lock{shards_[index].mutex};
+            shards_[index].table.reserve(perShard, [this](const Key& key) { return hashOf(key); });
+        }
+    }
+
+    // Copy of the contents, taken one shard at a time, so it is consistent per shard but
+    // not across shards while others write. printRange(map) prints one of these.
+    std::vector<value_type> snapshot() const
+    {
+        std::vector<value_type> values;
+        forEachShard([&values](const Shard& shard) {
+            shard.table.forEach([&values](const value_type& slot) { values.push_back(slot); });
+        });
+        return values;
+    }
+
+    size_type shard_count() const { return shardCount_; }
+    hasher hash_function() const { return functions_.first(); }
+    key_equal key_eq() const { return functions_.second(); }
+
+private:
+    // Without transparent functions a query is turned into a Key first, like in std containers.
+    // So is one the default TiedHash would hash apart from an equal key, e.g. 1 for 1.0.
+    template<typename Query>
+    decltype(auto) lookupArgument(const Query& query) const
+    {
+        constexpr bool tied = std::is_same_v<Hash, TiedHash> and std::is_same_v<KeyEqual, TiedEqual>;
+        if constexpr(std::is_same_v<Query, Key> or (is_transparent and (not tied or detail::hashesAlike<Key, Query>())))
+        {
+            return (query);
+        }
+        else
+        {
+            return Key(query);
+        }
+    }
+
+    template<typename K>
+    size_type hashOf(const K& key) const
+    {
+        return functions_.first()(key);
+    }
+
+    Shard& shardFor(size_type hash) const
+    {
+        return shards_[shardCount_ == 1 ? 0 : hash >> shardShift_];
+    }
+
+    template<typename K>
+    typename Table::Slot* findIn(const Shard& shard, size_type hash, const K& key) const
+    {
+        return shard.table.find(hash, [this, &key](const Key& stored) { return functions_.second()(stored, key); });
+    }
+
+    template<typename Visitor>
+    void forEachShard(Visitor visitor) const
+    {
+        for(size_type index = 0; index < shardCount_; ++index)
+        {
+            std::shared_lock lock{shards_[index].mutex};
+            visitor(shards_[index]);
+        }
+    }
+
+    template<typename K, typename... Args>
+    bool emplaceUnique(K&& key, Args&&... args)
+    {
+        const auto hash = hashOf(key);
+        auto& shard = shardFor(hash);
+        std::unique_lock lock{shard.mutex};
+        if(findIn(shard, hash, key) != nullptr)
+        {
+            return false;
+        }
+        shard.table.emplace(hash, [this](const Key& stored) { return hashOf(stored); }, std::piecewise_construct,
+                            std::forward_as_tuple(std::forward<K>(key)),
+                            std::forward_as_tuple(std::forward<Args>(args)...));
+        return true;
+    }
+
+    template<typename K, typename V>
+    bool assign(K&& key, V&& value)
+    {
+        const auto hash = hashOf(key);
+        auto& shard = shardFor(hash);
+        std::unique_lock lock{shard.mutex};
+        if(auto* slot = findIn(shard, hash, key))
+        {
+            slot->second = std::forward<V>(value);
+            return false;
+        }
+        shard.table.emplace(hash, [this](const Key& stored) { return hashOf(stored); }, std::forward<K>(key),
+                            std::forward<V>(value));
+        return true;
+    }
+
+    compressed_pair<Hash, KeyEqual> functions_;
+    size_type shardCount_{1};
+    unsigned shardShift_{};
+    std::unique_ptr<Shard[]> shards_;
+};
+}
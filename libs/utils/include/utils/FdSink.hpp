@@ -0,0 +1,389 @@
+#pragma once
+
+#include <algorithm>
+#include <cerrno>
+#include <climits>
+#include <cstddef>
+#include <cstring>
+#include <iterator>
+#include <memory>
+#include <sstream>
+#include <string_view>
+#include <system_error>
+#include <type_traits>
+#include <utility>
+#include "utils/IntegerFormatting.hpp"
+#include "utils/RangeFormatter.hpp"
+#include "utils/RangePrinter.hpp"
+
+#include <sys/uio.h>
+#include <unistd.h>
+
+#if defined(UTILS_HAS_IO_URING)
+#include <liburing.h>
+#endif
+
+namespace utils
+{
+enum class FdBackend
+{
+    Writev,
+    Uring // available when built with UTILS_HAS_IO_URING, otherwise falls back to Writev
+};
+
+inline bool isFdBackendSupported(FdBackend backend)
+{
+#if defined(UTILS_HAS_IO_URING)
+    return true;
+#else
+    return backend == FdBackend::Writev;
+#endif
+}
+
+namespace detail
+{
+// Drops written bytes from the front of an iovec batch after a short write.
+inline void advanceIovecs(iovec*& first, int& count, std::size_t written)
+{
+    while(count != 0 and written >= first->iov_len)
+    {
+        written -= first->iov_len;
+        ++first;
+        --count;
+    }
+    if(count != 0)
+    {
+        first->iov_base = static_cast<char*>(first->iov_base) + written;
+        first->iov_len -= written;
+    }
+}
+
+template<typename Iterator, typename = void>
+constexpr bool has_stable_elements{};
+
+// Elements stay where they are while the iterator moves on, so the sink may point at them
+// until the flush at the end of the range. Not so for a generator or an istream_iterator,
+// whose ++ replaces the element it referred to.
+template<typename Iterator>
+constexpr bool has_stable_elements<Iterator, std::void_t<typename std::iterator_traits<Iterator>::iterator_category>> =
+    std::is_base_of_v<std::forward_iterator_tag, typename std::iterator_traits<Iterator>::iterator_category> and
+    std::is_lvalue_reference_v<typename std::iterator_traits<Iterator>::reference>;
+}
+
+// Writer for a file descriptor that gathers output into iovec batches and hands them
+// to the kernel with a single writev. Formatted text goes to an internal scratch
+// buffer, long strings are pointed at instead of copied and have to stay alive
+// until the next flush(); operator<< flushes before returning whenever it borrowed and
+// copies the strings of single pass ranges, which are gone by then.
+// Errors are reported as std::system_error. The scratch buffer is on the heap, the iovec
+// batch (16 KB with the default IOV_MAX) is held inline.
+class FdSink
+{
+public:
+    static constexpr std::size_t scratchSize{1 << 16};
+    static constexpr std::size_t borrowThreshold{128};
+
+    explicit FdSink(int fd, FdBackend backend = FdBackend::Writev)
+        : fd_{fd}
+    {
+#if defined(UTILS_HAS_IO_URING)
+        if(backend == FdBackend::Uring)
+        {
+            if(const int error = ::io_uring_queue_init(4, &ring_, 0); error < 0)
+            {
+                throw std::system_error{-error, std::generic_category(), "io_uring_queue_init"};
+            }
+            uring_ = true;
+        }
+#else
+        static_cast<void>(backend);
+#endif
+    }
+
+    FdSink(const FdSink&) = delete;
+    FdSink& operator=(const FdSink&) = delete;
+
+    // Flushes what is left, errors at this point are lost.
+    ~FdSink()
+    {
+        try
+        {
+            flush();
+        }
+        catch(const std::system_error&)
+        {
+        }
+#if defined(UTILS_HAS_IO_URING)
+        if(uring_)
+        {
+            ::io_uring_queue_exit(&ring_);
+        }
+#endif
+    }
+
+    void put(char c)
+    {
+        reserve(1);
+        scratch_[used_] = c;
+        append(scratch_.get() + used_, 1);
+        ++used_;
+    }
+
+    void write(std::string_view text)
+    {
+        if(borrowing_ and text.size() >= borrowThreshold)
+        {
+            return borrow(text);
+        }
+        while(not text.empty())
+        {
+            reserve(std::min(text.size(), scratchSize));
+            const auto size = std::min(text.size(), scratchSize - used_);
+            std::memcpy(scratch_.get() + used_, text.data(), size);
+            append(scratch_.get() + used_, size);
+            used_ += size;
+            text.remove_prefix(size);
+        }
+    }
+
+    // With borrowing off write() copies long strings too, for text that is gone before the
+    // next flush(). Returns the previous setting.
+    bool setBorrowing(bool enabled)
+    {
+        return std::exchange(borrowing_, enabled);
+    }
+
+    // Queues text without copying it, text has to outlive the next flush().
+    void borrow(std::string_view text)
+    {
+        if(text.empty())
+        {
+            return;
+        }
+        if(count_ == maxIovecs)
+        {
+            flush();
+        }
+        iovecs_[count_++] = {const_cast<char*>(text.data()), text.size()};
+        ++borrowed_;
+    }
+
+    template<typename T>
+    void writeArithmetic(T value)
+    {
+        reserve(maxArithmeticSize);
+        auto first = scratch_.get() + used_;
+        auto last = detail::toChars(first, scratch_.get() + scratchSize, value).ptr;
+        append(first, static_cast<std::size_t>(last - first));
+        used_ += static_cast<std::size_t>(last - first);
+    }
+
+    // Formats straight into the scratch buffer, flushing whenever it runs full.
+    template<typename T>
+    void writeIntegers(const T* first, const T* last, std::string_view delimiter)
+    {
+        const auto perElement = maxFormattedIntegerSize<T> + delimiter.size();
+        reserve(perElement + formatIntegersPadding);
+        while(first != last)
+        {
+            const auto count = std::min(static_cast<std::size_t>(last - first),
+                                        (scratchSize - used_ - formatIntegersPadding) / perElement);
+            const auto begin = scratch_.get() + used_;
+            const auto end = formatIntegers(first, first + count, delimiter, begin);
+            append(begin, static_cast<std::size_t>(end - begin));
+            used_ += static_cast<std::size_t>(end - begin);
+            if((first += count) != last)
+            {
+                write(delimiter);
+                reserve(perElement + formatIntegersPadding);
+            }
+        }
+    }
+
+    bool hasBorrowed() const { return borrowed_ != 0; }
+
+    // Hands every queued piece to the kernel, retrying short writes.
+    void flush()
+    {
+        auto* first = iovecs_;
+        auto count = static_cast<int>(count_);
+        while(count != 0)
+        {
+            detail::advanceIovecs(first, count, submit(first, count));
+        }
+        count_ = 0;
+        used_ = 0;
+        borrowed_ = 0;
+    }
+
+private:
+    static constexpr std::size_t maxIovecs{IOV_MAX < 1024 ? IOV_MAX : 1024};
+    static constexpr std::size_t maxArithmeticSize{32};
+
+    void reserve(std::size_t size)
+    {
+        if(scratchSize - used_ < size or count_ == maxIovecs)
+        {
+            flush();
+        }
+    }
+
+    // Text written right after the previous scratch piece extends its iovec.
+    void append(char* text, std::size_t size)
+    {
+        if(count_ != 0 and static_cast<char*>(iovecs_[count_ - 1].iov_base) + iovecs_[count_ - 1].iov_len == text)
+        {
+            iovecs_[count_ - 1].iov_len += size;
+        }
+        else
+        {
+            iovecs_[count_++] = {text, size};
+        }
+    }
+
+    std::size_t submit(const iovec* first, int count)
+    {
+#if defined(UTILS_HAS_IO_URING)
+        if(uring_)
+        {
+            auto* entry = ::io_uring_get_sqe(&ring_);
+            ::io_uring_prep_writev(entry, fd_, first, static_cast<unsigned>(count), -1);
+            ::io_uring_submit(&ring_);
+            io_uring_cqe* completion{};
+            if(const int error = ::io_uring_wait_cqe(&ring_, &completion); error < 0)
+            {
+                throw std::system_error{-error, std::generic_category(), "io_uring_wait_cqe"};
+            }
+            const int result = completion->res;
+            ::io_uring_cqe_seen(&ring_, completion);
+            if(result < 0)
+            {
+                throw std::system_error{-result, std::generic_category(), "io_uring writev"};
+            }
+            if(result == 0)
+            {
+                throw std::system_error{EIO, std::generic_category(), "io_uring writev wrote nothing"};
+            }
+            return static_cast<std::size_t>(result);
+        }
+#endif
+        for(;;)
+        {
+            // Nothing written for a non-empty batch would make flush() spin forever.
+            const auto result = ::writev(fd_, first, count);
+            if(result > 0)
+            {
+                return static_cast<std::size_t>(result);
+            }
+            if(result == 0)
+            {
+                throw std::system_error{EIO, std::generic_category(), "writev wrote nothing"};
+            }
+            if(errno != EINTR)
+            {
+                throw std::system_error{errno, std::generic_category(), "writev"};
+            }
+        }
+    }
+
+    int fd_;
+    std::size_t used_{};
+    std::size_t count_{};
+    std::size_t borrowed_{};
+    bool borrowing_{true};
+    iovec iovecs_[maxIovecs];
+    std::unique_ptr<char[]> scratch_{new char[scratchSize]};
+#if defined(UTILS_HAS_IO_URING)
+    io_uring ring_{};
+    bool uring_{};
+#endif
+};
+
+namespace detail
+{
+// Printers writeValue() can not handle, e.g. of elements with just an operator<<, go
+// through the std::ostream path, like formatLogValue() does. The text is copied.
+template<typename Printer>
+inline FdSink& writeStreamed(FdSink& sink, const Printer& printer)
+{
+    std::ostringstream stream;
+    stream << printer;
+    const bool borrowing = sink.setBorrowing(false);
+    sink.write(stream.str());
+    sink.setBorrowing(borrowing);
+    return sink;
+}
+}
+
+// Same text as streaming the printer into a std::ostream.
+template<typename Iterator, typename Style, typename Sentinel>
+inline FdSink& operator<<(FdSink& sink, const RangePrinter<Iterator, Style, Sentinel>& printer)
+{
+    using Element = std::remove_cv_t<std::remove_reference_t<decltype(*printer.begin())>>;
+    if constexpr(detail::is_writer_formattable<Element>)
+    {
+        const bool borrowing = sink.setBorrowing(detail::has_stable_elements<Iterator>);
+        writeRange<Style>(sink, printer.begin(), printer.end(), printer.delimiter());
+        sink.setBorrowing(borrowing);
+        if(sink.hasBorrowed())
+        {
+            sink.flush();
+        }
+        return sink;
+    }
+    else
+    {
+        return detail::writeStreamed(sink, printer);
+    }
+}
+
+template<typename Snapshot, typename Style>
+inline FdSink& operator<<(FdSink& sink, const SnapshotPrinter<Snapshot, Style>& printer)
+{
+    const auto& range = printer.snapshot;
+    return sink << RangePrinter<decltype(detail::rangeBegin(range)), Style>{
+                       detail::rangeBegin(range), detail::rangeEnd(range), printer.delimiter};
+}
+
+// The limits are applied by the std::ostream path.
+template<typename Range, typename Style>
+inline FdSink& operator<<(FdSink& sink, const BoundedRangePrinter<Range, Style>& printer)
+{
+    return detail::writeStreamed(sink, printer);
+}
+
+inline FdSink& operator<<(FdSink& sink, std::string_view text)
+{
+    sink.write(text);
+    if(sink.hasBorrowed())
+    {
+        sink.flush();
+    }
+    return sink;
+}
+
+// Anything writeValue() knows: arithmetic values, strings, pairs and nested ranges.
+template<typename T, typename std::enable_if_t<not std::is_array_v<T>, int> = 0>
+inline auto operator<<(FdSink& sink, const T& value) -> decltype(writeValue(sink, makeValuePrinter(value)), sink)
+{
+    if constexpr(not detail::is_writer_formattable<T>)
+    {
+        return detail::writeStreamed(sink, makeValuePrinter(value));
+    }
+    else if constexpr(traits::is_iterable<T> and not traits::is_string_like<T>)
+    {
+        const bool borrowing = sink.setBorrowing(detail::has_stable_elements<decltype(detail::rangeBegin(value))>);
+        writeValue(sink, makeValuePrinter(value));
+        sink.setBorrowing(borrowing);
+    }
+    else
+    {
+        writeValue(sink, makeValuePrinter(value));
+    }
+    if(sink.hasBorrowed())
+    {
+        sink.flush();
+    }
+    return sink;
+}
+}
@@ -0,0 +1,517 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <initializer_list>
+#include <iterator>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "utils/CompressedPair.hpp"
+#include "utils/FlatSet.hpp"
+#include "utils/Vector.hpp"
+
+namespace utils
+{
+namespace detail
+{
+// Random access iterator over the key and value arrays of a flat_map, dereferencing
+// gives a pair of references. Keys are always reached through a const iterator.
+template<typename KeyIterator, typename ValueIterator>
+class FlatMapIterator
+{
+    using KeyTraits = std::iterator_traits<KeyIterator>;
+    using ValueTraits = std::iterator_traits<ValueIterator>;
+
+public:
+    using iterator_category = std::random_access_iterator_tag;
+    using value_type = std::pair<typename KeyTraits::value_type, typename ValueTraits::value_type>;
+    using difference_type = std::ptrdiff_t;
+    using reference = std::pair<typename KeyTraits::reference, typename ValueTraits::reference>;
+
+    // The pair of references is made on the fly, it->second points into a copy of it.
+    class ArrowProxy
+    {
+    public:
+        const reference* operator->() const { return &pair_; }
+
+    private:
+        friend FlatMapIterator;
+        explicit ArrowProxy(reference pair)
+            : pair_{pair}
+        {}
+
+        reference pair_;
+    };
+
+    using pointer = ArrowProxy;
+
+    FlatMapIterator() = default;
+    FlatMapIterator(KeyIterator key, ValueIterator value)
+        : key_{key}, value_{value}
+    {}
+
+    // iterator converts to const_iterator.
+    template<typename OtherValueIterator,
+             typename = std::enable_if_t<std::is_convertible_v<OtherValueIterator, ValueIterator>>>
+    FlatMapIterator(const FlatMapIterator<KeyIterator, OtherValueIterator>& other)
+        : key_{other.key()}, value_{other.value()}
+    {}
+
+    KeyIterator key() const { return key_; }
+    ValueIterator value() const { return value_; }
+
+    reference operator*() const { return {*key_, *value_}; }
+    pointer operator->() const { return pointer{**this}; }
+    reference operator[](difference_type offset) const { return {key_[offset], value_[offset]}; }
+
+    FlatMapIterator& operator++()
+    {
+        ++key_;
+        ++value_;
+        return *this;
+    }
+
+    FlatMapIterator operator++(int)
+    {
+        auto copy = *this;
+        ++*this;
+        return copy;
+    }
+
+    FlatMapIterator& operator--()
+    {
+        --key_;
+        --value_;
+        return *this;
+    }
+
+    FlatMapIterator operator--(int)
+    {
+        auto copy = *this;
+        --*this;
+        return copy;
+    }
+
+    FlatMapIterator& operator+=(difference_type offset)
+    {
+        key_ += offset;
+        value_ += offset;
+        return *this;
+    }
+
+    FlatMapIterator& operator-=(difference_type offset) { return *this += -offset; }
+
+    friend FlatMapIterator operator+(FlatMapIterator it, difference_type offset) { return it += offset; }
+    friend FlatMapIterator operator+(difference_type offset, FlatMapIterator it) { return it += offset; }
+    friend FlatMapIterator operator-(FlatMapIterator it, difference_type offset) { return it -= offset; }
+
+    friend difference_type operator-(const FlatMapIterator& lhs, const FlatMapIterator& rhs)
+    {
+        return lhs.key_ - rhs.key_;
+    }
+
+    friend bool operator==(const FlatMapIterator& lhs, const FlatMapIterator& rhs) { return lhs.key_ == rhs.key_; }
+    friend bool operator!=(const FlatMapIterator& lhs, const FlatMapIterator& rhs) { return lhs.key_ != rhs.key_; }
+    friend bool operator<(const FlatMapIterator& lhs, const FlatMapIterator& rhs) { return lhs.key_ < rhs.key_; }
+    friend bool operator>(const FlatMapIterator& lhs, const FlatMapIterator& rhs) { return lhs.key_ > rhs.key_; }
+    friend bool operator<=(const FlatMapIterator& lhs, const FlatMapIterator& rhs) { return lhs.key_ <= rhs.key_; }
+    friend bool operator>=(const FlatMapIterator& lhs, const FlatMapIterator& rhs) { return lhs.key_ >= rhs.key_; }
+
+private:
+    KeyIterator key_{};
+    ValueIterator value_{};
+};
+
+struct PairKey
+{
+    template<typename Pair>
+    constexpr const auto& operator()(const Pair& pair) const
+    {
+        return pair.first;
+    }
+};
+
+template<typename Iterator>
+using iterator_key_t = std::remove_const_t<typename std::iterator_traits<Iterator>::value_type::first_type>;
+
+template<typename Iterator>
+using iterator_mapped_t = typename std::iterator_traits<Iterator>::value_type::second_type;
+}
+
+// Sorted map kept in two contiguous containers, one for the keys and one for the values,
+// so a lookup binary searches keys only and keys()/values() are plain arrays for scans
+// and for the printRange() fast paths. Iterators are random access and yield
+// std::pair<const Key&, Value&>. Like flat_set, inserting a range merges it in place.
+template<typename Key, typename Value, typename Compare = std::less<Key>,
+         typename KeyContainer = utils::vector<Key>, typename MappedContainer = utils::vector<Value>>
+class flat_map
+{
+public:
+    using key_type = Key;
+    using mapped_type = Value;
+    using value_type = std::pair<Key, Value>;
+    using key_compare = Compare;
+    using key_container_type = KeyContainer;
+    using mapped_container_type = MappedContainer;
+    using size_type = std::size_t;
+    using difference_type = std::ptrdiff_t;
+    using iterator = detail::FlatMapIterator<typename KeyContainer::const_iterator, typename MappedContainer::iterator>;
+    using const_iterator =
+        detail::FlatMapIterator<typename KeyContainer::const_iterator, typename MappedContainer::const_iterator>;
+    using reference = typename iterator::reference;
+    using const_reference = typename const_iterator::reference;
+
+    flat_map() = default;
+
+    // keys and values pair up by index, containers of different sizes are rejected with
+    // std::invalid_argument.
+    flat_map(KeyContainer keys, MappedContainer values, const Compare& compare = Compare())
+        : keys_{KeyContainer{}, compare}
+    {
+        checkSizes(keys, values);
+        std::vector<value_type> pairs;
+        pairs.reserve(keys.size());
+        for(size_type index = 0; index < keys.size(); ++index)
+        {
+            pairs.emplace_back(std::move(keys[index]), std::move(values[index]));
+        }
+        assignSorted(pairs);
+    }
+
+    flat_map(sorted_unique_t, KeyContainer keys, MappedContainer values, const Compare& compare = Compare())
+        : keys_{std::move(keys), compare}, values_{std::move(values)}
+    {
+        checkSizes(this->keys(), values_);
+    }
+
+    template<typename Iterator, typename = typename std::iterator_traits<Iterator>::iterator_category>
+    flat_map(Iterator first, Iterator last, const Compare& compare = Compare())
+        : keys_{KeyContainer{}, compare}
+    {
+        std::vector<value_type> pairs(first, last);
+        assignSorted(pairs);
+    }
+
+    template<typename Iterator, typename = typename std::iterator_traits<Iterator>::iterator_category>
+    flat_map(sorted_unique_t, Iterator first, Iterator last, const Compare& compare = Compare())
+        : keys_{KeyContainer{}, compare}
+    {
+        for(; first != last; ++first)
+        {
+            storedKeys().push_back(first->first);
+            values_.push_back(first->second);
+        }
+    }
+
+    flat_map(std::initializer_list<value_type> pairs, const Compare& compare = Compare())
+        : flat_map(pairs.begin(), pairs.end(), compare)
+    {}
+
+    flat_map(sorted_unique_t, std::initializer_list<value_type> pairs, const Compare& compare = Compare())
+        : flat_map(sorted_unique, pairs.begin(), pairs.end(), compare)
+    {}
+
+    iterator begin() { return {keys().cbegin(), values_.begin()}; }
+    iterator end() { return {keys().cend(), values_.end()}; }
+    const_iterator begin() const { return {keys().cbegin(), values_.cbegin()}; }
+    const_iterator end() const { return {keys().cend(), values_.cend()}; }
+    const_iterator cbegin() const { return begin(); }
+    const_iterator cend() const { return end(); }
+
+    size_type size() const { return keys().size(); }
+    bool empty() const { return keys().empty(); }
+    key_compare key_comp() const { return compare(); }
+
+    const KeyContainer& keys() const { return keys_.first(); }
+    const MappedContainer& values() const { return values_; }
+
+    void reserve(size_type capacity)
+    {
+        storedKeys().reserve(capacity);
+        values_.reserve(capacity);
+    }
+
+    void clear()
+    {
+        storedKeys().clear();
+        values_.clear();
+    }
+
+    iterator lower_bound(const Key& key) { return begin() + lowerBoundIndex(key); }
+    const_iterator lower_bound(const Key& key) const { return begin() + lowerBoundIndex(key); }
+
+    iterator upper_bound(const Key& key)
+    {
+        return begin() + (detail::branchlessUpperBound(keys().begin(), keys().end(), key, compare()) - keys().begin());
+    }
+
+    const_iterator upper_bound(const Key& key) const
+    {
+        return begin() + (detail::branchlessUpperBound(keys().begin(), keys().end(), key, compare()) - keys().begin());
+    }
+
+    iterator find(const Key& key) { return begin() + findIndex(key); }
+    const_iterator find(const Key& key) const { return begin() + findIndex(key); }
+
+    bool contains(const Key& key) const { return findIndex(key) != static_cast<difference_type>(size()); }
+    size_type count(const Key& key) const { return contains(key) ? 1 : 0; }
+
+    Value& at(const Key& key)
+    {
+        return values_[checkedIndex(key)];
+    }
+
+    const Value& at(const Key& key) const
+    {
+        return values_[checkedIndex(key)];
+    }
+
+    Value& operator[](const Key& key) { return (*try_emplace(key).first).second; }
+    Value& operator[](Key&& key) { return (*try_emplace(std::move(key)).first).second; }
+
+    // Leaves the map as it was when key is already there.
+    template<typename... Args>
+    std::pair<iterator, bool> try_emplace(const Key& key, Args&&... args)
+    {
+        return emplaceUnique(key, std::forward<Args>(args)...);
+    }
+
+    template<typename... Args>
+    std::pair<iterator, bool> try_emplace(Key&& key, Args&&... args)
+    {
+        return emplaceUnique(std::move(key), std::forward<Args>(args)...);
+    }
+
+    std::pair<iterator, bool> insert(const value_type& pair) { return try_emplace(pair.first, pair.second); }
+    std::pair<iterator, bool> insert(value_type&& pair) { return try_emplace(std::move(pair.first), std::move(pair.second)); }
+
+    template<typename V>
+    std::pair<iterator, bool> insert_or_assign(const Key& key, V&& value)
+    {
+        auto result = try_emplace(key, std::forward<V>(value));
+        if(not result.second)
+        {
+            (*result.first).second = std::forward<V>(value);
+        }
+        return result;
+    }
+
+    template<typename Iterator, typename = typename std::iterator_traits<Iterator>::iterator_category>
+    void insert(Iterator first, Iterator last)
+    {
+        std::vector<value_type> batch(first, last);
+        detail::sortUnique(batch, detail::PairKey{}, compare());
+        merge(batch);
+    }
+
+    template<typename Iterator, typename = typename std::iterator_traits<Iterator>::iterator_category>
+    void insert(sorted_unique_t, Iterator first, Iterator last)
+    {
+        std::vector<value_type> batch(first, last);
+        merge(batch);
+    }
+
+    void insert(std::initializer_list<value_type> pairs) { insert(pairs.begin(), pairs.end()); }
+
+    iterator erase(const_iterator position)
+    {
+        const auto index = position - cbegin();
+        eraseAt(storedKeys(), index);
+        eraseAt(values_, index);
+        return begin() + index;
+    }
+
+    size_type erase(const Key& key)
+    {
+        const auto index = findIndex(key);
+        if(index == static_cast<difference_type>(size()))
+        {
+            return 0;
+        }
+        erase(cbegin() + index);
+        return 1;
+    }
+
+    friend bool operator==(const flat_map& lhs, const flat_map& rhs)
+    {
+        return std::equal(lhs.keys().begin(), lhs.keys().end(), rhs.keys().begin(), rhs.keys().end()) and
+               std::equal(lhs.values_.begin(), lhs.values_.end(), rhs.values_.begin(), rhs.values_.end());
+    }
+
+    friend bool operator!=(const flat_map& lhs, const flat_map& rhs)
+    {
+        return not(lhs == rhs);
+    }
+
+private:
+    KeyContainer& storedKeys() { return keys_.first(); }
+    const Compare& compare() const { return keys_.second(); }
+
+    difference_type lowerBoundIndex(const Key& key) const
+    {
+        return detail::branchlessLowerBound(keys().begin(), keys().end(), key, compare()) - keys().begin();
+    }
+
+    // size() when key is missing.
+    difference_type findIndex(const Key& key) const
+    {
+        const auto index = lowerBoundIndex(key);
+        const auto found = index != static_cast<difference_type>(size()) and
+                           not compare()(key, keys()[static_cast<size_type>(index)]);
+        return found ? index : static_cast<difference_type>(size());
+    }
+
+    size_type checkedIndex(const Key& key) const
+    {
+        const auto index = findIndex(key);
+        if(index == static_cast<difference_type>(size()))
+        {
+            throw std::out_of_range{"flat_map::at"};
+        }
+        return static_cast<size_type>(index);
+    }
+
+    template<typename Container>
+    static void eraseAt(Container& container, difference_type index)
+    {
+        std::move(container.begin() + index + 1, container.end(), container.begin() + index);
+        container.pop_back();
+    }
+
+    template<typename Container>
+    static void rotateBack(Container& container, difference_type index)
+    {
+        std::rotate(container.begin() + index, container.end() - 1, container.end());
+    }
+
+    template<typename K, typename... Args>
+    std::pair<iterator, bool> emplaceUnique(K&& key, Args&&... args)
+    {
+        const auto index = lowerBoundIndex(key);
+        if(index != static_cast<difference_type>(size()) and not compare()(key, keys()[static_cast<size_type>(index)]))
+        {
+            return {begin() + index, false};
+        }
+        storedKeys().push_back(std::forward<K>(key));
+        try
+        {
+            values_.emplace_back(std::forward<Args>(args)...);
+        }
+        catch(...)
+        {
+            storedKeys().pop_back();
+            throw;
+        }
+        rotateBack(storedKeys(), index);
+        rotateBack(values_, index);
+        return {begin() + index, true};
+    }
+
+    static void checkSizes(const KeyContainer& keys, const MappedContainer& values)
+    {
+        if(keys.size() != values.size())
+        {
+            throw std::invalid_argument{"flat_map: keys and values differ in size"};
+        }
+    }
+
+    void assignSorted(std::vector<value_type>& pairs)
+    {
+        detail::sortUnique(pairs, detail::PairKey{}, compare());
+        reserve(pairs.size());
+        for(auto& pair : pairs)
+        {
+            storedKeys().push_back(std::move(pair.first));
+            values_.push_back(std::move(pair.second));
+        }
+    }
+
+    // Keys already stored keep their values, the rest goes in with one merge.
+    void merge(std::vector<value_type>& batch)
+    {
+        batch.erase(std::remove_if(batch.begin(), batch.end(),
+                                   [this](const value_type& pair) { return contains(pair.first); }),
+                    batch.end());
+        const auto count = size();
+        // Moving backward in place leaves the map half merged if a move throws, so only
+        // types whose move assignment can not throw take that path.
+        if constexpr(std::is_default_constructible_v<Key> and std::is_default_constructible_v<Value> and
+                     std::is_nothrow_move_assignable_v<Key> and std::is_nothrow_move_assignable_v<Value>)
+        {
+            storedKeys().resize(count + batch.size());
+            try
+            {
+                values_.resize(count + batch.size());
+            }
+            catch(...)
+            {
+                storedKeys().resize(count);
+                throw;
+            }
+            detail::mergeBackward(
+                count, batch.size(),
+                [&](size_type old, size_type added) { return compare()(batch[added].first, keys()[old]); },
+                [&](size_type from, size_type to) {
+                    storedKeys()[to] = std::move(storedKeys()[from]);
+                    values_[to] = std::move(values_[from]);
+                },
+                [&](size_type from, size_type to) {
+                    storedKeys()[to] = std::move(batch[from].first);
+                    values_[to] = std::move(batch[from].second);
+                });
+        }
+        else
+        {
+            KeyContainer mergedKeys;
+            MappedContainer mergedValues;
+            mergedKeys.reserve(count + batch.size());
+            mergedValues.reserve(count + batch.size());
+            detail::mergeUnique(keys(), batch, detail::PairKey{}, compare(), [&](bool fromStored, size_type index) {
+                mergedKeys.push_back(fromStored ? std::move(storedKeys()[index]) : std::move(batch[index].first));
+                mergedValues.push_back(fromStored ? std::move(values_[index]) : std::move(batch[index].second));
+            });
+            storedKeys() = std::move(mergedKeys);
+            values_ = std::move(mergedValues);
+        }
+    }
+
+    // An empty Compare takes no space.
+    compressed_pair<KeyContainer, Compare> keys_{};
+    MappedContainer values_{};
+};
+
+template<typename KeyContainer, typename MappedContainer,
+         typename Compare = std::less<typename KeyContainer::value_type>,
+         typename = typename KeyContainer::const_iterator, typename = typename MappedContainer::const_iterator>
+flat_map(KeyContainer, MappedContainer, Compare = Compare())
+    -> flat_map<typename KeyContainer::value_type, typename MappedContainer::value_type, Compare, KeyContainer,
+                MappedContainer>;
+
+template<typename KeyContainer, typename MappedContainer,
+         typename Compare = std::less<typename KeyContainer::value_type>,
+         typename = typename KeyContainer::const_iterator, typename = typename MappedContainer::const_iterator>
+flat_map(sorted_unique_t, KeyContainer, MappedContainer, Compare = Compare())
+    -> flat_map<typename KeyContainer::value_type, typename MappedContainer::value_type, Compare, KeyContainer,
+                MappedContainer>;
+
+template<typename Iterator, typename Compare = std::less<detail::iterator_key_t<Iterator>>,
+         typename = typename std::iterator_traits<Iterator>::iterator_category>
+flat_map(Iterator, Iterator, Compare = Compare())
+    -> flat_map<detail::iterator_key_t<Iterator>, detail::iterator_mapped_t<Iterator>, Compare>;
+
+template<typename Iterator, typename Compare = std::less<detail::iterator_key_t<Iterator>>,
+         typename = typename std::iterator_traits<Iterator>::iterator_category>
+flat_map(sorted_unique_t, Iterator, Iterator, Compare = Compare())
+    -> flat_map<detail::iterator_key_t<Iterator>, detail::iterator_mapped_t<Iterator>, Compare>;
+
+// flat_map{std::pair{"THX"s, 1011}, std::pair{"THZ"s, 1012}}, braced pairs can not be deduced.
+template<typename Key, typename Value, typename Compare = std::less<Key>>
+flat_map(std::initializer_list<std::pair<Key, Value>>, Compare = Compare()) -> flat_map<Key, Value, Compare>;
+
+template<typename Key, typename Value, typename Compare = std::less<Key>>
+flat_map(sorted_unique_t, std::initializer_list<std::pair<Key, Value>>, Compare = Compare())
+    -> flat_map<Key, Value, Compare>;
+}
@@ -0,0 +1,346 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <initializer_list>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "utils/CompressedPair.hpp"
+#include "utils/Vector.hpp"
+
+namespace utils
+{
+// Tells flat_set and flat_map that the input is already sorted and free of duplicates.
+struct sorted_unique_t
+{
+    explicit sorted_unique_t() = default;
+};
+
+inline constexpr sorted_unique_t sorted_unique{};
+
+namespace detail
+{
+struct Identity
+{
+    template<typename T>
+    constexpr const T& operator()(const T& value) const
+    {
+        return value;
+    }
+};
+
+// lower_bound whose loop has no data dependent branch: the step is picked with a
+// conditional move, so a search costs log2(n) loads and no mispredictions.
+template<typename Iterator, typename Key, typename Compare>
+inline Iterator branchlessLowerBound(Iterator first, Iterator last, const Key& key, Compare compare)
+{
+    auto size = last - first;
+    if(size == 0)
+    {
+        return first;
+    }
+    while(size > 1)
+    {
+        const auto half = size / 2;
+        first += compare(first[half], key) ? half : 0;
+        size -= half;
+    }
+    return first + static_cast<int>(compare(*first, key));
+}
+
+template<typename Iterator, typename Key, typename Compare>
+inline Iterator branchlessUpperBound(Iterator first, Iterator last, const Key& key, Compare compare)
+{
+    return branchlessLowerBound(first, last, key, [&compare](const auto& lhs, const auto& rhs) {
+        return not compare(rhs, lhs);
+    });
+}
+
+// Sorts by keyOf and drops later duplicates, so the first of equal keys wins like in
+// std::map::insert.
+template<typename Values, typename KeyOf, typename Compare>
+inline void sortUnique(Values& values, KeyOf keyOf, Compare compare)
+{
+    std::stable_sort(values.begin(), values.end(), [&](const auto& lhs, const auto& rhs) {
+        return compare(keyOf(lhs), keyOf(rhs));
+    });
+    const auto unique = std::unique(values.begin(), values.end(), [&](const auto& lhs, const auto& rhs) {
+        return not compare(keyOf(lhs), keyOf(rhs));
+    });
+    // pop_back() rather than erase(), utils::vector has no erase.
+    for(auto duplicates = values.end() - unique; duplicates > 0; --duplicates)
+    {
+        values.pop_back();
+    }
+}
+
+// One pass over the stored keys and a sorted, unique batch of new keys. take(true, index)
+// moves stored element index to the output, take(false, index) batch element index.
+template<typename Stored, typename Batch, typename KeyOf, typename Compare, typename Take>
+inline void mergeUnique(const Stored& stored, const Batch& batch, KeyOf keyOf, Compare compare, Take take)
+{
+    std::size_t old{}, added{};
+    while(old < stored.size() and added < batch.size())
+    {
+        if(compare(stored[old], keyOf(batch[added])))
+        {
+            take(true, old++);
+        }
+        else
+        {
+            if(compare(keyOf(batch[added]), stored[old]))
+            {
+                take(false, added);
+            }
+            ++added;
+        }
+    }
+    for(; old < stored.size(); ++old)
+    {
+        take(true, old);
+    }
+    for(; added < batch.size(); ++added)
+    {
+        take(false, added);
+    }
+}
+
+// The same merge in place: the containers already hold stored + added elements, the last
+// added of them spare. Filling from the back leaves everything before the first new key
+// where it is, so appending keys larger than all stored ones moves nothing.
+// addedFirst(old, added) tells whether batch element added goes before stored element old.
+template<typename AddedFirst, typename MoveStored, typename MoveAdded>
+inline void mergeBackward(std::size_t stored, std::size_t added, AddedFirst addedFirst, MoveStored moveStored,
+                          MoveAdded moveAdded)
+{
+    for(auto out = stored + added; added > 0;)
+    {
+        --out;
+        if(stored > 0 and addedFirst(stored - 1, added - 1))
+        {
+            moveStored(--stored, out);
+        }
+        else
+        {
+            moveAdded(--added, out);
+        }
+    }
+}
+}
+
+// Sorted unique keys in one contiguous container. Lookups are a branchless binary search
+// over adjacent memory, iteration is a pointer walk, and printRange() sees a contiguous
+// range (the integer kernel prints a flat_set<int>). Inserting a range sorts the new keys
+// and merges them in place instead of shifting the tail once per key.
+template<typename Key, typename Compare = std::less<Key>, typename KeyContainer = utils::vector<Key>>
+class flat_set
+{
+public:
+    using key_type = Key;
+    using value_type = Key;
+    using key_compare = Compare;
+    using value_compare = Compare;
+    using container_type = KeyContainer;
+    using size_type = std::size_t;
+    using difference_type = std::ptrdiff_t;
+    using reference = const Key&;
+    using const_reference = const Key&;
+    using iterator = typename KeyContainer::const_iterator;
+    using const_iterator = typename KeyContainer::const_iterator;
+
+    flat_set() = default;
+
+    explicit flat_set(KeyContainer keys, const Compare& compare = Compare())
+        : storage_{std::move(keys), compare}
+    {
+        detail::sortUnique(this->keys(), detail::Identity{}, compare);
+    }
+
+    flat_set(sorted_unique_t, KeyContainer keys, const Compare& compare = Compare())
+        : storage_{std::move(keys), compare}
+    {}
+
+    template<typename Iterator, typename = typename std::iterator_traits<Iterator>::iterator_category>
+    flat_set(Iterator first, Iterator last, const Compare& compare = Compare())
+        : flat_set(KeyContainer(first, last), compare)
+    {}
+
+    template<typename Iterator, typename = typename std::iterator_traits<Iterator>::iterator_category>
+    flat_set(sorted_unique_t, Iterator first, Iterator last, const Compare& compare = Compare())
+        : flat_set(sorted_unique, KeyContainer(first, last), compare)
+    {}
+
+    flat_set(std::initializer_list<Key> keys, const Compare& compare = Compare())
+        : flat_set(keys.begin(), keys.end(), compare)
+    {}
+
+    flat_set(sorted_unique_t, std::initializer_list<Key> keys, const Compare& compare = Compare())
+        : flat_set(sorted_unique, keys.begin(), keys.end(), compare)
+    {}
+
+    iterator begin() const { return keys().begin(); }
+    iterator end() const { return keys().end(); }
+    iterator cbegin() const { return keys().begin(); }
+    iterator cend() const { return keys().end(); }
+
+    const Key* data() const { return keys().data(); }
+    size_type size() const { return keys().size(); }
+    bool empty() const { return keys().empty(); }
+    key_compare key_comp() const { return compare(); }
+
+    void reserve(size_type capacity) { keys().reserve(capacity); }
+    void clear() { keys().clear(); }
+
+    iterator lower_bound(const Key& key) const
+    {
+        return detail::branchlessLowerBound(begin(), end(), key, compare());
+    }
+
+    iterator upper_bound(const Key& key) const
+    {
+        return detail::branchlessUpperBound(begin(), end(), key, compare());
+    }
+
+    iterator find(const Key& key) const
+    {
+        const auto it = lower_bound(key);
+        return it != end() and not compare()(key, *it) ? it : end();
+    }
+
+    bool contains(const Key& key) const { return find(key) != end(); }
+    size_type count(const Key& key) const { return contains(key) ? 1 : 0; }
+
+    std::pair<iterator, bool> insert(const Key& key) { return emplace(key); }
+    std::pair<iterator, bool> insert(Key&& key) { return emplace(std::move(key)); }
+
+    template<typename... Args>
+    std::pair<iterator, bool> emplace(Args&&... args)
+    {
+        Key key(std::forward<Args>(args)...);
+        const auto index = lower_bound(key) - begin();
+        if(index != static_cast<difference_type>(size()) and not compare()(key, keys()[static_cast<size_type>(index)]))
+        {
+            return {begin() + index, false};
+        }
+        insertAt(static_cast<size_type>(index), std::move(key));
+        return {begin() + index, true};
+    }
+
+    template<typename Iterator, typename = typename std::iterator_traits<Iterator>::iterator_category>
+    void insert(Iterator first, Iterator last)
+    {
+        std::vector<Key> batch(first, last);
+        detail::sortUnique(batch, detail::Identity{}, compare());
+        merge(batch);
+    }
+
+    template<typename Iterator, typename = typename std::iterator_traits<Iterator>::iterator_category>
+    void insert(sorted_unique_t, Iterator first, Iterator last)
+    {
+        std::vector<Key> batch(first, last);
+        merge(batch);
+    }
+
+    void insert(std::initializer_list<Key> keys) { insert(keys.begin(), keys.end()); }
+
+    iterator erase(const_iterator position)
+    {
+        const auto index = static_cast<size_type>(position - begin());
+        auto& stored = keys();
+        std::move(stored.begin() + index + 1, stored.end(), stored.begin() + index);
+        stored.pop_back();
+        return begin() + static_cast<difference_type>(index);
+    }
+
+    size_type erase(const Key& key)
+    {
+        const auto it = find(key);
+        if(it == end())
+        {
+            return 0;
+        }
+        erase(it);
+        return 1;
+    }
+
+    // Hands the sorted keys over and leaves the set empty.
+    KeyContainer extract() &&
+    {
+        return std::move(keys());
+    }
+
+    friend bool operator==(const flat_set& lhs, const flat_set& rhs)
+    {
+        return std::equal(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
+    }
+
+    friend bool operator!=(const flat_set& lhs, const flat_set& rhs)
+    {
+        return not(lhs == rhs);
+    }
+
+private:
+    KeyContainer& keys() { return storage_.first(); }
+    const KeyContainer& keys() const { return storage_.first(); }
+    const Compare& compare() const { return storage_.second(); }
+
+    void insertAt(size_type index, Key&& key)
+    {
+        auto& stored = keys();
+        stored.push_back(std::move(key));
+        std::rotate(stored.begin() + static_cast<difference_type>(index), stored.end() - 1, stored.end());
+    }
+
+    // Keys already stored win, the rest goes in with one merge.
+    void merge(std::vector<Key>& batch)
+    {
+        batch.erase(std::remove_if(batch.begin(), batch.end(), [this](const Key& key) { return contains(key); }),
+                    batch.end());
+        auto& stored = keys();
+        const auto count = stored.size();
+        if constexpr(std::is_default_constructible_v<Key>)
+        {
+            stored.resize(count + batch.size());
+            detail::mergeBackward(
+                count, batch.size(), [&](size_type old, size_type added) { return compare()(batch[added], stored[old]); },
+                [&](size_type from, size_type to) { stored[to] = std::move(stored[from]); },
+                [&](size_type from, size_type to) { stored[to] = std::move(batch[from]); });
+        }
+        else
+        {
+            KeyContainer merged;
+            merged.reserve(count + batch.size());
+            detail::mergeUnique(stored, batch, detail::Identity{}, compare(), [&](bool fromStored, size_type index) {
+                merged.push_back(fromStored ? std::move(stored[index]) : std::move(batch[index]));
+            });
+            stored = std::move(merged);
+        }
+    }
+
+    // An empty Compare takes no space.
+    compressed_pair<KeyContainer, Compare> storage_{};
+};
+
+template<typename Iterator, typename Compare = std::less<typename std::iterator_traits<Iterator>::value_type>,
+         typename = typename std::iterator_traits<Iterator>::iterator_category>
+flat_set(Iterator, Iterator, Compare = Compare())
+    -> flat_set<typename std::iterator_traits<Iterator>::value_type, Compare>;
+
+template<typename Iterator, typename Compare = std::less<typename std::iterator_traits<Iterator>::value_type>,
+         typename = typename std::iterator_traits<Iterator>::iterator_category>
+flat_set(sorted_unique_t, Iterator, Iterator, Compare = Compare())
+    -> flat_set<typename std::iterator_traits<Iterator>::value_type, Compare>;
+
+template<typename KeyContainer, typename Compare = std::less<typename KeyContainer::value_type>,
+         typename = typename KeyContainer::const_iterator>
+flat_set(KeyContainer, Compare = Compare())
+    -> flat_set<typename KeyContainer::value_type, Compare, KeyContainer>;
+
+template<typename KeyContainer, typename Compare = std::less<typename KeyContainer::value_type>,
+         typename = typename KeyContainer::const_iterator>
+flat_set(sorted_unique_t, KeyContainer, Compare = Compare())
+    -> flat_set<typename KeyContainer::value_type, Compare, KeyContainer>;
+}
@@ -0,0 +1,124 @@
+#pragma once
+
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <optional>
+#include <type_traits>
+#include <utility>
+
+namespace utils
+{
+// End of a range whose iterator knows by itself when it is done, like std::default_sentinel.
+struct default_sentinel_t
+{};
+
+inline constexpr default_sentinel_t default_sentinel{};
+
+// Pull-based single pass range: every step calls source(), which returns the next value or
+// std::nullopt once it is exhausted. Only the current value is kept, so printRange(generator)
+// formats the data in constant memory while it is produced. Copies of a generator and of its
+// iterators share one position, like istream_iterators over one stream.
+template<typename T>
+class generator
+{
+    struct State
+    {
+        std::function<std::optional<T>()> source;
+        std::optional<T> current{};
+        bool started{};
+
+        void pull()
+        {
+            current = source();
+        }
+    };
+
+public:
+    using value_type = T;
+
+    class iterator
+    {
+    public:
+        using iterator_category = std::input_iterator_tag;
+        using value_type = T;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const T*;
+        using reference = const T&;
+
+        // What it++ returns: the value it pointed at, so *it++ still reads it.
+        class Postfix
+        {
+        public:
+            explicit Postfix(T value)
+                : value_{std::move(value)}
+            {}
+
+            const T& operator*() const { return value_; }
+
+        private:
+            T value_;
+        };
+
+        iterator() = default;
+        explicit iterator(std::shared_ptr<State> state)
+            : state_{std::move(state)}
+        {}
+
+        const T& operator*() const { return *state_->current; }
+        const T* operator->() const { return &*state_->current; }
+
+        iterator& operator++()
+        {
+            state_->pull();
+            return *this;
+        }
+
+        Postfix operator++(int)
+        {
+            Postfix previous{std::move(*state_->current)};
+            state_->pull();
+            return previous;
+        }
+
+        friend bool operator==(const iterator& lhs, const iterator& rhs) { return lhs.done() == rhs.done(); }
+        friend bool operator!=(const iterator& lhs, const iterator& rhs) { return not(lhs == rhs); }
+        friend bool operator==(const iterator& it, default_sentinel_t) { return it.done(); }
+        friend bool operator==(default_sentinel_t, const iterator& it) { return it.done(); }
+        friend bool operator!=(const iterator& it, default_sentinel_t) { return not it.done(); }
+        friend bool operator!=(default_sentinel_t, const iterator& it) { return not it.done(); }
+
+    private:
+        bool done() const { return state_ == nullptr or not state_->current; }
+
+        // Owning, so printRange(makeGenerator()) outlives the temporary generator.
+        std::shared_ptr<State> state_{};
+    };
+
+    template<typename Source,
+             typename = std::enable_if_t<std::is_convertible_v<std::invoke_result_t<Source&>, std::optional<T>>>>
+    explicit generator(Source source)
+        : state_{std::make_shared<State>(State{std::move(source)})}
+    {}
+
+    // The first call pulls the first value, later calls continue where iteration stopped.
+    iterator begin() const
+    {
+        if(not state_->started)
+        {
+            state_->started = true;
+            state_->pull();
+        }
+        return iterator{state_};
+    }
+
+    default_sentinel_t end() const { return default_sentinel; }
+
+private:
+    std::shared_ptr<State> state_;
+};
+
+template<typename Source>
+generator(Source) -> generator<typename std::invoke_result_t<Source&>::value_type>;
+}
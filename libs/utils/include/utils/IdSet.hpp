@@ -0,0 +1,455 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+namespace utils
+{
+// How IdLookup finds an id, IdSet picks one from the pack at compile time.
+enum class IdStrategy
+{
+    Linear,       // the || fold, for a handful of ids
+    Bitset,       // one bit per id between the smallest and the largest
+    BinarySearch, // sorted array, branchless lower bound
+    PerfectHash   // hash and displace table, one probe
+};
+
+namespace detail
+{
+// Unique ids in ascending order, each with the position of its first occurrence in the pack.
+template<std::size_t N>
+struct SortedIds
+{
+    std::array<unsigned, N> ids{};
+    std::array<std::uint32_t, N> indices{};
+    std::size_t size{};
+};
+
+// Bottom-up merge sort of the positions, stable so the first occurrence of an id comes first.
+template<std::size_t N>
+constexpr SortedIds<N> sortIds(const std::array<unsigned, N>& pack)
+{
+    std::array<std::uint32_t, N> order{};
+    for(std::size_t i = 0; i < N; ++i)
+    {
+        order[i] = static_cast<std::uint32_t>(i);
+    }
+    for(std::size_t width = 1; width < N; width *= 2)
+    {
+        std::array<std::uint32_t, N> merged{};
+        for(std::size_t left = 0; left < N; left += 2 * width)
+        {
+            const auto middle = left + width < N ? left + width : N;
+            const auto right = left + 2 * width < N ? left + 2 * width : N;
+            auto i = left, j = middle;
+            for(auto out = left; out < right; ++out)
+            {
+                merged[out] = j == right or (i < middle and pack[order[i]] <= pack[order[j]]) ? order[i++] : order[j++];
+            }
+        }
+        order = merged;
+    }
+
+    SortedIds<N> sorted{};
+    for(std::size_t i = 0; i < N; ++i)
+    {
+        if(sorted.size == 0 or sorted.ids[sorted.size - 1] != pack[order[i]])
+        {
+            sorted.ids[sorted.size] = pack[order[i]];
+            sorted.indices[sorted.size] = order[i];
+            ++sorted.size;
+        }
+    }
+    return sorted;
+}
+
+template<unsigned... IDs>
+constexpr std::array<unsigned, sizeof...(IDs)> idPack{IDs...};
+
+template<unsigned... IDs>
+constexpr auto sortedIds = sortIds(idPack<IDs...>);
+
+template<unsigned... IDs>
+constexpr std::uint64_t idSpan = std::uint64_t{sortedIds<IDs...>.ids[sortedIds<IDs...>.size - 1]} -
+                                 sortedIds<IDs...>.ids[0] + 1;
+
+constexpr std::size_t ceilPowerOfTwo(std::size_t value)
+{
+    std::size_t power{1};
+    while(power < value)
+    {
+        power *= 2;
+    }
+    return power;
+}
+
+constexpr unsigned log2(std::size_t power)
+{
+    unsigned bits{};
+    while((std::size_t{1} << bits) < power)
+    {
+        ++bits;
+    }
+    return bits;
+}
+
+// Hash and displace: every id picks a bucket with one hash and a slot with another, each
+// bucket stores the value xor-ed into the slot hash of its ids so that no two ids share a
+// slot. Buckets average two ids and the table is at most half full.
+struct PerfectHashShape
+{
+    std::size_t buckets;
+    std::size_t slots;
+    unsigned bucketShift;
+    unsigned slotShift;
+};
+
+constexpr PerfectHashShape perfectHashShape(std::size_t size)
+{
+    const auto buckets = ceilPowerOfTwo((size + 1) / 2);
+    const auto slots = ceilPowerOfTwo(2 * size);
+    return {buckets, slots, 64 - log2(buckets), 64 - log2(slots)};
+}
+
+constexpr std::size_t hashBucket(unsigned id, std::uint64_t seed, unsigned shift)
+{
+    return shift == 64 ? 0 : static_cast<std::size_t>(((id ^ seed) * 0x9e3779b97f4a7c15ull) >> shift);
+}
+
+constexpr std::size_t hashSlot(unsigned id, std::uint64_t seed, unsigned shift)
+{
+    return shift == 64 ? 0 : static_cast<std::size_t>(((id ^ (seed >> 32)) * 0xc2b2ae3d27d4eb4full) >> shift);
+}
+
+template<std::size_t Buckets, std::size_t Slots>
+struct PerfectHashTable
+{
+    std::uint64_t seed{};
+    std::array<std::uint32_t, Buckets> displacements{};
+    std::array<unsigned, Slots> ids{};
+    std::array<std::uint32_t, Slots> indices{};
+    bool built{};
+};
+
+constexpr std::size_t maxPerfectHashSeeds{16};
+
+template<std::size_t Buckets, std::size_t Slots, std::size_t N>
+constexpr PerfectHashTable<Buckets, Slots> buildPerfectHash(const SortedIds<N>& sorted)
+{
+    const auto shape = perfectHashShape(sorted.size);
+
+    PerfectHashTable<Buckets, Slots> table{};
+    for(std::uint64_t attempt = 0; attempt < maxPerfectHashSeeds and not table.built; ++attempt)
+    {
+        table = {};
+        table.seed = (attempt + 1) * 0x9e3779b97f4a7c15ull;
+
+        // Ids grouped by bucket with a counting sort.
+        std::array<std::uint32_t, Buckets + 1> bucketStart{};
+        std::array<std::uint32_t, N> members{};
+        for(std::size_t i = 0; i < sorted.size; ++i)
+        {
+            ++bucketStart[hashBucket(sorted.ids[i], table.seed, shape.bucketShift) + 1];
+        }
+        std::uint32_t largest{};
+        for(std::size_t bucket = 0; bucket < Buckets; ++bucket)
+        {
+            largest = bucketStart[bucket + 1] > largest ? bucketStart[bucket + 1] : largest;
+            bucketStart[bucket + 1] += bucketStart[bucket];
+        }
+        std::array<std::uint32_t, Buckets> filled{};
+        for(std::size_t i = 0; i < sorted.size; ++i)
+        {
+            const auto bucket = hashBucket(sorted.ids[i], table.seed, shape.bucketShift);
+            members[bucketStart[bucket] + filled[bucket]++] = static_cast<std::uint32_t>(i);
+        }
+
+        // Largest buckets first, while most slots are still free.
+        std::array<bool, Slots> used{};
+        table.built = true;
+        for(auto size = largest; size > 0 and table.built; --size)
+        {
+            for(std::size_t bucket = 0; bucket < Buckets and table.built; ++bucket)
+            {
+                const auto first = bucketStart[bucket];
+                const auto last = bucketStart[bucket + 1];
+                if(last - first != size)
+                {
+                    continue;
+                }
+                // Two ids with the same slot hash stay together under every displacement.
+                for(auto i = first; i < last and table.built; ++i)
+                {
+                    for(auto j = first; j < i; ++j)
+                    {
+                        table.built = table.built and hashSlot(sorted.ids[members[i]], table.seed, shape.slotShift) !=
+                                                      hashSlot(sorted.ids[members[j]], table.seed, shape.slotShift);
+                    }
+                }
+                bool placed{};
+                for(std::size_t displacement = 0; displacement < shape.slots and table.built and not placed; ++displacement)
+                {
+                    placed = true;
+                    for(auto i = first; i < last and placed; ++i)
+                    {
+                        placed = not used[hashSlot(sorted.ids[members[i]], table.seed, shape.slotShift) ^ displacement];
+                    }
+                    if(placed)
+                    {
+                        for(auto i = first; i < last; ++i)
+                        {
+                            used[hashSlot(sorted.ids[members[i]], table.seed, shape.slotShift) ^ displacement] = true;
+                        }
+                        table.displacements[bucket] = static_cast<std::uint32_t>(displacement);
+                    }
+                }
+                table.built = table.built and placed;
+            }
+        }
+    }
+    if(not table.built)
+    {
+        return table;
+    }
+
+    // Free slots repeat the first id, which only ever hashes to its own slot.
+    for(std::size_t slot = 0; slot < Slots; ++slot)
+    {
+        table.ids[slot] = sorted.ids[0];
+        table.indices[slot] = sorted.indices[0];
+    }
+    for(std::size_t i = 0; i < sorted.size; ++i)
+    {
+        const auto bucket = hashBucket(sorted.ids[i], table.seed, shape.bucketShift);
+        const auto slot = hashSlot(sorted.ids[i], table.seed, shape.slotShift) ^ table.displacements[bucket];
+        table.ids[slot] = sorted.ids[i];
+        table.indices[slot] = sorted.indices[i];
+    }
+    return table;
+}
+
+template<unsigned... IDs>
+constexpr auto perfectHashTable = buildPerfectHash<perfectHashShape(sizeof...(IDs)).buckets,
+                                                   perfectHashShape(sizeof...(IDs)).slots>(sortedIds<IDs...>);
+
+template<unsigned... IDs>
+constexpr std::size_t bitsetWords = static_cast<std::size_t>((idSpan<IDs...> + 63) / 64);
+
+template<unsigned... IDs>
+constexpr std::array<std::uint64_t, bitsetWords<IDs...>> makeIdBits()
+{
+    constexpr auto& sorted = sortedIds<IDs...>;
+    std::array<std::uint64_t, bitsetWords<IDs...>> bits{};
+    for(std::size_t i = 0; i < sorted.size; ++i)
+    {
+        const auto offset = sorted.ids[i] - sorted.ids[0];
+        bits[offset / 64] |= std::uint64_t{1} << (offset % 64);
+    }
+    return bits;
+}
+
+template<unsigned... IDs>
+constexpr auto idBits = makeIdBits<IDs...>();
+
+// Ids in the words before, which turns a bit into a position in sortedIds.
+template<unsigned... IDs>
+constexpr std::array<std::uint32_t, bitsetWords<IDs...>> makeIdRanks()
+{
+    std::array<std::uint32_t, bitsetWords<IDs...>> ranks{};
+    for(std::size_t word = 1; word < ranks.size(); ++word)
+    {
+        ranks[word] = ranks[word - 1] + static_cast<std::uint32_t>(__builtin_popcountll(idBits<IDs...>[word - 1]));
+    }
+    return ranks;
+}
+
+template<unsigned... IDs>
+constexpr auto idRanks = makeIdRanks<IDs...>();
+
+constexpr std::uint64_t maxBitsetSpan{std::uint64_t{1} << 16};
+
+// At most 16 bits per id, or a single word.
+template<unsigned... IDs>
+constexpr bool is_dense_id_pack = idSpan<IDs...> <= maxBitsetSpan and
+                                  (idSpan<IDs...> <= 64 or idSpan<IDs...> <= 16 * sortedIds<IDs...>.size);
+
+// Measured with IdSetBenchmarks: the fold compiles into a few compares and range checks
+// that beat every table up to about eight ids, a bitset test is the fastest membership
+// check for dense packs and the perfect hash for sparse ones. Binary search never wins
+// and is there for packs no perfect hash was found for.
+template<unsigned... IDs>
+constexpr IdStrategy chooseContainsStrategy()
+{
+    if(sizeof...(IDs) <= 8)
+    {
+        return IdStrategy::Linear;
+    }
+    if(is_dense_id_pack<IDs...>)
+    {
+        return IdStrategy::Bitset;
+    }
+    return perfectHashTable<IDs...>.built ? IdStrategy::PerfectHash : IdStrategy::BinarySearch;
+}
+
+// Positions cost the fold a select per id and the bitset a rank, so the perfect hash takes
+// over from three ids.
+template<unsigned... IDs>
+constexpr IdStrategy chooseIndexStrategy()
+{
+    if(sizeof...(IDs) <= 2)
+    {
+        return IdStrategy::Linear;
+    }
+    if(perfectHashTable<IDs...>.built)
+    {
+        return IdStrategy::PerfectHash;
+    }
+    return is_dense_id_pack<IDs...> ? IdStrategy::Bitset : IdStrategy::BinarySearch;
+}
+}
+
+// index() returns the position of the id in the pack (its first occurrence), or the pack
+// size when it is not there, so a table of sizeof...(IDs) + 1 handlers dispatches without
+// branches.
+template<IdStrategy Strategy, unsigned... IDs>
+struct IdLookup;
+
+template<unsigned... IDs>
+struct IdLookup<IdStrategy::Linear, IDs...>
+{
+    static constexpr bool contains(unsigned id)
+    {
+        return ((id == IDs) or ...);
+    }
+
+    static constexpr std::size_t index(unsigned id)
+    {
+        std::size_t result{sizeof...(IDs)};
+        std::size_t position{};
+        ((result = result == sizeof...(IDs) and id == IDs ? position : result, ++position), ...);
+        return result;
+    }
+};
+
+template<unsigned... IDs>
+struct IdLookup<IdStrategy::Bitset, IDs...>
+{
+    static_assert(detail::idSpan<IDs...> <= detail::maxBitsetSpan, "ids are too far apart for a bitset");
+
+    static constexpr bool contains(unsigned id)
+    {
+        const auto offset = std::uint64_t{id} - first;
+        return offset < span and (bits[offset / 64] >> (offset % 64) & 1) != 0;
+    }
+
+    // Ids outside of the span read word 0 and are then turned into the pack size.
+    static constexpr std::size_t index(unsigned id)
+    {
+        const auto offset = std::uint64_t{id} - first;
+        const bool inside = offset < span;
+        const auto word = inside ? static_cast<std::size_t>(offset / 64) : 0;
+        const auto bit = std::uint64_t{1} << (offset % 64);
+        const auto rank = ranks[word] + static_cast<std::size_t>(__builtin_popcountll(bits[word] & (bit - 1)));
+        return inside and (bits[word] & bit) != 0 ? sorted.indices[rank] : sizeof...(IDs);
+    }
+
+private:
+    static constexpr auto& sorted = detail::sortedIds<IDs...>;
+    static constexpr auto& bits = detail::idBits<IDs...>;
+    static constexpr auto& ranks = detail::idRanks<IDs...>;
+    static constexpr unsigned first = sorted.ids[0];
+    static constexpr std::uint64_t span = detail::idSpan<IDs...>;
+};
+
+template<unsigned... IDs>
+struct IdLookup<IdStrategy::BinarySearch, IDs...>
+{
+    static constexpr bool contains(unsigned id)
+    {
+        return sorted.ids[lastNotGreater(id)] == id;
+    }
+
+    static constexpr std::size_t index(unsigned id)
+    {
+        const auto position = lastNotGreater(id);
+        return sorted.ids[position] == id ? sorted.indices[position] : sizeof...(IDs);
+    }
+
+private:
+    static constexpr auto& sorted = detail::sortedIds<IDs...>;
+
+    // Halves the range with a conditional move per step, the trip count depends on the
+    // pack alone so the loop unrolls completely.
+    static constexpr std::size_t lastNotGreater(unsigned id)
+    {
+        std::size_t base{};
+        for(auto size = sorted.size; size > 1; size -= size / 2)
+        {
+            const auto middle = base + size / 2;
+            base = sorted.ids[middle] <= id ? middle : base;
+        }
+        return base;
+    }
+};
+
+template<unsigned... IDs>
+struct IdLookup<IdStrategy::PerfectHash, IDs...>
+{
+    static_assert(detail::perfectHashTable<IDs...>.built, "no perfect hash found for the ids, use BinarySearch");
+
+    static constexpr bool contains(unsigned id)
+    {
+        return table.ids[slot(id)] == id;
+    }
+
+    static constexpr std::size_t index(unsigned id)
+    {
+        const auto position = slot(id);
+        return table.ids[position] == id ? table.indices[position] : sizeof...(IDs);
+    }
+
+private:
+    static constexpr auto& table = detail::perfectHashTable<IDs...>;
+    static constexpr auto shape = detail::perfectHashShape(detail::sortedIds<IDs...>.size);
+
+    static constexpr std::size_t slot(unsigned id)
+    {
+        return detail::hashSlot(id, table.seed, shape.slotShift) ^
+               table.displacements[detail::hashBucket(id, table.seed, shape.bucketShift)];
+    }
+};
+
+// Strategies picked from the pack, separately for membership and for positions.
+template<unsigned... IDs>
+struct IdSet
+{
+    using ContainsLookup = IdLookup<detail::chooseContainsStrategy<IDs...>(), IDs...>;
+    using IndexLookup = IdLookup<detail::chooseIndexStrategy<IDs...>(), IDs...>;
+
+    static constexpr bool contains(unsigned id)
+    {
+        return ContainsLookup::contains(id);
+    }
+
+    static constexpr std::size_t index(unsigned id)
+    {
+        return IndexLookup::index(id);
+    }
+};
+
+// Same call syntax as the fold-expressions exercise, usable in constant expressions.
+template<unsigned ID, unsigned... IDs>
+constexpr bool has_id(unsigned id)
+{
+    return IdSet<ID, IDs...>::contains(id);
+}
+
+// Position of id in the pack, or the pack size when it is missing.
+template<unsigned ID, unsigned... IDs>
+constexpr std::size_t index_of_id(unsigned id)
+{
+    return IdSet<ID, IDs...>::index(id);
+}
+}
@@ -0,0 +1,346 @@
+#pragma once
+
+#include <algorithm>
+#include <charconv>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <string_view>
+#include <type_traits>
+
+#if defined(__GNUC__) && defined(__x86_64__)
+#define UTILS_HAS_X86_INTEGER_KERNELS 1
+#include <immintrin.h>
+#endif
+
+namespace utils
+{
+enum class IntegerKernel
+{
+    Scalar,
+    Sse2,
+    Avx2
+};
+
+// Integers printed as numbers by std::ostream, characters and bool are printed differently.
+// The kernels work on 64-bit magnitudes, wider integers such as __int128 (integral under
+// gnu++17) are left out.
+template<typename T>
+constexpr bool is_kernel_integer_v = std::is_integral_v<T> and
+                                     sizeof(T) <= sizeof(std::uint64_t) and
+                                     not std::is_same_v<T, bool> and
+                                     not std::is_same_v<T, char> and
+                                     not std::is_same_v<T, signed char> and
+                                     not std::is_same_v<T, unsigned char> and
+                                     not std::is_same_v<T, wchar_t> and
+                                     not std::is_same_v<T, char16_t> and
+                                     not std::is_same_v<T, char32_t>;
+
+// Upper bound of characters a single T takes, including the minus sign.
+template<typename T>
+constexpr std::size_t maxFormattedIntegerSize = std::numeric_limits<T>::digits10 + 1 + std::is_signed_v<T>;
+
+// Kernels store whole 8 byte words, so the output needs this much room past the last number.
+constexpr std::size_t formatIntegersPadding{16};
+
+namespace detail
+{
+template<typename T>
+inline bool splitSign(T value, std::uint64_t& magnitude)
+{
+    if constexpr(std::is_signed_v<T>)
+    {
+        magnitude = value < 0 ? std::uint64_t{0} - static_cast<std::uint64_t>(value) : static_cast<std::uint64_t>(value);
+        return value < 0;
+    }
+    else
+    {
+        magnitude = value;
+        return false;
+    }
+}
+
+// Short delimiters are copied with one fixed 16 byte store into the output padding, which
+// keeps library calls (and the vzeroupper they force in AVX2 code) out of the kernels.
+class DelimiterWriter
+{
+public:
+    explicit DelimiterWriter(std::string_view delimiter)
+        : delimiter_{delimiter}
+    {
+        std::memcpy(text_, delimiter.data(), std::min(delimiter.size(), sizeof(text_)));
+    }
+
+    char* operator()(char* out) const
+    {
+        if(delimiter_.size() <= sizeof(text_))
+        {
+            std::memcpy(out, text_, sizeof(text_));
+        }
+        else
+        {
+            std::memcpy(out, delimiter_.data(), delimiter_.size());
+        }
+        return out + delimiter_.size();
+    }
+
+private:
+    std::string_view delimiter_;
+    char text_[16]{};
+};
+
+template<typename T>
+inline char* formatIntegersScalar(const T* first, const T* last, std::string_view delimiter, char* out)
+{
+    const DelimiterWriter writeDelimiter{delimiter};
+    for(auto it = first; it != last; ++it)
+    {
+        if(it != first)
+        {
+            out = writeDelimiter(out);
+        }
+        out = std::to_chars(out, out + maxFormattedIntegerSize<T>, *it).ptr;
+    }
+    return out;
+}
+
+#ifdef UTILS_HAS_X86_INTEGER_KERNELS
+constexpr std::uint64_t tenToThe8{100000000};
+constexpr std::uint64_t tenToThe16{10000000000000000};
+
+inline std::size_t decimalDigits(std::uint64_t value)
+{
+    constexpr std::uint64_t powersOf10[]{
+        1, 10, 100, 1000, 10000, 100000, 1000000, 10000000, 100000000, 1000000000,
+        10000000000, 100000000000, 1000000000000, 10000000000000, 100000000000000,
+        1000000000000000, 10000000000000000, 100000000000000000, 1000000000000000000,
+        10000000000000000000u};
+
+    // Changing the lowest bit never changes the digit count, but it makes 0 count as one digit.
+    value |= 1;
+    const auto guess = static_cast<std::size_t>((64 - __builtin_clzll(value)) * 1233 >> 12);
+    return guess + 1 - (value < powersOf10[guess]);
+}
+
+// Turns value < 10^8 into its 8 decimal digits, one per 16 bit lane (W. Mula, "SSE2 itoa").
+__attribute__((always_inline))
+inline __m128i decimalLanesSse2(std::uint32_t value)
+{
+    const __m128i div10000 = _mm_set1_epi32(static_cast<int>(0xd1b71759));
+    const __m128i ten4 = _mm_set1_epi32(10000);
+    const __m128i divPowers = _mm_setr_epi16(8389, 5243, 13108, -32768, 8389, 5243, 13108, -32768);
+    const __m128i shiftPowers = _mm_setr_epi16(1 << 7, 1 << 11, 1 << 13, -32768, 1 << 7, 1 << 11, 1 << 13, -32768);
+    const __m128i ten = _mm_set1_epi16(10);
+
+    const __m128i abcdefgh = _mm_cvtsi32_si128(static_cast<int>(value));
+    const __m128i abcd = _mm_srli_epi64(_mm_mul_epu32(abcdefgh, div10000), 45);
+    const __m128i efgh = _mm_sub_epi32(abcdefgh, _mm_mul_epu32(abcd, ten4));
+    const __m128i v1 = _mm_slli_epi64(_mm_unpacklo_epi16(abcd, efgh), 2);
+    const __m128i v2a = _mm_unpacklo_epi16(v1, v1);
+    const __m128i v2 = _mm_unpacklo_epi32(v2a, v2a);
+    const __m128i v4 = _mm_mulhi_epu16(_mm_mulhi_epu16(v2, divPowers), shiftPowers);
+    const __m128i v6 = _mm_slli_epi64(_mm_mullo_epi16(v4, ten), 16);
+    return _mm_sub_epi16(v4, v6);
+}
+
+// Turns two 16 bit lane digit groups into ASCII, the first group lands in bytes 0-7.
+__attribute__((always_inline))
+inline __m128i asciiDigits(__m128i first, __m128i second)
+{
+    return _mm_add_epi8(_mm_packus_epi16(first, second), _mm_set1_epi8('0'));
+}
+
+// Writes the last count (1-8) digits of an 8 digit ASCII word with a single 8 byte store.
+__attribute__((always_inline))
+inline char* writeDigitWord(char* out, std::uint64_t digits, std::size_t count)
+{
+    digits >>= 8 * (8 - count);
+    std::memcpy(out, &digits, sizeof(digits));
+    return out + count;
+}
+
+// Writes the last count (1-16) digits of 16 ASCII digits.
+__attribute__((always_inline))
+inline char* writeDigits(char* out, __m128i digits, std::size_t count)
+{
+    const auto high = static_cast<std::uint64_t>(_mm_cvtsi128_si64(digits));
+    const auto low = static_cast<std::uint64_t>(_mm_cvtsi128_si64(_mm_srli_si128(digits, 8)));
+    if(count <= 8)
+    {
+        return writeDigitWord(out, low, count);
+    }
+    out = writeDigitWord(out, high, count - 8);
+    std::memcpy(out, &low, sizeof(low));
+    return out + 8;
+}
+
+__attribute__((always_inline))
+inline char* writeUnsignedSse2(char* out, std::uint64_t value)
+{
+    if(value < tenToThe8)
+    {
+        const __m128i digits = asciiDigits(decimalLanesSse2(static_cast<std::uint32_t>(value)), _mm_setzero_si128());
+        return writeDigitWord(out, static_cast<std::uint64_t>(_mm_cvtsi128_si64(digits)), decimalDigits(value));
+    }
+    std::size_t count{16};
+    if(value >= tenToThe16)
+    {
+        out = std::to_chars(out, out + 4, value / tenToThe16).ptr;
+        value %= tenToThe16;
+    }
+    else
+    {
+        count = decimalDigits(value);
+    }
+    const __m128i digits = asciiDigits(decimalLanesSse2(static_cast<std::uint32_t>(value / tenToThe8)),
+                                       decimalLanesSse2(static_cast<std::uint32_t>(value % tenToThe8)));
+    return writeDigits(out, digits, count);
+}
+
+template<typename T>
+inline char* formatIntegersSse2(const T* first, const T* last, std::string_view delimiter, char* out)
+{
+    const DelimiterWriter writeDelimiter{delimiter};
+    for(auto it = first; it != last; ++it)
+    {
+        if(it != first)
+        {
+            out = writeDelimiter(out);
+        }
+        std::uint64_t magnitude;
+        *out = '-';
+        out += splitSign(*it, magnitude);
+        out = writeUnsignedSse2(out, magnitude);
+    }
+    return out;
+}
+
+// Same arithmetic as decimalLanesSse2, each 128 bit lane converts its own value < 10^8.
+// Returns ASCII digits of first in the low and of second in the high 128 bit lane.
+__attribute__((target("avx2"), always_inline))
+inline __m256i asciiDigitsAvx2(std::uint32_t first, std::uint32_t second)
+{
+    const __m256i div10000 = _mm256_set1_epi32(static_cast<int>(0xd1b71759));
+    const __m256i ten4 = _mm256_set1_epi32(10000);
+    const __m256i divPowers = _mm256_setr_epi16(8389, 5243, 13108, -32768, 8389, 5243, 13108, -32768,
+                                                8389, 5243, 13108, -32768, 8389, 5243, 13108, -32768);
+    const __m256i shiftPowers = _mm256_setr_epi16(1 << 7, 1 << 11, 1 << 13, -32768, 1 << 7, 1 << 11, 1 << 13, -32768,
+                                                  1 << 7, 1 << 11, 1 << 13, -32768, 1 << 7, 1 << 11, 1 << 13, -32768);
+    const __m256i ten = _mm256_set1_epi16(10);
+
+    const __m256i abcdefgh = _mm256_set_m128i(_mm_cvtsi32_si128(static_cast<int>(second)),
+                                              _mm_cvtsi32_si128(static_cast<int>(first)));
+    const __m256i abcd = _mm256_srli_epi64(_mm256_mul_epu32(abcdefgh, div10000), 45);
+    const __m256i efgh = _mm256_sub_epi32(abcdefgh, _mm256_mul_epu32(abcd, ten4));
+    const __m256i v1 = _mm256_slli_epi64(_mm256_unpacklo_epi16(abcd, efgh), 2);
+    const __m256i v2a = _mm256_unpacklo_epi16(v1, v1);
+    const __m256i v2 = _mm256_unpacklo_epi32(v2a, v2a);
+    const __m256i v4 = _mm256_mulhi_epu16(_mm256_mulhi_epu16(v2, divPowers), shiftPowers);
+    const __m256i v6 = _mm256_slli_epi64(_mm256_mullo_epi16(v4, ten), 16);
+    const __m256i packed = _mm256_packus_epi16(_mm256_sub_epi16(v4, v6), _mm256_setzero_si256());
+    return _mm256_add_epi8(packed, _mm256_set1_epi8('0'));
+}
+
+__attribute__((target("avx2"), always_inline))
+inline char* writeUnsignedAvx2(char* out, std::uint64_t value)
+{
+    std::size_t count{16};
+    if(value >= tenToThe16)
+    {
+        out = std::to_chars(out, out + 4, value / tenToThe16).ptr;
+        value %= tenToThe16;
+    }
+    else
+    {
+        count = decimalDigits(value);
+    }
+    const __m256i digits = asciiDigitsAvx2(static_cast<std::uint32_t>(value / tenToThe8),
+                                           static_cast<std::uint32_t>(value % tenToThe8));
+    if(count <= 8)
+    {
+        return writeDigitWord(out, static_cast<std::uint64_t>(_mm256_extract_epi64(digits, 2)), count);
+    }
+    out = writeDigitWord(out, static_cast<std::uint64_t>(_mm256_extract_epi64(digits, 0)), count - 8);
+    const auto low = static_cast<std::uint64_t>(_mm256_extract_epi64(digits, 2));
+    std::memcpy(out, &low, sizeof(low));
+    return out + 8;
+}
+
+// Values of 9-16 digits take a single pass with both of their halves side by side in
+// the two 128 bit lanes, shorter ones gain nothing from the wider registers.
+template<typename T>
+__attribute__((target("avx2")))
+inline char* formatIntegersAvx2(const T* first, const T* last, std::string_view delimiter, char* out)
+{
+    const DelimiterWriter writeDelimiter{delimiter};
+    for(auto it = first; it != last; ++it)
+    {
+        if(it != first)
+        {
+            out = writeDelimiter(out);
+        }
+        std::uint64_t magnitude;
+        *out = '-';
+        out += splitSign(*it, magnitude);
+        out = magnitude < tenToThe8 ? writeUnsignedSse2(out, magnitude) : writeUnsignedAvx2(out, magnitude);
+    }
+    return out;
+}
+
+inline IntegerKernel detectIntegerKernel()
+{
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("avx2") ? IntegerKernel::Avx2 : IntegerKernel::Sse2;
+}
+#else
+inline IntegerKernel detectIntegerKernel()
+{
+    return IntegerKernel::Scalar;
+}
+#endif
+}
+
+// Best kernel this CPU supports, detected once.
+inline IntegerKernel defaultIntegerKernel()
+{
+    static const IntegerKernel kernel = detail::detectIntegerKernel();
+    return kernel;
+}
+
+inline bool isIntegerKernelSupported(IntegerKernel kernel)
+{
+    switch(kernel)
+    {
+    case IntegerKernel::Scalar:
+        return true;
+    case IntegerKernel::Sse2:
+        return defaultIntegerKernel() != IntegerKernel::Scalar;
+    case IntegerKernel::Avx2:
+        return defaultIntegerKernel() == IntegerKernel::Avx2;
+    }
+    return false;
+}
+
+// Writes [first, last) as decimal numbers separated by delimiter and returns the end of
+// the text. The caller provides room for (last - first) * (maxFormattedIntegerSize<T> +
+// delimiter.size()) + formatIntegersPadding characters.
+template<typename T>
+inline char* formatIntegers(const T* first, const T* last, std::string_view delimiter, char* out,
+                            IntegerKernel kernel = defaultIntegerKernel())
+{
+    static_assert(is_kernel_integer_v<T>, "formatIntegers supports integral types printed as numbers");
+
+    switch(kernel)
+    {
+#ifdef UTILS_HAS_X86_INTEGER_KERNELS
+    case IntegerKernel::Avx2:
+        return detail::formatIntegersAvx2(first, last, delimiter, out);
+    case IntegerKernel::Sse2:
+        return detail::formatIntegersSse2(first, last, delimiter, out);
+#endif
+    default:
+        return detail::formatIntegersScalar(first, last, delimiter, out);
+    }
+}
+}
@@ -0,0 +1,171 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <string_view>
+
+#if defined(__GNUC__) && defined(__x86_64__)
+#define UTILS_HAS_X86_ESCAPE_KERNELS 1
+#include <immintrin.h>
+#endif
+
+namespace utils
+{
+enum class EscapeKernel
+{
+    Scalar,
+    Sse2, // 16 bytes per step
+    Avx2  // 32 bytes per step
+};
+
+namespace detail
+{
+// Bytes a JSON string can not hold as they are.
+inline bool needsJsonEscape(char c)
+{
+    const auto byte = static_cast<unsigned char>(c);
+    return byte < 0x20 or c == '"' or c == '\\';
+}
+
+inline const char* findJsonEscapeScalar(const char* first, const char* last)
+{
+    return std::find_if(first, last, needsJsonEscape);
+}
+
+#ifdef UTILS_HAS_X86_ESCAPE_KERNELS
+// Compares a whole vector against '"' and '\\', control characters are those the unsigned
+// minimum with 0x1f leaves unchanged. The first set bit of the mask is the first match.
+inline const char* findJsonEscapeSse2(const char* first, const char* last)
+{
+    const __m128i quote = _mm_set1_epi8('"');
+    const __m128i backslash = _mm_set1_epi8('\\');
+    const __m128i lastControl = _mm_set1_epi8(0x1f);
+    for(; last - first >= 16; first += 16)
+    {
+        const __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(first));
+        const __m128i special = _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(chunk, quote), _mm_cmpeq_epi8(chunk, backslash)),
+                                             _mm_cmpeq_epi8(_mm_min_epu8(chunk, lastControl), chunk));
+        if(const auto mask = static_cast<unsigned>(_mm_movemask_epi8(special)))
+        {
+            return first + __builtin_ctz(mask);
+        }
+    }
+    return findJsonEscapeScalar(first, last);
+}
+
+__attribute__((target("avx2")))
+inline const char* findJsonEscapeAvx2(const char* first, const char* last)
+{
+    const __m256i quote = _mm256_set1_epi8('"');
+    const __m256i backslash = _mm256_set1_epi8('\\');
+    const __m256i lastControl = _mm256_set1_epi8(0x1f);
+    for(; last - first >= 32; first += 32)
+    {
+        const __m256i chunk = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(first));
+        const __m256i special =
+            _mm256_or_si256(_mm256_or_si256(_mm256_cmpeq_epi8(chunk, quote), _mm256_cmpeq_epi8(chunk, backslash)),
+                            _mm256_cmpeq_epi8(_mm256_min_epu8(chunk, lastControl), chunk));
+        if(const auto mask = static_cast<unsigned>(_mm256_movemask_epi8(special)))
+        {
+            return first + __builtin_ctz(mask);
+        }
+    }
+    // The tail call into find_if would otherwise keep the upper halves dirty and slow down
+    // the SSE code that runs after it.
+    _mm256_zeroupper();
+    return findJsonEscapeSse2(first, last);
+}
+
+inline EscapeKernel detectEscapeKernel()
+{
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("avx2") ? EscapeKernel::Avx2 : EscapeKernel::Sse2;
+}
+#else
+inline EscapeKernel detectEscapeKernel()
+{
+    return EscapeKernel::Scalar;
+}
+#endif
+}
+
+// Best kernel this CPU supports, detected once.
+inline EscapeKernel defaultEscapeKernel()
+{
+    static const EscapeKernel kernel = detail::detectEscapeKernel();
+    return kernel;
+}
+
+inline bool isEscapeKernelSupported(EscapeKernel kernel)
+{
+    switch(kernel)
+    {
+    case EscapeKernel::Scalar:
+        return true;
+    case EscapeKernel::Sse2:
+        return defaultEscapeKernel() != EscapeKernel::Scalar;
+    case EscapeKernel::Avx2:
+        return defaultEscapeKernel() == EscapeKernel::Avx2;
+    }
+    return false;
+}
+
+// First byte of [first, last) that has to be escaped in a JSON string: '"', '\\' or a
+// control character. Bytes from 0x80 up are UTF-8 and stay as they are.
+inline const char* findJsonEscape(const char* first, const char* last, EscapeKernel kernel = defaultEscapeKernel())
+{
+    switch(kernel)
+    {
+#ifdef UTILS_HAS_X86_ESCAPE_KERNELS
+    case EscapeKernel::Avx2:
+        return detail::findJsonEscapeAvx2(first, last);
+    case EscapeKernel::Sse2:
+        return detail::findJsonEscapeSse2(first, last);
+#endif
+    default:
+        return detail::findJsonEscapeScalar(first, last);
+    }
+}
+
+// Hands text to write(std::string_view) as the contents of a JSON string, without the
+// quotes. The clean spans between escaped bytes go out in one piece each.
+template<typename Write>
+inline void escapeJson(std::string_view text, Write&& write, EscapeKernel kernel = defaultEscapeKernel())
+{
+    constexpr char hexDigits[]{"0123456789abcdef"};
+    auto first = text.data();
+    const auto last = first + text.size();
+    while(first != last)
+    {
+        const auto special = findJsonEscape(first, last, kernel);
+        if(special != first)
+        {
+            write(std::string_view(first, static_cast<std::size_t>(special - first)));
+        }
+        if(special == last)
+        {
+            return;
+        }
+
+        char escaped[]{'\\', *special, '0', '0', '0', '0'};
+        std::size_t size{2};
+        switch(*special)
+        {
+        case '\b': escaped[1] = 'b'; break;
+        case '\f': escaped[1] = 'f'; break;
+        case '\n': escaped[1] = 'n'; break;
+        case '\r': escaped[1] = 'r'; break;
+        case '\t': escaped[1] = 't'; break;
+        case '"':
+        case '\\': break;
+        default:
+            escaped[1] = 'u';
+            escaped[4] = hexDigits[static_cast<unsigned char>(*special) >> 4];
+            escaped[5] = hexDigits[static_cast<unsigned char>(*special) & 0xf];
+            size = sizeof(escaped);
+        }
+        write(std::string_view(escaped, size));
+        first = special + 1;
+    }
+}
+}
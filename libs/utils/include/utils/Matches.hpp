@@ -0,0 +1,459 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+#include <limits>
+#include <type_traits>
+#include <utility>
+#include "traits/IsContiguousRange.hpp"
+
+#if defined(__GNUC__) && defined(__x86_64__)
+#define UTILS_HAS_X86_MATCH_KERNELS 1
+#include <immintrin.h>
+#endif
+
+namespace utils
+{
+enum class MatchKernel
+{
+    Scalar,
+    Avx2,  // 32 bytes per compare
+    Avx512 // 64 bytes per compare, needs AVX-512BW
+};
+
+namespace detail
+{
+// Element types whose == is a compare of the whole lane.
+template<typename T>
+constexpr bool is_match_lane = (std::is_integral_v<T> or std::is_enum_v<T> or std::is_same_v<T, float> or
+                                std::is_same_v<T, double>) and
+                               (sizeof(T) == 1 or sizeof(T) == 2 or sizeof(T) == 4 or sizeof(T) == 8);
+
+template<typename, typename, typename = void>
+constexpr bool has_common_type{};
+
+template<typename T, typename Arg>
+constexpr bool has_common_type<T, Arg, std::void_t<std::common_type_t<T, Arg>>> = true;
+
+// Matching in the lanes needs every Arg turned into a T. That gives the same answers as
+// element == arg when converting T to their common type loses nothing.
+template<typename T, typename Arg>
+constexpr bool is_lane_comparable = is_match_lane<T> and has_common_type<T, Arg> and
+                                    ((std::is_integral_v<T> and std::is_integral_v<Arg>) or
+                                     std::is_same_v<std::common_type_t<T, Arg>, T>);
+
+// element == arg done in their common type, spelled out so mixed signedness compares
+// the way the lanes do without -Wsign-compare.
+template<typename T, typename Arg>
+inline bool matchesArg(const T& element, const Arg& arg)
+{
+    if constexpr(std::is_arithmetic_v<T> and std::is_arithmetic_v<Arg>)
+    {
+        using Common = std::common_type_t<T, Arg>;
+        return static_cast<Common>(element) == static_cast<Common>(arg);
+    }
+    else
+    {
+        return element == arg;
+    }
+}
+
+template<std::size_t Size>
+using lane_bits_t = std::conditional_t<Size == 1, std::uint8_t,
+                    std::conditional_t<Size == 2, std::uint16_t,
+                    std::conditional_t<Size == 4, std::uint32_t, std::uint64_t>>>;
+
+template<typename T>
+inline lane_bits_t<sizeof(T)> laneBits(T value)
+{
+    lane_bits_t<sizeof(T)> bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    return bits;
+}
+
+// Counters are as wide as the elements, a lane takes at most Increments per step and is
+// added up before it could wrap.
+template<typename T, std::size_t Increments>
+constexpr std::size_t maxAccumulateSteps = std::numeric_limits<lane_bits_t<sizeof(T)>>::max() / Increments;
+
+template<typename T, std::size_t Bytes, typename Vector>
+inline std::uint64_t sumLanes(const Vector& accumulator)
+{
+    lane_bits_t<sizeof(T)> lanes[Bytes / sizeof(T)];
+    std::memcpy(lanes, &accumulator, Bytes);
+    std::uint64_t sum{};
+    for(auto lane : lanes)
+    {
+        sum += lane;
+    }
+    return sum;
+}
+
+constexpr std::size_t sharedAccumulators{4};
+
+template<typename T, std::size_t N, typename... Args>
+inline void countMatchesScalar(const T* first, const T* last, std::array<std::size_t, N>& counts, const Args&... args)
+{
+    for(; first != last; ++first)
+    {
+        std::size_t k{};
+        ((counts[k++] += static_cast<std::size_t>(matchesArg(*first, args))), ...);
+    }
+}
+
+#ifdef UTILS_HAS_X86_MATCH_KERNELS
+template<typename T>
+__attribute__((target("avx2"), always_inline))
+inline __m256i broadcastAvx2(T value)
+{
+    const auto bits = laneBits(value);
+    if constexpr(sizeof(T) == 1)
+    {
+        return _mm256_set1_epi8(static_cast<char>(bits));
+    }
+    else if constexpr(sizeof(T) == 2)
+    {
+        return _mm256_set1_epi16(static_cast<short>(bits));
+    }
+    else if constexpr(sizeof(T) == 4)
+    {
+        return _mm256_set1_epi32(static_cast<int>(bits));
+    }
+    else
+    {
+        return _mm256_set1_epi64x(static_cast<long long>(bits));
+    }
+}
+
+// All ones in the lanes where a == b. Floating point compares ordered, like ==.
+template<typename T>
+__attribute__((target("avx2"), always_inline))
+inline __m256i equalAvx2(__m256i a, __m256i b)
+{
+    if constexpr(std::is_same_v<T, float>)
+    {
+        return _mm256_castps_si256(_mm256_cmp_ps(_mm256_castsi256_ps(a), _mm256_castsi256_ps(b), _CMP_EQ_OQ));
+    }
+    else if constexpr(std::is_same_v<T, double>)
+    {
+        return _mm256_castpd_si256(_mm256_cmp_pd(_mm256_castsi256_pd(a), _mm256_castsi256_pd(b), _CMP_EQ_OQ));
+    }
+    else if constexpr(sizeof(T) == 1)
+    {
+        return _mm256_cmpeq_epi8(a, b);
+    }
+    else if constexpr(sizeof(T) == 2)
+    {
+        return _mm256_cmpeq_epi16(a, b);
+    }
+    else if constexpr(sizeof(T) == 4)
+    {
+        return _mm256_cmpeq_epi32(a, b);
+    }
+    else
+    {
+        return _mm256_cmpeq_epi64(a, b);
+    }
+}
+
+// Subtracting the all-ones compare result adds one to every matching lane.
+template<typename T>
+__attribute__((target("avx2"), always_inline))
+inline __m256i subtractLanesAvx2(__m256i accumulator, __m256i matched)
+{
+    if constexpr(sizeof(T) == 1)
+    {
+        return _mm256_sub_epi8(accumulator, matched);
+    }
+    else if constexpr(sizeof(T) == 2)
+    {
+        return _mm256_sub_epi16(accumulator, matched);
+    }
+    else if constexpr(sizeof(T) == 4)
+    {
+        return _mm256_sub_epi32(accumulator, matched);
+    }
+    else
+    {
+        return _mm256_sub_epi64(accumulator, matched);
+    }
+}
+
+// Broadcasts every needle once and compares each loaded vector against all of them. With
+// PerValue every needle has its own accumulator, otherwise they take turns on a few shared
+// ones (so the adds do not form one long dependency chain) and only the sum of counts is
+// meaningful. Returns where the scalar tail starts.
+template<bool PerValue, typename T, std::size_t N>
+__attribute__((target("avx2")))
+inline const T* countMatchesAvx2(const T* first, const T* last, const std::array<T, N>& needles,
+                                 std::array<std::size_t, N>& counts)
+{
+    constexpr std::size_t lanes{32 / sizeof(T)};
+    constexpr std::size_t accumulators{PerValue ? N : std::min(N, sharedAccumulators)};
+    constexpr std::size_t maxSteps{maxAccumulateSteps<T, (N + accumulators - 1) / accumulators>};
+
+    __m256i broadcast[N];
+    for(std::size_t k = 0; k < N; ++k)
+    {
+        broadcast[k] = broadcastAvx2(needles[k]);
+    }
+
+    while(static_cast<std::size_t>(last - first) >= lanes)
+    {
+        __m256i accumulator[accumulators];
+        for(auto& lane : accumulator)
+        {
+            lane = _mm256_setzero_si256();
+        }
+        const auto steps = std::min(maxSteps, static_cast<std::size_t>(last - first) / lanes);
+        for(std::size_t step = 0; step < steps; ++step, first += lanes)
+        {
+            const __m256i values = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(first));
+            for(std::size_t k = 0; k < N; ++k)
+            {
+                auto& lane = accumulator[k % accumulators];
+                lane = subtractLanesAvx2<T>(lane, equalAvx2<T>(values, broadcast[k]));
+            }
+        }
+        for(std::size_t k = 0; k < accumulators; ++k)
+        {
+            counts[k] += sumLanes<T, 32>(accumulator[k]);
+        }
+    }
+    return first;
+}
+
+template<typename T>
+__attribute__((target("avx512f,avx512bw"), always_inline))
+inline __m512i broadcastAvx512(T value)
+{
+    const auto bits = laneBits(value);
+    if constexpr(sizeof(T) == 1)
+    {
+        return _mm512_set1_epi8(static_cast<char>(bits));
+    }
+    else if constexpr(sizeof(T) == 2)
+    {
+        return _mm512_set1_epi16(static_cast<short>(bits));
+    }
+    else if constexpr(sizeof(T) == 4)
+    {
+        return _mm512_set1_epi32(static_cast<int>(bits));
+    }
+    else
+    {
+        return _mm512_set1_epi64(static_cast<long long>(bits));
+    }
+}
+
+// Adds one to the lanes of accumulator where a == b.
+template<typename T>
+__attribute__((target("avx512f,avx512bw"), always_inline))
+inline __m512i countEqualAvx512(__m512i accumulator, __m512i a, __m512i b)
+{
+    const __m512i minusOne = _mm512_set1_epi32(-1);
+    if constexpr(std::is_same_v<T, float>)
+    {
+        return _mm512_mask_sub_epi32(accumulator, _mm512_cmp_ps_mask(_mm512_castsi512_ps(a), _mm512_castsi512_ps(b), _CMP_EQ_OQ),
+                                     accumulator, minusOne);
+    }
+    else if constexpr(std::is_same_v<T, double>)
+    {
+        return _mm512_mask_sub_epi64(accumulator, _mm512_cmp_pd_mask(_mm512_castsi512_pd(a), _mm512_castsi512_pd(b), _CMP_EQ_OQ),
+                                     accumulator, minusOne);
+    }
+    else if constexpr(sizeof(T) == 1)
+    {
+        return _mm512_mask_sub_epi8(accumulator, _mm512_cmpeq_epi8_mask(a, b), accumulator, minusOne);
+    }
+    else if constexpr(sizeof(T) == 2)
+    {
+        return _mm512_mask_sub_epi16(accumulator, _mm512_cmpeq_epi16_mask(a, b), accumulator, minusOne);
+    }
+    else if constexpr(sizeof(T) == 4)
+    {
+        return _mm512_mask_sub_epi32(accumulator, _mm512_cmpeq_epi32_mask(a, b), accumulator, minusOne);
+    }
+    else
+    {
+        return _mm512_mask_sub_epi64(accumulator, _mm512_cmpeq_epi64_mask(a, b), accumulator, minusOne);
+    }
+}
+
+template<bool PerValue, typename T, std::size_t N>
+__attribute__((target("avx512f,avx512bw")))
+inline const T* countMatchesAvx512(const T* first, const T* last, const std::array<T, N>& needles,
+                                   std::array<std::size_t, N>& counts)
+{
+    constexpr std::size_t lanes{64 / sizeof(T)};
+    constexpr std::size_t accumulators{PerValue ? N : std::min(N, sharedAccumulators)};
+    constexpr std::size_t maxSteps{maxAccumulateSteps<T, (N + accumulators - 1) / accumulators>};
+
+    __m512i broadcast[N];
+    for(std::size_t k = 0; k < N; ++k)
+    {
+        broadcast[k] = broadcastAvx512(needles[k]);
+    }
+
+    while(static_cast<std::size_t>(last - first) >= lanes)
+    {
+        __m512i accumulator[accumulators];
+        for(auto& lane : accumulator)
+        {
+            lane = _mm512_setzero_si512();
+        }
+        const auto steps = std::min(maxSteps, static_cast<std::size_t>(last - first) / lanes);
+        for(std::size_t step = 0; step < steps; ++step, first += lanes)
+        {
+            const __m512i values = _mm512_loadu_si512(first);
+            for(std::size_t k = 0; k < N; ++k)
+            {
+                auto& lane = accumulator[k % accumulators];
+                lane = countEqualAvx512<T>(lane, values, broadcast[k]);
+            }
+        }
+        for(std::size_t k = 0; k < accumulators; ++k)
+        {
+            counts[k] += sumLanes<T, 64>(accumulator[k]);
+        }
+    }
+    return first;
+}
+
+inline bool cpuSupportsMatchKernel(MatchKernel kernel)
+{
+    __builtin_cpu_init();
+    switch(kernel)
+    {
+    case MatchKernel::Scalar:
+        return true;
+    case MatchKernel::Avx2:
+        return __builtin_cpu_supports("avx2");
+    case MatchKernel::Avx512:
+        return __builtin_cpu_supports("avx512f") and __builtin_cpu_supports("avx512bw");
+    }
+    return false;
+}
+#else
+inline bool cpuSupportsMatchKernel(MatchKernel kernel)
+{
+    return kernel == MatchKernel::Scalar;
+}
+#endif
+}
+
+inline bool isMatchKernelSupported(MatchKernel kernel)
+{
+    static const bool supported[]{true, detail::cpuSupportsMatchKernel(MatchKernel::Avx2),
+                                  detail::cpuSupportsMatchKernel(MatchKernel::Avx512)};
+    return supported[static_cast<std::size_t>(kernel)];
+}
+
+// Widest kernel this CPU supports, detected once.
+inline MatchKernel defaultMatchKernel()
+{
+    static const MatchKernel kernel = isMatchKernelSupported(MatchKernel::Avx512) ? MatchKernel::Avx512
+                                    : isMatchKernelSupported(MatchKernel::Avx2)   ? MatchKernel::Avx2
+                                                                                  : MatchKernel::Scalar;
+    return kernel;
+}
+
+namespace detail
+{
+template<bool PerValue, typename T, std::size_t N, typename... Args>
+inline void countLaneMatches(MatchKernel kernel, const T* first, const T* last, std::array<std::size_t, N>& counts,
+                             const Args&... args)
+{
+    const std::array<T, N> needles{static_cast<T>(args)...};
+    std::size_t k{};
+    // False when arg has no T equal to it, e.g. 300 against unsigned char elements.
+    const bool exact[]{matchesArg(needles[k++], args)...};
+    const bool shared = not PerValue and std::all_of(std::begin(exact), std::end(exact), [](bool e) { return e; });
+
+    switch(kernel)
+    {
+#ifdef UTILS_HAS_X86_MATCH_KERNELS
+    case MatchKernel::Avx512:
+        first = shared ? countMatchesAvx512<false>(first, last, needles, counts)
+                       : countMatchesAvx512<true>(first, last, needles, counts);
+        break;
+    case MatchKernel::Avx2:
+        first = shared ? countMatchesAvx2<false>(first, last, needles, counts)
+                       : countMatchesAvx2<true>(first, last, needles, counts);
+        break;
+#endif
+    default:
+        break;
+    }
+    countMatchesScalar(first, last, counts, args...);
+
+    // Needles that are not exact stand for values no element can equal.
+    for(k = 0; k < N; ++k)
+    {
+        counts[k] = exact[k] ? counts[k] : 0;
+    }
+}
+
+template<bool PerValue, typename Range, typename... Args>
+inline std::array<std::size_t, sizeof...(Args)> countMatches(MatchKernel kernel, const Range& range, const Args&... args)
+{
+    std::array<std::size_t, sizeof...(Args)> counts{};
+    if constexpr(traits::is_contiguous_range<const Range>)
+    {
+        using Element = std::remove_cv_t<std::remove_pointer_t<decltype(std::data(range))>>;
+        if constexpr((is_lane_comparable<Element, Args> and ...))
+        {
+            const auto* first = std::data(range);
+            countLaneMatches<PerValue>(kernel, first, first + std::size(range), counts, args...);
+            return counts;
+        }
+    }
+    for(const auto& element : range)
+    {
+        std::size_t k{};
+        ((counts[k++] += static_cast<std::size_t>(matchesArg(element, args))), ...);
+    }
+    return counts;
+}
+}
+
+// Number of elements of range equal to each of the values, counted in a single pass.
+// Contiguous ranges of integers, enums, float and double compare a whole vector of elements
+// against every value per step, other ranges compare each element against every value.
+template<typename Range, typename Arg, typename... Args>
+inline std::array<std::size_t, 1 + sizeof...(Args)> matchCounts(MatchKernel kernel, const Range& range,
+                                                                const Arg& arg, const Args&... args)
+{
+    return detail::countMatches<true>(kernel, range, arg, args...);
+}
+
+template<typename Range, typename Arg, typename... Args>
+inline std::array<std::size_t, 1 + sizeof...(Args)> matchCounts(const Range& range, const Arg& arg, const Args&... args)
+{
+    return matchCounts(defaultMatchKernel(), range, arg, args...);
+}
+
+// (std::count(range, arg) + ... + std::count(range, args)) in a single pass, values given
+// twice are counted twice.
+template<typename Range, typename Arg, typename... Args>
+inline std::size_t matches(MatchKernel kernel, const Range& range, const Arg& arg, const Args&... args)
+{
+    const auto counts = detail::countMatches<false>(kernel, range, arg, args...);
+    std::size_t total{};
+    for(auto count : counts)
+    {
+        total += count;
+    }
+    return total;
+}
+
+template<typename Range, typename Arg, typename... Args>
+inline std::size_t matches(const Range& range, const Arg& arg, const Args&... args)
+{
+    return matches(defaultMatchKernel(), range, arg, args...);
+}
+}
@@ -0,0 +1,145 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <memory_resource>
+#include <new>
+
+namespace utils
+{
+// Bump allocator for request-scoped memory: allocation moves a pointer, deallocation does
+// nothing and everything is given back at once by reset() or release(). Starts in an
+// optional caller buffer, then takes geometrically growing chunks from upstream.
+// Not thread safe, like std::pmr::monotonic_buffer_resource.
+class MonotonicArena : public std::pmr::memory_resource
+{
+public:
+    explicit MonotonicArena(std::size_t chunkSize = 4096,
+                            std::pmr::memory_resource* upstream = std::pmr::get_default_resource())
+        : upstream_{upstream}, nextChunkSize_{std::max(chunkSize, minChunkSize)}
+    {}
+
+    MonotonicArena(void* buffer, std::size_t size,
+                   std::pmr::memory_resource* upstream = std::pmr::get_default_resource())
+        : upstream_{upstream},
+          buffer_{static_cast<std::byte*>(buffer)},
+          bufferSize_{size},
+          current_{buffer_},
+          end_{buffer_ + size},
+          nextChunkSize_{std::max(size, minChunkSize)}
+    {}
+
+    MonotonicArena(const MonotonicArena&) = delete;
+    MonotonicArena& operator=(const MonotonicArena&) = delete;
+
+    ~MonotonicArena() override
+    {
+        release();
+    }
+
+    // Rewinds to the start and keeps the last, largest chunk, so a request that needed as
+    // much memory as the previous one does not go upstream again.
+    void reset()
+    {
+        if(chunks_ == nullptr)
+        {
+            current_ = buffer_;
+            end_ = buffer_ + bufferSize_;
+            return;
+        }
+        releaseChunks(chunks_->next);
+        chunks_->next = nullptr;
+        current_ = chunks_->begin();
+        end_ = chunks_->end();
+    }
+
+    // Gives every chunk back to upstream.
+    void release()
+    {
+        releaseChunks(chunks_);
+        chunks_ = nullptr;
+        current_ = buffer_;
+        end_ = buffer_ + bufferSize_;
+    }
+
+    std::pmr::memory_resource* upstream_resource() const { return upstream_; }
+
+    // Chunks taken from upstream since construction, for tests and benchmarks.
+    std::size_t upstream_allocations() const { return upstreamAllocations_; }
+
+private:
+    struct Chunk
+    {
+        Chunk* next;
+        std::size_t size; // including this header
+
+        std::byte* begin() { return reinterpret_cast<std::byte*>(this) + sizeof(Chunk); }
+        std::byte* end() { return reinterpret_cast<std::byte*>(this) + size; }
+    };
+
+    static constexpr std::size_t minChunkSize{256};
+
+    void* do_allocate(std::size_t bytes, std::size_t alignment) override
+    {
+        if(auto* result = bump(bytes, alignment))
+        {
+            return result;
+        }
+        addChunk(bytes + alignment);
+        return bump(bytes, alignment);
+    }
+
+    void do_deallocate(void*, std::size_t, std::size_t) override
+    {}
+
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override
+    {
+        return this == &other;
+    }
+
+    void* bump(std::size_t bytes, std::size_t alignment)
+    {
+        const auto address = reinterpret_cast<std::uintptr_t>(current_);
+        const auto aligned = (address + alignment - 1) & ~(alignment - 1);
+        if(current_ == nullptr or aligned + bytes > reinterpret_cast<std::uintptr_t>(end_))
+        {
+            return nullptr;
+        }
+        current_ += aligned - address + bytes;
+        return reinterpret_cast<void*>(aligned);
+    }
+
+    void addChunk(std::size_t required)
+    {
+        const auto size = std::max(nextChunkSize_, required + sizeof(Chunk));
+        auto* chunk = static_cast<Chunk*>(upstream_->allocate(size, alignof(std::max_align_t)));
+        chunk->next = chunks_;
+        chunk->size = size;
+        chunks_ = chunk;
+        current_ = chunk->begin();
+        end_ = chunk->end();
+        nextChunkSize_ = 2 * size;
+        ++upstreamAllocations_;
+    }
+
+    void releaseChunks(Chunk* chunk)
+    {
+        while(chunk != nullptr)
+        {
+            auto* next = chunk->next;
+            upstream_->deallocate(chunk, chunk->size, alignof(std::max_align_t));
+            chunk = next;
+        }
+    }
+
+    std::pmr::memory_resource* upstream_;
+    std::byte* buffer_{};
+    std::size_t bufferSize_{};
+    std::byte* current_{};
+    std::byte* end_{};
+    Chunk* chunks_{};
+    std::size_t nextChunkSize_;
+    std::size_t upstreamAllocations_{};
+};
+}
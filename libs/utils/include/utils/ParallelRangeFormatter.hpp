@@ -0,0 +1,145 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <future>
+#include <ios>
+#include <iterator>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <type_traits>
+#include <vector>
+#include "traits/IsRandomAccessRange.hpp"
+#include "utils/RangeFormatter.hpp"
+#include "utils/RangePrinter.hpp"
+
+namespace utils
+{
+namespace detail
+{
+// Below this many elements per thread spawning workers costs more than it saves.
+constexpr std::size_t minParallelChunkSize{1 << 14};
+
+inline std::size_t resolveThreadCount(std::size_t threads)
+{
+    return threads != 0 ? threads : std::max(1u, std::thread::hardware_concurrency());
+}
+
+// formatChunks() prints what a stream with the default flags, precision and grouping
+// would, anything else has to go through operator<< element by element.
+inline bool hasDefaultFormatting(const std::ostream& stream)
+{
+    constexpr auto floatFlags = std::ios_base::floatfield | std::ios_base::showpoint | std::ios_base::uppercase;
+    return hasDefaultIntegerFormatting(stream) and (stream.flags() & (floatFlags | std::ios_base::boolalpha)) == 0 and
+           stream.precision() == 6;
+}
+
+// Formats [begin, end) split into consecutive chunks, one worker per chunk. Every
+// chunk but the first starts with the delimiter, so concatenating the chunks in
+// order gives exactly the text writeElements() would produce.
+template<typename Style = DefaultStyle, typename Iterator>
+std::vector<std::string> formatChunks(Iterator begin, Iterator end, std::string_view delimiter, std::size_t threads)
+{
+    const auto size = static_cast<std::size_t>(std::distance(begin, end));
+    const auto chunks = std::max<std::size_t>(1, std::min(resolveThreadCount(threads), size / minParallelChunkSize));
+    const auto chunkSize = size / chunks;
+
+    auto formatChunk = [=](std::size_t index) {
+        auto first = begin + static_cast<std::ptrdiff_t>(index * chunkSize);
+        auto last = index + 1 == chunks ? end : first + static_cast<std::ptrdiff_t>(chunkSize);
+
+        std::string text;
+        StringWriter writer{text};
+        if(index != 0)
+        {
+            writer.write(delimiter);
+        }
+        writeElements<Style>(writer, first, last, delimiter);
+        return text;
+    };
+
+    std::vector<std::future<std::string>> workers;
+    for(std::size_t index = 1; index < chunks; ++index)
+    {
+        workers.push_back(std::async(std::launch::async, formatChunk, index));
+    }
+
+    std::vector<std::string> texts;
+    texts.reserve(chunks);
+    texts.push_back(formatChunk(0));
+    for(auto& worker : workers)
+    {
+        texts.push_back(worker.get());
+    }
+    return texts;
+}
+}
+
+template<typename Iterator, typename Style = DefaultStyle>
+struct ParallelRangePrinter : RangePrinter<Iterator, Style>
+{
+    ParallelRangePrinter(Iterator begin, Iterator end, std::string_view delimiter, std::size_t threads)
+        : RangePrinter<Iterator, Style>{std::move(begin), std::move(end), delimiter}, threads_{threads}
+    {}
+
+    friend std::ostream& operator<<(std::ostream& stream, const ParallelRangePrinter& printer)
+    {
+        if(not detail::hasDefaultFormatting(stream))
+        {
+            return stream << static_cast<const RangePrinter<Iterator, Style>&>(printer);
+        }
+        detail::writeOpening(stream, Style::open);
+        for(const auto& text :
+            detail::formatChunks<Style>(printer.begin_, printer.end_, printer.delimiter_, printer.threads_))
+        {
+            detail::writeLiteral(stream, text);
+        }
+        return detail::writeLiteral(stream, Style::close);
+    }
+private:
+    std::size_t threads_;
+};
+
+// Same output as printRange, the elements are formatted on up to threads workers
+// (0 means one per hardware thread) and streamed out in order.
+template<typename Range>
+inline auto printRangeParallel(const Range& range, std::size_t threads = 0, const char* delimiter = ", ")
+{
+    static_assert(traits::is_random_access_range<const Range>, "parallel formatting requires a random access range");
+    return ParallelRangePrinter{detail::rangeBegin(range), detail::rangeEnd(range), delimiter, threads};
+}
+
+template<typename Style, typename Range, typename std::enable_if_t<detail::is_print_style<Style>, int> = 0>
+inline auto printRangeParallel(const Range& range, std::size_t threads = 0)
+{
+    static_assert(traits::is_random_access_range<const Range>, "parallel formatting requires a random access range");
+    return ParallelRangePrinter<decltype(detail::rangeBegin(range)), Style>{detail::rangeBegin(range),
+                                                                           detail::rangeEnd(range), Style::delimiter,
+                                                                           threads};
+}
+
+template<typename Range>
+inline std::string formatRangeParallel(const Range& range, std::size_t threads = 0, const char* delimiter = ", ")
+{
+    static_assert(traits::is_random_access_range<const Range>, "parallel formatting requires a random access range");
+    auto texts = detail::formatChunks(detail::rangeBegin(range), detail::rangeEnd(range), delimiter, threads);
+
+    std::size_t size{DefaultStyle::open.size() + DefaultStyle::close.size()};
+    for(const auto& text : texts)
+    {
+        size += text.size();
+    }
+
+    std::string result;
+    result.reserve(size);
+    result.append(DefaultStyle::open);
+    for(const auto& text : texts)
+    {
+        result.append(text);
+    }
+    result.append(DefaultStyle::close);
+    return result;
+}
+}
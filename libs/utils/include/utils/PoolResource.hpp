@@ -0,0 +1,131 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <memory_resource>
+#include <new>
+
+namespace utils
+{
+// Free lists of power-of-two blocks from 16 bytes to 4 KiB, carved out of chunks taken
+// from upstream. Unlike MonotonicArena it reuses what is deallocated, which suits growing
+// containers: a buffer given back on growth serves the next request of its size. Larger
+// or over-aligned requests go straight to upstream. Not thread safe, like
+// std::pmr::unsynchronized_pool_resource.
+class PoolResource : public std::pmr::memory_resource
+{
+public:
+    explicit PoolResource(std::pmr::memory_resource* upstream = std::pmr::get_default_resource())
+        : upstream_{upstream}
+    {
+        blocksPerChunk_.fill(minBlocksPerChunk);
+    }
+
+    PoolResource(const PoolResource&) = delete;
+    PoolResource& operator=(const PoolResource&) = delete;
+
+    ~PoolResource() override
+    {
+        release();
+    }
+
+    // Gives every chunk back to upstream, blocks handed out become invalid.
+    void release()
+    {
+        while(chunks_ != nullptr)
+        {
+            auto* next = chunks_->next;
+            upstream_->deallocate(chunks_, chunks_->size, alignof(std::max_align_t));
+            chunks_ = next;
+        }
+        freeLists_.fill(nullptr);
+        blocksPerChunk_.fill(minBlocksPerChunk);
+    }
+
+    std::pmr::memory_resource* upstream_resource() const { return upstream_; }
+
+private:
+    struct Block
+    {
+        Block* next;
+    };
+
+    struct Chunk
+    {
+        Chunk* next;
+        std::size_t size; // including this header
+    };
+
+    static constexpr std::size_t minBlockShift{4};
+    static constexpr std::size_t maxBlockShift{12};
+    static constexpr std::size_t poolCount{maxBlockShift - minBlockShift + 1};
+    static constexpr std::size_t minBlocksPerChunk{8};
+    static constexpr std::size_t maxBlocksPerChunk{256};
+
+    static std::size_t poolIndex(std::size_t bytes)
+    {
+        const auto size = std::max<std::size_t>(bytes, 1);
+        const auto shift = static_cast<std::size_t>(64 - __builtin_clzll((size - 1) | 1));
+        return shift <= minBlockShift ? 0 : shift - minBlockShift;
+    }
+
+    static std::size_t blockSize(std::size_t index) { return std::size_t{1} << (index + minBlockShift); }
+
+    void* do_allocate(std::size_t bytes, std::size_t alignment) override
+    {
+        if(bytes > blockSize(poolCount - 1) or alignment > alignof(std::max_align_t))
+        {
+            return upstream_->allocate(bytes, alignment);
+        }
+        const auto index = poolIndex(bytes);
+        if(freeLists_[index] == nullptr)
+        {
+            refill(index);
+        }
+        auto* block = freeLists_[index];
+        freeLists_[index] = block->next;
+        return block;
+    }
+
+    void do_deallocate(void* pointer, std::size_t bytes, std::size_t alignment) override
+    {
+        if(bytes > blockSize(poolCount - 1) or alignment > alignof(std::max_align_t))
+        {
+            return upstream_->deallocate(pointer, bytes, alignment);
+        }
+        const auto index = poolIndex(bytes);
+        auto* block = static_cast<Block*>(pointer);
+        block->next = freeLists_[index];
+        freeLists_[index] = block;
+    }
+
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override
+    {
+        return this == &other;
+    }
+
+    // Chunks of a pool double in size up to maxBlocksPerChunk blocks.
+    void refill(std::size_t index)
+    {
+        const auto size = blockSize(index);
+        const auto blocks = blocksPerChunk_[index];
+        const auto header = std::max(sizeof(Chunk), alignof(std::max_align_t));
+        auto* memory = static_cast<std::byte*>(upstream_->allocate(header + blocks * size, alignof(std::max_align_t)));
+        chunks_ = ::new(memory) Chunk{chunks_, header + blocks * size};
+
+        Block* list{};
+        for(std::size_t block = blocks; block-- > 0;)
+        {
+            list = ::new(memory + header + block * size) Block{list};
+        }
+        freeLists_[index] = list;
+        blocksPerChunk_[index] = std::min(2 * blocks, maxBlocksPerChunk);
+    }
+
+    std::pmr::memory_resource* upstream_;
+    Chunk* chunks_{};
+    std::array<Block*, poolCount> freeLists_{};
+    std::array<std::size_t, poolCount> blocksPerChunk_;
+};
+}
@@ -0,0 +1,479 @@
+#pragma once
+
+#include <algorithm>
+#include <charconv>
+#include <cmath>
+#include <cstddef>
+#include <cstring>
+#include <iterator>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include "traits/IsIterable.hpp"
+#include "traits/IsStringLike.hpp"
+#include "traits/TieFields.hpp"
+#include "utils/IntegerFormatting.hpp"
+#include "utils/JsonEscape.hpp"
+#include "utils/RangePrinter.hpp"
+
+namespace utils
+{
+namespace detail
+{
+template<typename T>
+constexpr bool is_character_v = std::is_same_v<T, char> or
+                                std::is_same_v<T, signed char> or
+                                std::is_same_v<T, unsigned char>;
+
+// Mirrors what the default-formatted std::ostream prints for arithmetic values:
+// characters as themselves, bool as 0/1 and floating point as "%g" with precision 6.
+template<typename T>
+inline std::to_chars_result toChars(char* first, char* last, T value)
+{
+    if constexpr(std::is_same_v<T, bool> or is_character_v<T>)
+    {
+        if(first == last)
+        {
+            return {last, std::errc::value_too_large};
+        }
+        *first = std::is_same_v<T, bool> ? static_cast<char>('0' + value) : static_cast<char>(value);
+        return {first + 1, std::errc{}};
+    }
+    else if constexpr(std::is_floating_point_v<T>)
+    {
+        return std::to_chars(first, last, value, std::chars_format::general, 6);
+    }
+    else
+    {
+        return std::to_chars(first, last, value);
+    }
+}
+
+template<typename T>
+inline std::size_t countDigits(T value)
+{
+    std::size_t digits{1};
+    for(; value >= 10000; value /= 10000)
+    {
+        digits += 4;
+    }
+    return digits + (value >= 10) + (value >= 100) + (value >= 1000);
+}
+
+// Length of toChars() output, integers are counted without formatting them.
+template<typename T>
+inline std::size_t charsCount(T value)
+{
+    if constexpr(std::is_same_v<T, bool> or is_character_v<T>)
+    {
+        return 1;
+    }
+    else if constexpr(std::is_floating_point_v<T>)
+    {
+        char buffer[32];
+        return static_cast<std::size_t>(toChars(buffer, buffer + sizeof(buffer), value).ptr - buffer);
+    }
+    else if constexpr(std::is_signed_v<T>)
+    {
+        using Unsigned = std::make_unsigned_t<T>;
+        return value < 0 ? 1 + countDigits(static_cast<Unsigned>(Unsigned{0} - static_cast<Unsigned>(value)))
+                         : countDigits(static_cast<Unsigned>(value));
+    }
+    else
+    {
+        return countDigits(value);
+    }
+}
+}
+
+// Writes into a caller supplied [first, last) buffer. Once a write does not fit
+// the writer is marked as overflowed and ignores everything that follows.
+class BufferWriter
+{
+public:
+    BufferWriter(char* first, char* last)
+        : first_{first}, current_{first}, last_{last}
+    {}
+
+    void put(char c)
+    {
+        if(current_ == last_)
+        {
+            return markOverflow();
+        }
+        *current_++ = c;
+    }
+
+    void write(std::string_view text)
+    {
+        if(text.size() > static_cast<std::size_t>(last_ - current_))
+        {
+            return markOverflow();
+        }
+        std::memcpy(current_, text.data(), text.size());
+        current_ += text.size();
+    }
+
+    template<typename T>
+    void writeArithmetic(T value)
+    {
+        auto [ptr, ec] = detail::toChars(current_, last_, value);
+        if(ec != std::errc{})
+        {
+            return markOverflow();
+        }
+        current_ = ptr;
+    }
+
+    // Runs formatIntegers() over as many elements as surely fit, the last few go one by one.
+    template<typename T>
+    void writeIntegers(const T* first, const T* last, std::string_view delimiter)
+    {
+        const auto perElement = maxFormattedIntegerSize<T> + delimiter.size();
+        while(first != last and not overflow_)
+        {
+            const auto available = static_cast<std::size_t>(last_ - current_);
+            const auto count = available < formatIntegersPadding
+                ? 0 : std::min(static_cast<std::size_t>(last - first), (available - formatIntegersPadding) / perElement);
+            if(count == 0)
+            {
+                writeArithmetic(*first++);
+            }
+            else
+            {
+                current_ = formatIntegers(first, first + count, delimiter, current_);
+                first += count;
+            }
+            if(first != last)
+            {
+                write(delimiter);
+            }
+        }
+    }
+
+    char* current() const { return current_; }
+    std::size_t size() const { return static_cast<std::size_t>(current_ - first_); }
+    bool overflow() const { return overflow_; }
+
+private:
+    void markOverflow()
+    {
+        current_ = last_;
+        overflow_ = true;
+    }
+
+    char* first_;
+    char* current_;
+    char* last_;
+    bool overflow_{};
+};
+
+// Counts the characters a BufferWriter would produce without writing any of them.
+class SizeCounter
+{
+public:
+    void put(char) { ++size_; }
+    void write(std::string_view text) { size_ += text.size(); }
+
+    template<typename T>
+    void writeArithmetic(T value) { size_ += detail::charsCount(value); }
+
+    std::size_t size() const { return size_; }
+
+private:
+    std::size_t size_{};
+};
+
+// Appends to a string, growing it as needed.
+class StringWriter
+{
+public:
+    explicit StringWriter(std::string& text)
+        : text_{text}
+    {}
+
+    void put(char c) { text_.push_back(c); }
+    void write(std::string_view text) { text_.append(text); }
+
+    template<typename T>
+    void writeArithmetic(T value)
+    {
+        char buffer[32];
+        text_.append(buffer, detail::toChars(buffer, buffer + sizeof(buffer), value).ptr);
+    }
+
+    template<typename T>
+    void writeIntegers(const T* first, const T* last, std::string_view delimiter)
+    {
+        const auto offset = text_.size();
+        text_.resize(offset + static_cast<std::size_t>(last - first) * (maxFormattedIntegerSize<T> + delimiter.size()) +
+                     formatIntegersPadding);
+        const auto end = formatIntegers(first, last, delimiter, text_.data() + offset);
+        text_.resize(static_cast<std::size_t>(end - text_.data()));
+    }
+
+private:
+    std::string& text_;
+};
+
+// Fixed capacity character storage living wherever the object lives (usually the stack).
+template<std::size_t Capacity>
+class InlineBuffer
+{
+public:
+    const char* data() const { return data_; }
+    std::size_t size() const { return size_; }
+    static constexpr std::size_t capacity() { return Capacity; }
+    std::string_view view() const { return {data_, size_}; }
+    void clear() { size_ = 0; }
+
+    BufferWriter writer() { return BufferWriter{data_ + size_, data_ + Capacity}; }
+    void commit(const BufferWriter& writer) { size_ += writer.size(); }
+
+private:
+    char data_[Capacity];
+    std::size_t size_{};
+};
+
+namespace detail
+{
+template<typename, typename, typename = void>
+constexpr bool has_write_integers{};
+
+template<typename Writer, typename Iterator>
+constexpr bool has_write_integers<
+    Writer,
+    Iterator,
+    std::void_t<decltype(std::declval<Writer&>().writeIntegers(std::declval<Iterator>(),
+                                                               std::declval<Iterator>(),
+                                                               std::string_view{}))>
+> = true;
+}
+
+template<typename Style = DefaultStyle, typename Writer, typename Iterator, typename Sentinel>
+inline void writeElements(Writer& writer, Iterator begin, Sentinel end, std::string_view delimiter)
+{
+    if constexpr(detail::uses_integer_kernel<Iterator> and std::is_same_v<Iterator, Sentinel> and
+                 detail::has_write_integers<Writer, Iterator>)
+    {
+        writer.writeIntegers(begin, end, delimiter);
+    }
+    else if(begin != end)
+    {
+        writeValue(writer, makeValuePrinter<Style>(*begin));
+        while(++begin != end)
+        {
+            writer.write(delimiter);
+            writeValue(writer, makeValuePrinter<Style>(*begin));
+        }
+    }
+}
+
+template<typename Style = DefaultStyle, typename Writer, typename Iterator, typename Sentinel>
+inline void writeRange(Writer& writer, Iterator begin, Sentinel end, std::string_view delimiter)
+{
+    writer.write(Style::open);
+    writeElements<Style>(writer, std::move(begin), std::move(end), delimiter);
+    writer.write(Style::close);
+}
+
+template<typename Writer, typename Key, typename Value, typename Style>
+inline void writeValue(Writer& writer, const ValuePrinter<std::pair<Key, Value>, Style>& obj)
+{
+    writer.write(Style::pairOpen);
+    writeValue(writer, makeValuePrinter<Style>(obj.value.first));
+    writer.write(Style::pairDelimiter);
+    writeValue(writer, makeValuePrinter<Style>(obj.value.second));
+    writer.write(Style::pairClose);
+}
+
+namespace detail
+{
+template<typename Writer>
+inline void writeQuotedTo(Writer& writer, std::string_view text)
+{
+    writer.write("\"");
+    escapeJson(text, [&writer](std::string_view piece) { writer.write(piece); });
+    writer.write("\"");
+}
+}
+
+// Quoting styles get the same JSON text as on the std::ostream path.
+template<typename Writer, typename T, typename Style, typename std::enable_if_t<traits::is_string_like<T>, int> = 0>
+inline void writeValue(Writer& writer, const ValuePrinter<T, Style>& obj)
+{
+    if constexpr(detail::quotes_strings<Style>)
+    {
+        detail::writeQuotedTo(writer, obj.value);
+    }
+    else
+    {
+        writer.write(obj.value);
+    }
+}
+
+template<typename Writer, typename T, typename Style,
+         typename std::enable_if_t<traits::is_iterable<T> and not traits::is_string_like<T>, int> = 0>
+inline void writeValue(Writer& writer, const ValuePrinter<T, Style>& obj)
+{
+    writeRange<Style>(writer, detail::rangeBegin(obj.value), detail::rangeEnd(obj.value), Style::delimiter);
+}
+
+template<typename Writer, typename T, typename Style, typename std::enable_if_t<std::is_arithmetic_v<T>, int> = 0>
+inline void writeValue(Writer& writer, const ValuePrinter<T, Style>& obj)
+{
+    if constexpr(detail::quotes_strings<Style> and std::is_same_v<T, bool>)
+    {
+        writer.write(obj.value ? "true" : "false");
+    }
+    else if constexpr(detail::quotes_strings<Style> and
+                      (std::is_same_v<T, char> or std::is_same_v<T, signed char> or std::is_same_v<T, unsigned char>))
+    {
+        const auto c = static_cast<char>(obj.value);
+        detail::writeQuotedTo(writer, std::string_view(&c, 1));
+    }
+    else if constexpr(detail::quotes_strings<Style> and std::is_floating_point_v<T>)
+    {
+        if(std::isfinite(obj.value))
+        {
+            writer.writeArithmetic(obj.value);
+        }
+        else
+        {
+            writer.write("null");
+        }
+    }
+    else
+    {
+        writer.writeArithmetic(obj.value);
+    }
+}
+
+template<typename Writer, typename T, typename Style, typename std::enable_if_t<detail::is_printable_aggregate<T>, int> = 0>
+inline void writeValue(Writer& writer, const ValuePrinter<T, Style>& obj)
+{
+    writer.write(Style::pairOpen);
+    std::apply([&writer](const auto& first, const auto&... rest) {
+        writeValue(writer, makeValuePrinter<Style>(first));
+        ((writer.write(Style::pairDelimiter), writeValue(writer, makeValuePrinter<Style>(rest))), ...);
+    }, detail::printedFields(obj.value));
+    writer.write(Style::pairClose);
+}
+
+namespace detail
+{
+template<typename>
+constexpr bool is_written_pair{};
+
+template<typename Key, typename Value>
+constexpr bool is_written_pair<std::pair<Key, Value>> = true;
+
+template<typename T>
+constexpr bool isWriterFormattable();
+
+template<typename Tuple, std::size_t... Is>
+constexpr bool areWriterFormattable(std::index_sequence<Is...>)
+{
+    return (isWriterFormattable<std::remove_cv_t<std::remove_reference_t<std::tuple_element_t<Is, Tuple>>>>() and ...);
+}
+
+// Whether writeValue() handles T all the way down. Its overloads only look at the outer
+// type, a vector of something with just an operator<< would fail inside writeRange().
+template<typename T>
+constexpr bool isWriterFormattable()
+{
+    if constexpr(is_written_pair<T>)
+    {
+        return isWriterFormattable<std::remove_cv_t<typename T::first_type>>() and
+               isWriterFormattable<std::remove_cv_t<typename T::second_type>>();
+    }
+    else if constexpr(traits::is_string_like<T> or std::is_arithmetic_v<T>)
+    {
+        return true;
+    }
+    else if constexpr(traits::is_iterable<T>)
+    {
+        return isWriterFormattable<std::remove_cv_t<std::remove_reference_t<decltype(*rangeBegin(std::declval<const T&>()))>>>();
+    }
+    else if constexpr(is_printable_aggregate<T>)
+    {
+        using Fields = decltype(printedFields(std::declval<const T&>()));
+        return areWriterFormattable<Fields>(std::make_index_sequence<std::tuple_size_v<Fields>>{});
+    }
+    else
+    {
+        return false;
+    }
+}
+
+template<typename T>
+constexpr bool is_writer_formattable = isWriterFormattable<T>();
+}
+
+// Formats range into [first, last) without touching iostreams or the heap.
+// Produces the same text as printRange, on failure returns {last, value_too_large}.
+template<typename Range>
+inline std::to_chars_result formatRangeTo(char* first, char* last, const Range& range, const char* delimiter = ", ")
+{
+    BufferWriter writer{first, last};
+    writeRange(writer, detail::rangeBegin(range), detail::rangeEnd(range), delimiter);
+    if(writer.overflow())
+    {
+        return {last, std::errc::value_too_large};
+    }
+    return {writer.current(), std::errc{}};
+}
+
+// Appends formatted range to buffer, leaves the buffer untouched when the text does not fit.
+template<std::size_t Capacity, typename Range>
+inline bool formatRangeTo(InlineBuffer<Capacity>& buffer, const Range& range, const char* delimiter = ", ")
+{
+    auto writer = buffer.writer();
+    writeRange(writer, detail::rangeBegin(range), detail::rangeEnd(range), delimiter);
+    if(writer.overflow())
+    {
+        return false;
+    }
+    buffer.commit(writer);
+    return true;
+}
+
+// Exact length of the text printRange/formatRangeTo produce for range.
+template<typename Range>
+inline std::size_t formattedSize(const Range& range, const char* delimiter = ", ")
+{
+    SizeCounter counter;
+    writeRange(counter, detail::rangeBegin(range), detail::rangeEnd(range), delimiter);
+    return counter.size();
+}
+
+namespace detail
+{
+template<typename Range>
+constexpr bool is_single_pass_range = not std::is_base_of_v<
+    std::forward_iterator_tag,
+    typename std::iterator_traits<decltype(rangeBegin(std::declval<const Range&>()))>::iterator_category>;
+}
+
+// Formats range into a string allocated once with formattedSize() bytes. Single pass
+// ranges, e.g. generators, can not be measured first and are streamed instead.
+template<typename Range>
+inline std::string formatRange(const Range& range, const char* delimiter = ", ")
+{
+    if constexpr(detail::is_single_pass_range<Range>)
+    {
+        std::ostringstream stream;
+        stream << printRange(range, delimiter);
+        return stream.str();
+    }
+    else
+    {
+        std::string text(formattedSize(range, delimiter), '\0');
+        formatRangeTo(text.data(), text.data() + text.size(), range, delimiter);
+        return text;
+    }
+}
+}
@@ -0,0 +1,261 @@
+#pragma once
+
+#include <charconv>
+#include <cstddef>
+#include <cstring>
+#include <iterator>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <type_traits>
+#include <utility>
+#include "traits/IsIterable.hpp"
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+namespace utils
+{
+namespace detail
+{
+template<typename T>
+struct parsed_type
+{
+    using type = T;
+};
+
+// Map nodes hold std::pair<const Key, Value>, parse into a mutable pair and insert that.
+template<typename Key, typename Value>
+struct parsed_type<std::pair<Key, Value>>
+{
+    using type = std::pair<std::remove_const_t<Key>, typename parsed_type<Value>::type>;
+};
+
+template<typename T>
+using parsed_type_t = typename parsed_type<T>::type;
+
+template<typename>
+constexpr bool is_std_pair{};
+
+template<typename Key, typename Value>
+constexpr bool is_std_pair<std::pair<Key, Value>> = true;
+
+template<typename T>
+constexpr bool is_parsed_string = std::is_same_v<T, std::string> or std::is_same_v<T, std::string_view>;
+
+template<typename>
+constexpr bool dependent_false{};
+
+// First position in [first, last) holding a or b, last when there is none.
+inline const char* findFirstOf(const char* first, const char* last, char a, char b)
+{
+#if defined(__SSE2__)
+    const __m128i aMask = _mm_set1_epi8(a);
+    const __m128i bMask = _mm_set1_epi8(b);
+    for(; last - first >= 16; first += 16)
+    {
+        const __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(first));
+        const int found = _mm_movemask_epi8(_mm_or_si128(_mm_cmpeq_epi8(chunk, aMask), _mm_cmpeq_epi8(chunk, bMask)));
+        if(found != 0)
+        {
+            return first + __builtin_ctz(static_cast<unsigned>(found));
+        }
+    }
+#endif
+    for(; first != last; ++first)
+    {
+        if(*first == a or *first == b)
+        {
+            return first;
+        }
+    }
+    return last;
+}
+
+// Reverses the ValuePrinter grammar: "[a, b]" for ranges, "{a, b}" for pairs, raw text
+// for strings and std::to_chars/operator<< text for arithmetic values. Strings end at the
+// separator or closing bracket that follows them, so they cannot contain either.
+class RangeParser
+{
+public:
+    RangeParser(const char* first, const char* last)
+        : current_{first}, last_{last}
+    {}
+
+    const char* current() const { return current_; }
+    bool failed() const { return failed_; }
+
+    template<typename Container>
+    void parseRange(Container& container, std::string_view delimiter)
+    {
+        if(not consume('['))
+        {
+            return;
+        }
+        if(consume(']', false))
+        {
+            return;
+        }
+        do
+        {
+            parsed_type_t<typename Container::value_type> element{};
+            parseValue(element, delimiter, ']');
+            if(failed_)
+            {
+                return;
+            }
+            container.insert(container.end(), std::move(element));
+        }
+        while(consume(delimiter, false));
+        consume(']');
+    }
+
+private:
+    template<typename T>
+    void parseValue(T& value, std::string_view separator, char closer)
+    {
+        if constexpr(is_std_pair<T>)
+        {
+            if(consume('{'))
+            {
+                parseValue(value.first, ", ", '}');
+                if(consume(", "))
+                {
+                    parseValue(value.second, ", ", '}');
+                    consume('}');
+                }
+            }
+        }
+        else if constexpr(is_parsed_string<T>)
+        {
+            value = T(parseText(separator, closer));
+        }
+        else if constexpr(traits::is_iterable<T>)
+        {
+            parseRange(value, ", ");
+        }
+        else if constexpr(std::is_same_v<T, bool>)
+        {
+            if(current_ == last_ or (*current_ != '0' and *current_ != '1'))
+            {
+                return fail();
+            }
+            value = *current_++ == '1';
+        }
+        else if constexpr(std::is_same_v<T, char> or std::is_same_v<T, signed char> or std::is_same_v<T, unsigned char>)
+        {
+            if(current_ == last_)
+            {
+                return fail();
+            }
+            value = static_cast<T>(*current_++);
+        }
+        else if constexpr(std::is_arithmetic_v<T>)
+        {
+            auto [ptr, ec] = std::from_chars(current_, last_, value);
+            if(ec != std::errc{})
+            {
+                return fail();
+            }
+            current_ = ptr;
+        }
+        else
+        {
+            static_assert(dependent_false<T>, "type is not supported by parseRange");
+        }
+    }
+
+    std::string_view parseText(std::string_view separator, char closer)
+    {
+        const auto begin = current_;
+        auto position = current_;
+        while(true)
+        {
+            position = findFirstOf(position, last_, separator.front(), closer);
+            if(position == last_ or *position == closer or
+               std::string_view(position, static_cast<std::size_t>(last_ - position)).substr(0, separator.size()) == separator)
+            {
+                break;
+            }
+            ++position;
+        }
+        current_ = position;
+        return {begin, static_cast<std::size_t>(position - begin)};
+    }
+
+    bool consume(char expected, bool required = true)
+    {
+        if(current_ == last_ or *current_ != expected)
+        {
+            if(required)
+            {
+                fail();
+            }
+            return false;
+        }
+        ++current_;
+        return true;
+    }
+
+    bool consume(std::string_view expected, bool required = true)
+    {
+        if(static_cast<std::size_t>(last_ - current_) < expected.size() or
+           std::memcmp(current_, expected.data(), expected.size()) != 0)
+        {
+            if(required)
+            {
+                fail();
+            }
+            return false;
+        }
+        current_ += expected.size();
+        return true;
+    }
+
+    void fail()
+    {
+        failed_ = true;
+    }
+
+    const char* current_;
+    const char* last_;
+    bool failed_{};
+};
+}
+
+// Parses text written by printRange/formatRangeTo at [first, last) and appends the elements
+// to container. Containers of std::string_view point into the input instead of copying.
+// On failure returns {position of the error, invalid_argument}, an empty delimiter fails
+// at first as strings would have nothing to end at.
+template<typename Container>
+inline std::from_chars_result parseRangeFrom(const char* first, const char* last, Container& container,
+                                             const char* delimiter = ", ")
+{
+    if(*delimiter == '\0')
+    {
+        return {first, std::errc::invalid_argument};
+    }
+    detail::RangeParser parser{first, last};
+    parser.parseRange(container, delimiter);
+    if(parser.failed())
+    {
+        return {parser.current(), std::errc::invalid_argument};
+    }
+    return {parser.current(), std::errc{}};
+}
+
+// Parses the whole text as a single range, nothing may follow the closing bracket.
+template<typename Container>
+inline std::optional<Container> parseRange(std::string_view text, const char* delimiter = ", ")
+{
+    Container container{};
+    auto [ptr, ec] = parseRangeFrom(text.data(), text.data() + text.size(), container, delimiter);
+    if(ec != std::errc{} or ptr != text.data() + text.size())
+    {
+        return std::nullopt;
+    }
+    return container;
+}
+}
@@ -1,75 +1,734 @@
 #pragma once
 
+#include <algorithm>
+#include <charconv>
+#include <cmath>
+#include <cstddef>
+#include <ios>
+#include <iterator>
+#include <limits>
+#include <locale>
 #include <ostream>
+#include <streambuf>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include "traits/FieldCount.hpp"
+#include "traits/IsContiguousRange.hpp"
 #include "traits/IsIterable.hpp"
+#include "traits/IsSizedRange.hpp"
+#include "traits/IsStringLike.hpp"
+#include "traits/TieFields.hpp"
+#include "utils/IntegerFormatting.hpp"
+#include "utils/JsonEscape.hpp"
 
 namespace utils
 {
+namespace detail
+{
+// Contiguous ranges are walked with plain pointers, which lets the printers
+// recognise them and switch to bulk paths such as formatIntegers().
+template<typename Range>
+inline auto rangeBegin(const Range& range)
+{
+    if constexpr(traits::is_contiguous_range<const Range>)
+    {
+        return std::data(range);
+    }
+    else
+    {
+        return std::begin(range);
+    }
+}
+
+template<typename Range>
+inline auto rangeEnd(const Range& range)
+{
+    if constexpr(traits::is_contiguous_range<const Range>)
+    {
+        return std::data(range) + std::size(range);
+    }
+    else
+    {
+        return std::end(range);
+    }
+}
+
+template<typename Iterator>
+constexpr bool uses_integer_kernel = std::is_pointer_v<Iterator> and
+                                     is_kernel_integer_v<std::remove_cv_t<std::remove_pointer_t<Iterator>>>;
+
+template<typename Iterator, typename = void>
+constexpr bool uses_staged_integer_kernel = false;
+
+// Single pass iterators over integers, e.g. a generator<int>, can not be formatted in place.
+template<typename Iterator>
+constexpr bool uses_staged_integer_kernel<Iterator, std::void_t<typename std::iterator_traits<Iterator>::iterator_category>> =
+    std::is_same_v<typename std::iterator_traits<Iterator>::iterator_category, std::input_iterator_tag> and
+    is_kernel_integer_v<typename std::iterator_traits<Iterator>::value_type>;
+
+// formatIntegers() matches operator<< only for decimal output without grouping.
+inline bool hasDefaultIntegerFormatting(const std::ostream& stream)
+{
+    constexpr auto relevantFlags = std::ios_base::basefield | std::ios_base::showpos | std::ios_base::showbase;
+    return (stream.flags() & relevantFlags) == std::ios_base::dec and
+           std::use_facet<std::numpunct<char>>(stream.getloc()).grouping().empty();
+}
+
+constexpr std::size_t integerBlockSize{4096};
+
+// Formats blocks of integers on the stack and hands them to the stream in one write each,
+// expects maxFormattedIntegerSize<T> + delimiter.size() to fit into a block.
+template<typename T>
+inline std::ostream& printIntegers(std::ostream& stream, const T* first, const T* last, std::string_view delimiter)
+{
+    char buffer[integerBlockSize];
+    const auto perBlock = (integerBlockSize - formatIntegersPadding) / (maxFormattedIntegerSize<T> + delimiter.size());
+
+    while(first != last)
+    {
+        const auto count = std::min<std::size_t>(perBlock, static_cast<std::size_t>(last - first));
+        const auto end = formatIntegers(first, first + count, delimiter, buffer);
+        stream.write(buffer, end - buffer);
+        if((first += count) != last)
+        {
+            stream.write(delimiter.data(), static_cast<std::streamsize>(delimiter.size()));
+        }
+    }
+    return stream;
+}
+
+constexpr std::size_t integerStageSize{256};
+
+// Copies up to integerStageSize values at a time to the stack and prints each batch with
+// printIntegers(), so a single pass range keeps the block writes in constant memory.
+template<typename Iterator, typename Sentinel>
+inline std::ostream& printStagedIntegers(std::ostream& stream, Iterator first, Sentinel last,
+                                         std::string_view delimiter)
+{
+    typename std::iterator_traits<Iterator>::value_type staged[integerStageSize];
+    for(auto separate = false; first != last; separate = true)
+    {
+        std::size_t count{};
+        for(; count < integerStageSize and first != last; ++first)
+        {
+            staged[count++] = *first;
+        }
+        if(separate)
+        {
+            stream.write(delimiter.data(), static_cast<std::streamsize>(delimiter.size()));
+        }
+        printIntegers(stream, staged, staged + count, delimiter);
+    }
+    return stream;
+}
+}
+
+// Literal pieces printRange emits around and between the elements. Derive from it and
+// shadow the members to get a different compile-time format, e.g. printRange<MyStyle>(range).
+struct DefaultStyle
+{
+    static constexpr std::string_view open{"["};
+    static constexpr std::string_view close{"]"};
+    static constexpr std::string_view delimiter{", "};
+    static constexpr std::string_view pairOpen{"{"};
+    static constexpr std::string_view pairDelimiter{", "};
+    static constexpr std::string_view pairClose{"}"};
+};
+
+struct CompactStyle : DefaultStyle
+{
+    static constexpr std::string_view delimiter{","};
+    static constexpr std::string_view pairDelimiter{","};
+};
+
+// JSON text: ranges, pairs and aggregates are arrays, so a std::map<std::string, int> prints
+// as [["a",1],["b",2]]. quoteStrings makes strings and characters quoted and escaped, bool
+// true or false and infinities and NaN null. Bounded printing adds "..." and is not JSON.
+struct JsonStyle : DefaultStyle
+{
+    static constexpr std::string_view delimiter{","};
+    static constexpr std::string_view pairOpen{"["};
+    static constexpr std::string_view pairDelimiter{","};
+    static constexpr std::string_view pairClose{"]"};
+    static constexpr bool quoteStrings{true};
+};
+
+namespace detail
+{
+template<typename, typename = void>
+constexpr bool is_print_style{};
+
+template<typename, typename = void>
+constexpr bool quotes_strings{};
+
+template<typename Style>
+constexpr bool quotes_strings<Style, std::void_t<decltype(Style::quoteStrings)>> = Style::quoteStrings;
+
+template<typename Style>
+constexpr bool is_print_style<
+    Style,
+    std::void_t<decltype(Style::open), decltype(Style::close), decltype(Style::delimiter),
+                decltype(Style::pairOpen), decltype(Style::pairDelimiter), decltype(Style::pairClose)>
+> = true;
+
+inline std::ostream& writeLiteral(std::ostream& stream, std::string_view literal)
+{
+    return stream.write(literal.data(), static_cast<std::streamsize>(literal.size()));
+}
+
+// Opening brackets go out like stream << literal: a pending std::setw pads them and is
+// used up, as it was when they were printed as chars.
+inline std::ostream& writeOpening(std::ostream& stream, std::string_view literal)
+{
+    return stream.width() != 0 ? stream << literal : writeLiteral(stream, literal);
+}
+
+template<typename, typename = void>
+constexpr bool is_ostreamable{};
+
 template<typename T>
+constexpr bool is_ostreamable<
+    T,
+    std::void_t<decltype(std::declval<std::ostream&>() << std::declval<const T&>())>
+> = true;
+
+// Aggregates without an operator<< of their own are printed field by field. So are
+// proxies that stand for one, e.g. soa_vector rows, they return their fields from tie().
+template<typename T>
+constexpr bool is_printable_aggregate = (traits::is_reflectable<T> or traits::has_tie_member<T>) and not is_ostreamable<T>;
+
+template<typename T>
+inline auto printedFields(const T& value)
+{
+    if constexpr(traits::has_tie_member<T>)
+    {
+        return value.tie();
+    }
+    else
+    {
+        return traits::tieFields(value);
+    }
+}
+}
+
+template<typename T, typename Style = DefaultStyle>
 struct ValuePrinter
 {
     const T& value;
 };
 
-template<typename T>
+template<typename Style = DefaultStyle, typename T>
 inline auto makeValuePrinter(const T& value)
 {
-    return ValuePrinter<T>{value};
+    return ValuePrinter<T, Style>{value};
 }
 
-template<typename Iterator>
+// End may be a sentinel of another type, and single pass iterators work: each element is
+// read once, as it is printed, so a generator or an istream_iterator streams in constant
+// memory. Printing such a range again continues where the previous print stopped.
+template<typename Iterator, typename Style = DefaultStyle, typename Sentinel = Iterator>
 struct RangePrinter
 {
-    RangePrinter(Iterator begin, Iterator end, const char* delimiter)
+    RangePrinter(Iterator begin, Sentinel end, std::string_view delimiter = Style::delimiter)
         : begin_{std::move(begin)}, end_{std::move(end)}, delimiter_{delimiter}
     {}
 
     friend std::ostream& operator<<(std::ostream& stream, const RangePrinter& printer)
     {
+        if constexpr(detail::uses_integer_kernel<Iterator> and std::is_same_v<Iterator, Sentinel>)
+        {
+            if(printer.delimiter_.size() < detail::integerBlockSize / 2 and detail::hasDefaultIntegerFormatting(stream))
+            {
+                detail::writeOpening(stream, Style::open);
+                detail::printIntegers(stream, printer.begin_, printer.end_, printer.delimiter_);
+                return detail::writeLiteral(stream, Style::close);
+            }
+        }
+        else if constexpr(detail::uses_staged_integer_kernel<Iterator>)
+        {
+            if(printer.delimiter_.size() < detail::integerBlockSize / 2 and detail::hasDefaultIntegerFormatting(stream))
+            {
+                detail::writeOpening(stream, Style::open);
+                detail::printStagedIntegers(stream, printer.begin_, printer.end_, printer.delimiter_);
+                return detail::writeLiteral(stream, Style::close);
+            }
+        }
+
         auto begin = printer.begin_;
 
-        stream << '[';
+        detail::writeOpening(stream, Style::open);
         if(begin != printer.end_)
         {
-            stream << makeValuePrinter(*begin);
+            stream << makeValuePrinter<Style>(*begin);
             while(++begin != printer.end_)
             {
-                stream << printer.delimiter_ << makeValuePrinter(*begin);
+                detail::writeLiteral(stream, printer.delimiter_) << makeValuePrinter<Style>(*begin);
             }
         }
-        return stream << ']';
+        return detail::writeLiteral(stream, Style::close);
     }
-private:
-    Iterator begin_, end_;
-    const char* delimiter_;
+
+    Iterator begin() const { return begin_; }
+    Sentinel end() const { return end_; }
+    std::string_view delimiter() const { return delimiter_; }
+protected:
+    Iterator begin_;
+    Sentinel end_;
+    std::string_view delimiter_;
 };
 
+namespace detail
+{
+template<typename, typename = void>
+constexpr bool has_snapshot{};
+
+template<typename T>
+constexpr bool has_snapshot<T, std::void_t<decltype(std::declval<const T&>().snapshot())>> = true;
+
+// What the range overloads of printRange take, so that printRange(first, {}) can not
+// pick them with an iterator for the range.
 template<typename Range>
+constexpr bool is_printable_range = traits::is_iterable<const Range> or has_snapshot<Range>;
+}
+
+// Owns a copy of a container that can not be walked while others write to it, e.g.
+// concurrent_map, and prints that copy.
+template<typename Snapshot, typename Style = DefaultStyle>
+struct SnapshotPrinter
+{
+    Snapshot snapshot;
+    std::string_view delimiter{Style::delimiter};
+
+    friend std::ostream& operator<<(std::ostream& stream, const SnapshotPrinter& printer)
+    {
+        const auto& range = printer.snapshot;
+        return stream << RangePrinter<decltype(detail::rangeBegin(range)), Style>{
+                             detail::rangeBegin(range), detail::rangeEnd(range), printer.delimiter};
+    }
+};
+
+template<typename Range, typename std::enable_if_t<detail::is_printable_range<Range>, int> = 0>
 inline auto printRange(const Range& range, const char* delimiter = ", ")
 {
-    return RangePrinter{std::begin(range), std::end(range), delimiter};
+    if constexpr(detail::has_snapshot<Range>)
+    {
+        return SnapshotPrinter<decltype(range.snapshot())>{range.snapshot(), delimiter};
+    }
+    else
+    {
+        return RangePrinter{detail::rangeBegin(range), detail::rangeEnd(range), delimiter};
+    }
+}
+
+// Compile-time format, all literal pieces come from Style.
+template<typename Style, typename Range,
+         typename std::enable_if_t<detail::is_print_style<Style> and detail::is_printable_range<Range>, int> = 0>
+inline auto printRange(const Range& range)
+{
+    if constexpr(detail::has_snapshot<Range>)
+    {
+        return SnapshotPrinter<decltype(range.snapshot()), Style>{range.snapshot()};
+    }
+    else
+    {
+        return RangePrinter<decltype(detail::rangeBegin(range)), Style, decltype(detail::rangeEnd(range))>{
+            detail::rangeBegin(range), detail::rangeEnd(range)};
+    }
+}
+
+// Elements from first up to last, e.g. printRange(std::istream_iterator<int>{in}, {}).
+template<typename Iterator, typename Sentinel = Iterator,
+         typename = typename std::iterator_traits<Iterator>::iterator_category,
+         typename = decltype(std::declval<const Iterator&>() != std::declval<const Sentinel&>())>
+inline auto printRange(Iterator first, Sentinel last, const char* delimiter = ", ")
+{
+    return RangePrinter<Iterator, DefaultStyle, Sentinel>{std::move(first), std::move(last), delimiter};
+}
+
+template<typename Style, typename Iterator, typename Sentinel = Iterator,
+         typename std::enable_if_t<detail::is_print_style<Style>, int> = 0,
+         typename = typename std::iterator_traits<Iterator>::iterator_category>
+inline auto printRange(Iterator first, Sentinel last)
+{
+    return RangePrinter<Iterator, Style, Sentinel>{std::move(first), std::move(last)};
+}
+
+// How much of a range printRange(range, limits) writes, e.g. PrintLimits{3, 2} gives
+// [1, 2, 3, ... (9999995 more), 99, 100]. The element and depth limits apply to nested
+// ranges too, maxBytes to the whole output, which then ends with "...".
+struct PrintLimits
+{
+    static constexpr std::size_t unlimited{std::numeric_limits<std::size_t>::max()};
+
+    std::size_t maxElements{unlimited};
+    std::size_t tailElements{};
+    std::size_t maxDepth{unlimited};
+    std::size_t maxBytes{unlimited};
+};
+
+namespace detail
+{
+constexpr std::string_view ellipsis{"..."};
+
+struct BoundedState
+{
+    PrintLimits limits;
+    std::size_t depth{};
+};
+
+inline int boundedStateIndex()
+{
+    static const int index{std::ios_base::xalloc()};
+    return index;
 }
 
-template<typename Key, typename Value>
-inline std::ostream& operator<<(std::ostream& os, const ValuePrinter<std::pair<Key, Value>>& obj)
+// Set while a bounded print runs on stream, so nested ranges find the limits.
+inline BoundedState* boundedState(std::ostream& stream)
 {
-    return os << '{' << makeValuePrinter(obj.value.first) << ", " << makeValuePrinter(obj.value.second) << '}';
+    return static_cast<BoundedState*>(stream.pword(boundedStateIndex()));
 }
 
-inline std::ostream& operator<<(std::ostream& os, const ValuePrinter<std::string>& obj)
+// Passes at most limit bytes on to target. Writes past it fail, the stream turns bad and
+// the bounded loops stop instead of formatting the rest into nothing.
+class LimitedBuffer : public std::streambuf
 {
-    return os << obj.value;
+public:
+    LimitedBuffer(std::streambuf* target, std::size_t limit)
+        : target_{target},
+          left_{static_cast<std::streamsize>(std::min<std::size_t>(limit, std::numeric_limits<std::streamsize>::max()))}
+    {}
+
+    bool exhausted() const { return exhausted_; }
+
+protected:
+    int_type overflow(int_type ch) override
+    {
+        if(traits_type::eq_int_type(ch, traits_type::eof()))
+        {
+            return traits_type::not_eof(ch);
+        }
+        const auto c = traits_type::to_char_type(ch);
+        return xsputn(&c, 1) == 1 ? ch : traits_type::eof();
+    }
+
+    std::streamsize xsputn(const char* data, std::streamsize size) override
+    {
+        const auto written = target_->sputn(data, std::min(size, left_));
+        left_ -= written;
+        exhausted_ = exhausted_ or written < size;
+        return written;
+    }
+
+    int sync() override { return target_->pubsync(); }
+
+private:
+    std::streambuf* target_;
+    std::streamsize left_;
+    bool exhausted_{};
+};
+
+// Installs state on stream for the duration of one bounded print and, with a byte limit,
+// routes the output through a LimitedBuffer. The destructor puts the stream back.
+class BoundedStream
+{
+public:
+    BoundedStream(std::ostream& stream, BoundedState& state)
+        : stream_{stream},
+          previousState_{stream.pword(boundedStateIndex())},
+          exceptions_{stream.exceptions()},
+          buffer_{stream.rdbuf(), state.limits.maxBytes},
+          limited_{state.limits.maxBytes != PrintLimits::unlimited}
+    {
+        stream_.pword(boundedStateIndex()) = &state;
+        if(limited_)
+        {
+            stream_.exceptions(std::ios_base::goodbit);
+            target_ = stream_.rdbuf(&buffer_);
+        }
+    }
+
+    BoundedStream(const BoundedStream&) = delete;
+    BoundedStream& operator=(const BoundedStream&) = delete;
+
+    ~BoundedStream() { restore(); }
+
+    // Puts the stream back, true when the output was cut at the byte limit.
+    bool restore()
+    {
+        if(limited_)
+        {
+            limited_ = false;
+            stream_.rdbuf(target_);
+            stream_.exceptions(exceptions_);
+        }
+        stream_.pword(boundedStateIndex()) = previousState_;
+        return buffer_.exhausted();
+    }
+
+private:
+    std::ostream& stream_;
+    void* previousState_;
+    std::ios_base::iostate exceptions_;
+    LimitedBuffer buffer_;
+    std::streambuf* target_{};
+    bool limited_;
+};
+
+inline std::ostream& writeElided(std::ostream& stream, std::size_t count)
+{
+    char digits[std::numeric_limits<std::size_t>::digits10 + 1];
+    const auto end = std::to_chars(digits, digits + sizeof(digits), count).ptr;
+    writeLiteral(stream, " (").write(digits, end - digits);
+    return writeLiteral(stream, " more)");
 }
 
-template<typename T, typename std::enable_if_t<traits::is_iterable<T>, int> = 0>
-inline std::ostream& operator<<(std::ostream& os, const ValuePrinter<T>& obj)
+// Cost follows what is printed: the size of sized and random access ranges is known without
+// walking them, bidirectional ranges step back from the end to their tail. Forward ranges
+// print no tail and single pass ranges of unknown size end with a plain "...".
+template<typename Style, typename Range>
+inline std::ostream& printBounded(std::ostream& stream, const Range& range, std::string_view delimiter,
+                                  BoundedState& state)
 {
-    return os << printRange(obj.value);
+    writeOpening(stream, Style::open);
+    if(state.depth >= state.limits.maxDepth)
+    {
+        writeLiteral(stream, ellipsis);
+        return writeLiteral(stream, Style::close);
+    }
+    ++state.depth;
+
+    using Iterator = decltype(rangeBegin(range));
+    using Category = typename std::iterator_traits<Iterator>::iterator_category;
+    constexpr bool hasSize = traits::is_sized_range<const Range> or
+                             std::is_base_of_v<std::random_access_iterator_tag, Category>;
+    constexpr bool hasTail = std::is_base_of_v<std::bidirectional_iterator_tag, Category> and
+                             std::is_same_v<Iterator, decltype(rangeEnd(range))>;
+
+    auto first = rangeBegin(range);
+    const auto last = rangeEnd(range);
+    std::size_t printed{};
+    const auto printUpTo = [&](std::size_t count, auto& it, const auto& end) {
+        for(std::size_t i = 0; i < count and it != end and stream; ++i, ++it)
+        {
+            if(printed++ != 0)
+            {
+                writeLiteral(stream, delimiter);
+            }
+            stream << makeValuePrinter<Style>(*it);
+        }
+    };
+
+    const auto head = state.limits.maxElements;
+    if constexpr(hasSize)
+    {
+        std::size_t size{};
+        if constexpr(traits::is_sized_range<const Range>)
+        {
+            size = static_cast<std::size_t>(std::size(range));
+        }
+        else
+        {
+            size = static_cast<std::size_t>(last - first);
+        }
+        const auto tail = hasTail ? std::min(state.limits.tailElements, size) : std::size_t{};
+        if(head >= size - tail)
+        {
+            printUpTo(size, first, last);
+        }
+        else
+        {
+            printUpTo(head, first, last);
+            if(printed++ != 0)
+            {
+                writeLiteral(stream, delimiter);
+            }
+            writeElided(writeLiteral(stream, ellipsis), size - head - tail);
+            if constexpr(hasTail)
+            {
+                auto tailFirst = std::prev(last, static_cast<std::ptrdiff_t>(tail));
+                printUpTo(tail, tailFirst, last);
+            }
+        }
+    }
+    else
+    {
+        printUpTo(head, first, last);
+        if(stream and first != last)
+        {
+            if(printed != 0)
+            {
+                writeLiteral(stream, delimiter);
+            }
+            writeLiteral(stream, ellipsis);
+        }
+    }
+
+    --state.depth;
+    return writeLiteral(stream, Style::close);
+}
 }
 
-template<typename T, typename std::enable_if_t<not traits::is_iterable<T>, int> = 0>
-inline std::ostream& operator<<(std::ostream& os, const ValuePrinter<T>& obj)
+// Prints at most limits of Range, a reference to the range or an owned snapshot of it.
+template<typename Range, typename Style = DefaultStyle>
+struct BoundedRangePrinter
 {
-    return os << obj.value;
+    Range range;
+    PrintLimits limits;
+    std::string_view delimiter{Style::delimiter};
+
+    friend std::ostream& operator<<(std::ostream& stream, const BoundedRangePrinter& printer)
+    {
+        if(not stream)
+        {
+            return stream;
+        }
+        detail::BoundedState state{printer.limits};
+        detail::BoundedStream bounded{stream, state};
+        detail::printBounded<Style>(stream, printer.range, printer.delimiter, state);
+        if(bounded.restore())
+        {
+            detail::writeLiteral(stream, detail::ellipsis);
+        }
+        return stream;
+    }
+};
+
+template<typename Range, typename std::enable_if_t<detail::is_printable_range<Range>, int> = 0>
+inline auto printRange(const Range& range, const PrintLimits& limits, const char* delimiter = ", ")
+{
+    if constexpr(detail::has_snapshot<Range>)
+    {
+        return BoundedRangePrinter<decltype(range.snapshot())>{range.snapshot(), limits, delimiter};
+    }
+    else
+    {
+        return BoundedRangePrinter<const Range&>{range, limits, delimiter};
+    }
+}
+
+template<typename Style, typename Range,
+         typename std::enable_if_t<detail::is_print_style<Style> and detail::is_printable_range<Range>, int> = 0>
+inline auto printRange(const Range& range, const PrintLimits& limits)
+{
+    if constexpr(detail::has_snapshot<Range>)
+    {
+        return BoundedRangePrinter<decltype(range.snapshot()), Style>{range.snapshot(), limits};
+    }
+    else
+    {
+        return BoundedRangePrinter<const Range&, Style>{range, limits};
+    }
+}
+
+template<typename Key, typename Value, typename Style>
+inline std::ostream& operator<<(std::ostream& os, const ValuePrinter<std::pair<Key, Value>, Style>& obj)
+{
+    detail::writeOpening(os, Style::pairOpen) << makeValuePrinter<Style>(obj.value.first);
+    detail::writeLiteral(os, Style::pairDelimiter) << makeValuePrinter<Style>(obj.value.second);
+    return detail::writeLiteral(os, Style::pairClose);
+}
+
+namespace detail
+{
+inline std::ostream& writeQuoted(std::ostream& stream, std::string_view text)
+{
+    stream.put('"');
+    escapeJson(text, [&stream](std::string_view piece) { writeLiteral(stream, piece); });
+    return stream.put('"');
+}
+
+// What quoteStrings changes besides strings, other values go to operator<< as they are.
+template<typename T>
+inline std::ostream& writeQuotedStyle(std::ostream& stream, const T& value)
+{
+    if constexpr(std::is_same_v<T, bool>)
+    {
+        return writeLiteral(stream, value ? "true" : "false");
+    }
+    else if constexpr(std::is_same_v<T, char> or std::is_same_v<T, signed char> or std::is_same_v<T, unsigned char>)
+    {
+        const auto c = static_cast<char>(value);
+        return writeQuoted(stream, std::string_view(&c, 1));
+    }
+    else if constexpr(std::is_floating_point_v<T>)
+    {
+        return std::isfinite(value) ? stream << value : writeLiteral(stream, "null");
+    }
+    else
+    {
+        return stream << value;
+    }
+}
+}
+
+// Strings of any flavour are printed as text, in a single write, or quoted and escaped.
+// A pending std::setw pads them as it would with os << string, a null C string sets
+// badbit like it does there.
+template<typename T, typename Style, typename std::enable_if_t<traits::is_string_like<T>, int> = 0>
+inline std::ostream& operator<<(std::ostream& os, const ValuePrinter<T, Style>& obj)
+{
+    if constexpr(std::is_pointer_v<T>)
+    {
+        if(obj.value == nullptr)
+        {
+            os.setstate(std::ios_base::badbit);
+            return os;
+        }
+    }
+    if constexpr(detail::quotes_strings<Style>)
+    {
+        if(os.width() != 0)
+        {
+            std::string quoted{'"'};
+            escapeJson(obj.value, [&quoted](std::string_view piece) { quoted += piece; });
+            return os << (quoted += '"');
+        }
+        return detail::writeQuoted(os, obj.value);
+    }
+    else
+    {
+        return detail::writeOpening(os, obj.value);
+    }
+}
+
+template<typename T, typename Style,
+         typename std::enable_if_t<traits::is_iterable<T> and not traits::is_string_like<T>, int> = 0>
+inline std::ostream& operator<<(std::ostream& os, const ValuePrinter<T, Style>& obj)
+{
+    if(auto* state = detail::boundedState(os))
+    {
+        return detail::printBounded<Style>(os, obj.value, Style::delimiter, *state);
+    }
+    return os << printRange<Style>(obj.value);
+}
+
+// Fields go between the pair literals, e.g. {Jan Kowalski, 40}.
+template<typename T, typename Style, typename std::enable_if_t<detail::is_printable_aggregate<T>, int> = 0>
+inline std::ostream& operator<<(std::ostream& os, const ValuePrinter<T, Style>& obj)
+{
+    detail::writeOpening(os, Style::pairOpen);
+    std::apply([&os](const auto& first, const auto&... rest) {
+        os << makeValuePrinter<Style>(first);
+        ((detail::writeLiteral(os, Style::pairDelimiter) << makeValuePrinter<Style>(rest)), ...);
+    }, detail::printedFields(obj.value));
+    return detail::writeLiteral(os, Style::pairClose);
+}
+
+template<typename T, typename Style,
+         typename std::enable_if_t<not traits::is_iterable<T> and not traits::is_string_like<T> and
+                                   not detail::is_printable_aggregate<T>, int> = 0>
+inline std::ostream& operator<<(std::ostream& os, const ValuePrinter<T, Style>& obj)
+{
+    if constexpr(detail::quotes_strings<Style>)
+    {
+        return detail::writeQuotedStyle(os, obj.value);
+    }
+    else
+    {
+        return os << obj.value;
+    }
+}
 }
-}
\ No newline at end of file
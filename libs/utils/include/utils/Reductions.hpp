@@ -0,0 +1,595 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <future>
+#include <iterator>
+#include <limits>
+#include <thread>
+#include <type_traits>
+#include <vector>
+#include "traits/IsContiguousRange.hpp"
+#include "traits/IsRandomAccessRange.hpp"
+
+#if defined(__GNUC__) && defined(__x86_64__)
+#define UTILS_HAS_X86_REDUCE_KERNELS 1
+#include <immintrin.h>
+#endif
+
+namespace utils
+{
+enum class ReduceKernel
+{
+    Scalar,
+    Avx2 // four 64-bit lanes per add
+};
+
+// What sum() returns: integers are added up in 64 bits, wrapping modulo 2^64 on overflow,
+// float in double, other types in themselves. mean() and variance() add integers up wider.
+template<typename T>
+using sum_t = std::conditional_t<std::is_same_v<T, bool> or std::is_unsigned_v<T>, std::uint64_t,
+              std::conditional_t<std::is_integral_v<T>, std::int64_t,
+              std::conditional_t<std::is_same_v<T, float>, double, T>>>;
+
+// What mean() and variance() return.
+template<typename T>
+using mean_t = std::conditional_t<std::is_same_v<T, long double>, long double, double>;
+
+namespace detail
+{
+// Sum with the rounding error of every addition kept aside (Knuth's TwoSum, which unlike
+// Kahan's update stays exact when the added value is larger than the sum so far).
+template<typename F>
+struct CompensatedSum
+{
+    F sum{};
+    F compensation{};
+
+    void add(F value)
+    {
+        const F total = sum + value;
+        const F rounded = total - sum;
+        compensation += (sum - (total - rounded)) + (value - rounded);
+        sum = total;
+    }
+
+    F value() const { return sum + compensation; }
+
+    friend CompensatedSum operator+(CompensatedSum lhs, const CompensatedSum& rhs)
+    {
+        lhs.add(rhs.sum);
+        lhs.compensation += rhs.compensation;
+        return lhs;
+    }
+};
+
+// Sums of x - mean and of (x - mean)^2, the first one corrects the rounding of the mean.
+template<typename F>
+struct Deviations
+{
+    CompensatedSum<F> squares;
+    CompensatedSum<F> sum;
+
+    friend Deviations operator+(Deviations lhs, const Deviations& rhs)
+    {
+        return {lhs.squares + rhs.squares, lhs.sum + rhs.sum};
+    }
+};
+
+template<typename T>
+using sum_accumulator_t = std::conditional_t<std::is_floating_point_v<T>, CompensatedSum<sum_t<T>>, sum_t<T>>;
+
+// Exact total of integers for mean() and variance(), which must not wrap like sum() does.
+struct IntegerTotal
+{
+#ifdef __SIZEOF_INT128__
+    __int128 sum{};
+
+    void add(__int128 value) { sum += value; }
+    double value() const { return static_cast<double>(sum); }
+#else
+    CompensatedSum<long double> sum{};
+
+    void add(long double value) { sum.add(value); }
+    double value() const { return static_cast<double>(sum.value()); }
+#endif
+
+    friend IntegerTotal operator+(IntegerTotal lhs, const IntegerTotal& rhs)
+    {
+        lhs.sum = lhs.sum + rhs.sum;
+        return lhs;
+    }
+};
+
+// Elements below 64 bits fit in 32, so this many of them add up in 64 bits without wrapping.
+constexpr std::ptrdiff_t exactNarrowIntegerBlock{std::ptrdiff_t{1} << 31};
+
+// Elements the AVX2 kernels widen into 64-bit integer lanes.
+template<typename T>
+constexpr bool is_int64_lane = std::is_integral_v<T> and not std::is_same_v<T, bool> and
+                               (sizeof(T) == 1 or sizeof(T) == 2 or sizeof(T) == 4 or sizeof(T) == 8);
+
+// Elements the AVX2 kernels widen into double lanes.
+template<typename T>
+constexpr bool is_double_lane = std::is_same_v<T, double> or std::is_same_v<T, float> or std::is_same_v<T, std::int32_t>;
+
+constexpr std::size_t reduceAccumulators{4};
+
+#ifdef UTILS_HAS_X86_REDUCE_KERNELS
+// Four elements as 64-bit integers.
+template<typename T>
+__attribute__((target("avx2"), always_inline))
+inline __m256i loadInt64Avx2(const T* values)
+{
+    if constexpr(sizeof(T) == 8)
+    {
+        return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(values));
+    }
+    else if constexpr(sizeof(T) == 4)
+    {
+        const __m128i packed = _mm_loadu_si128(reinterpret_cast<const __m128i*>(values));
+        return std::is_signed_v<T> ? _mm256_cvtepi32_epi64(packed) : _mm256_cvtepu32_epi64(packed);
+    }
+    else if constexpr(sizeof(T) == 2)
+    {
+        const __m128i packed = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(values));
+        return std::is_signed_v<T> ? _mm256_cvtepi16_epi64(packed) : _mm256_cvtepu16_epi64(packed);
+    }
+    else
+    {
+        const __m128i packed = _mm_loadu_si32(values);
+        return std::is_signed_v<T> ? _mm256_cvtepi8_epi64(packed) : _mm256_cvtepu8_epi64(packed);
+    }
+}
+
+// Four elements as doubles.
+template<typename T>
+__attribute__((target("avx2"), always_inline))
+inline __m256d loadDoubleAvx2(const T* values)
+{
+    if constexpr(std::is_same_v<T, double>)
+    {
+        return _mm256_loadu_pd(values);
+    }
+    else if constexpr(std::is_same_v<T, float>)
+    {
+        return _mm256_cvtps_pd(_mm_loadu_ps(values));
+    }
+    else
+    {
+        return _mm256_cvtepi32_pd(_mm_loadu_si128(reinterpret_cast<const __m128i*>(values)));
+    }
+}
+
+// CompensatedSum::add() on every lane.
+__attribute__((target("avx2"), always_inline))
+inline void addCompensatedAvx2(__m256d& sum, __m256d& compensation, __m256d value)
+{
+    const __m256d total = _mm256_add_pd(sum, value);
+    const __m256d rounded = _mm256_sub_pd(total, sum);
+    const __m256d error = _mm256_add_pd(_mm256_sub_pd(sum, _mm256_sub_pd(total, rounded)), _mm256_sub_pd(value, rounded));
+    compensation = _mm256_add_pd(compensation, error);
+    sum = total;
+}
+
+__attribute__((target("avx2"), always_inline))
+inline void foldCompensatedAvx2(CompensatedSum<double>& result, __m256d sum, __m256d compensation)
+{
+    double sums[4];
+    double compensations[4];
+    _mm256_storeu_pd(sums, sum);
+    _mm256_storeu_pd(compensations, compensation);
+    for(std::size_t lane = 0; lane < 4; ++lane)
+    {
+        result.add(sums[lane]);
+        result.compensation += compensations[lane];
+    }
+}
+
+// Returns where the scalar tail starts, the same for the other kernels.
+template<typename T>
+__attribute__((target("avx2")))
+inline const T* sumIntegersAvx2(const T* first, const T* last, sum_t<T>& result)
+{
+    __m256i accumulator[reduceAccumulators];
+    for(auto& lane : accumulator)
+    {
+        lane = _mm256_setzero_si256();
+    }
+    for(; last - first >= 4 * static_cast<std::ptrdiff_t>(reduceAccumulators); first += 4 * reduceAccumulators)
+    {
+        for(std::size_t k = 0; k < reduceAccumulators; ++k)
+        {
+            accumulator[k] = _mm256_add_epi64(accumulator[k], loadInt64Avx2(first + 4 * k));
+        }
+    }
+
+    std::uint64_t lanes[4];
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(lanes),
+                        _mm256_add_epi64(_mm256_add_epi64(accumulator[0], accumulator[1]),
+                                         _mm256_add_epi64(accumulator[2], accumulator[3])));
+    // Lanes wrap like unsigned integers, the sum is the same as adding up in order.
+    result = static_cast<sum_t<T>>(static_cast<std::uint64_t>(result) + lanes[0] + lanes[1] + lanes[2] + lanes[3]);
+    return first;
+}
+
+template<typename T>
+__attribute__((target("avx2")))
+inline const T* sumDoublesAvx2(const T* first, const T* last, CompensatedSum<double>& result)
+{
+    __m256d sum[reduceAccumulators];
+    __m256d compensation[reduceAccumulators];
+    for(std::size_t k = 0; k < reduceAccumulators; ++k)
+    {
+        sum[k] = _mm256_setzero_pd();
+        compensation[k] = _mm256_setzero_pd();
+    }
+    for(; last - first >= 4 * static_cast<std::ptrdiff_t>(reduceAccumulators); first += 4 * reduceAccumulators)
+    {
+        for(std::size_t k = 0; k < reduceAccumulators; ++k)
+        {
+            addCompensatedAvx2(sum[k], compensation[k], loadDoubleAvx2(first + 4 * k));
+        }
+    }
+    for(std::size_t k = 0; k < reduceAccumulators; ++k)
+    {
+        foldCompensatedAvx2(result, sum[k], compensation[k]);
+    }
+    return first;
+}
+
+template<typename T>
+__attribute__((target("avx2")))
+inline const T* sumDeviationsAvx2(const T* first, const T* last, double mean, Deviations<double>& result)
+{
+    const __m256d center = _mm256_set1_pd(mean);
+    __m256d squares[2];
+    __m256d squaresCompensation[2];
+    __m256d sum[2];
+    __m256d sumCompensation[2];
+    for(std::size_t k = 0; k < 2; ++k)
+    {
+        squares[k] = squaresCompensation[k] = sum[k] = sumCompensation[k] = _mm256_setzero_pd();
+    }
+    for(; last - first >= 8; first += 8)
+    {
+        for(std::size_t k = 0; k < 2; ++k)
+        {
+            const __m256d deviation = _mm256_sub_pd(loadDoubleAvx2(first + 4 * k), center);
+            addCompensatedAvx2(squares[k], squaresCompensation[k], _mm256_mul_pd(deviation, deviation));
+            addCompensatedAvx2(sum[k], sumCompensation[k], deviation);
+        }
+    }
+    for(std::size_t k = 0; k < 2; ++k)
+    {
+        foldCompensatedAvx2(result.squares, squares[k], squaresCompensation[k]);
+        foldCompensatedAvx2(result.sum, sum[k], sumCompensation[k]);
+    }
+    return first;
+}
+
+inline bool cpuSupportsReduceKernel(ReduceKernel kernel)
+{
+    __builtin_cpu_init();
+    return kernel == ReduceKernel::Scalar or __builtin_cpu_supports("avx2");
+}
+#else
+inline bool cpuSupportsReduceKernel(ReduceKernel kernel)
+{
+    return kernel == ReduceKernel::Scalar;
+}
+#endif
+}
+
+inline bool isReduceKernelSupported(ReduceKernel kernel)
+{
+    static const bool supported[]{true, detail::cpuSupportsReduceKernel(ReduceKernel::Avx2)};
+    return supported[static_cast<std::size_t>(kernel)];
+}
+
+inline ReduceKernel defaultReduceKernel()
+{
+    static const ReduceKernel kernel = isReduceKernelSupported(ReduceKernel::Avx2) ? ReduceKernel::Avx2
+                                                                                 : ReduceKernel::Scalar;
+    return kernel;
+}
+
+namespace detail
+{
+template<typename Iterator>
+using iterator_value_t = std::remove_cv_t<typename std::iterator_traits<Iterator>::value_type>;
+
+template<typename Iterator>
+inline auto sumElements(ReduceKernel kernel, Iterator first, Iterator last)
+{
+    using Element = iterator_value_t<Iterator>;
+    sum_accumulator_t<Element> result{};
+    if constexpr(std::is_pointer_v<Iterator>)
+    {
+#ifdef UTILS_HAS_X86_REDUCE_KERNELS
+        if(kernel == ReduceKernel::Avx2)
+        {
+            if constexpr(is_int64_lane<Element>)
+            {
+                first = sumIntegersAvx2(first, last, result);
+            }
+            else if constexpr(is_double_lane<Element> and std::is_floating_point_v<Element>)
+            {
+                first = sumDoublesAvx2(first, last, result);
+            }
+        }
+#endif
+    }
+    for(; first != last; ++first)
+    {
+        if constexpr(std::is_floating_point_v<Element>)
+        {
+            result.add(*first);
+        }
+        else if constexpr(std::is_arithmetic_v<Element>)
+        {
+            // Wraps instead of overflowing, like the vector lanes.
+            result = static_cast<sum_t<Element>>(static_cast<std::uint64_t>(result) + static_cast<std::uint64_t>(*first));
+        }
+        else
+        {
+            result = result + *first;
+        }
+    }
+    return result;
+}
+
+template<typename Iterator, typename F>
+inline Deviations<F> sumDeviations(ReduceKernel kernel, Iterator first, Iterator last, F mean)
+{
+    using Element = iterator_value_t<Iterator>;
+    Deviations<F> result{};
+    if constexpr(std::is_pointer_v<Iterator> and std::is_same_v<F, double>)
+    {
+#ifdef UTILS_HAS_X86_REDUCE_KERNELS
+        if(kernel == ReduceKernel::Avx2)
+        {
+            if constexpr(is_double_lane<Element>)
+            {
+                first = sumDeviationsAvx2(first, last, mean, result);
+            }
+        }
+#endif
+    }
+    for(; first != last; ++first)
+    {
+        const F deviation = static_cast<F>(*first) - mean;
+        result.squares.add(deviation * deviation);
+        result.sum.add(deviation);
+    }
+    return result;
+}
+
+template<typename Accumulator>
+inline auto accumulatedValue(const Accumulator& accumulator)
+{
+    return accumulator;
+}
+
+template<typename F>
+inline F accumulatedValue(const CompensatedSum<F>& accumulator)
+{
+    return accumulator.value();
+}
+
+inline double accumulatedValue(const IntegerTotal& accumulator)
+{
+    return accumulator.value();
+}
+
+// Sum for mean() and variance(): integers go into an IntegerTotal, elements below 64 bits
+// still through the kernels of sumElements in blocks that can not wrap.
+template<typename Iterator>
+inline auto sumForMean(ReduceKernel kernel, Iterator first, Iterator last)
+{
+    using Element = iterator_value_t<Iterator>;
+    if constexpr(std::is_integral_v<Element>)
+    {
+        IntegerTotal result{};
+        if constexpr(sizeof(Element) < sizeof(std::uint64_t))
+        {
+            for(auto remaining = std::distance(first, last); remaining > 0;)
+            {
+                const auto block = std::min<decltype(remaining)>(remaining, exactNarrowIntegerBlock);
+                const auto blockLast = std::next(first, block);
+                result.add(sumElements(kernel, first, blockLast));
+                first = blockLast;
+                remaining -= block;
+            }
+        }
+        else
+        {
+            for(; first != last; ++first)
+            {
+                result.add(*first);
+            }
+        }
+        return result;
+    }
+    else
+    {
+        return sumElements(kernel, first, last);
+    }
+}
+
+// Contiguous ranges are reduced through const pointers, which is what the kernels take.
+template<typename Range>
+inline auto reduceBegin(const Range& range)
+{
+    if constexpr(traits::is_contiguous_range<const Range>)
+    {
+        const auto* data = std::data(range);
+        return data;
+    }
+    else
+    {
+        return std::begin(range);
+    }
+}
+
+template<typename Range>
+inline auto reduceEnd(const Range& range)
+{
+    if constexpr(traits::is_contiguous_range<const Range>)
+    {
+        const auto* data = std::data(range);
+        return data + std::size(range);
+    }
+    else
+    {
+        return std::end(range);
+    }
+}
+
+// Below this many elements per thread spawning workers costs more than it saves.
+constexpr std::size_t minParallelReduceChunkSize{1 << 16};
+
+// Reduces consecutive chunks of [first, last) on up to threads workers (0 means one per
+// hardware thread) and adds the partial results up in order, so for a given number of
+// chunks the result does not depend on scheduling.
+template<typename Iterator, typename Reduce>
+inline auto reduceChunks(Iterator first, Iterator last, std::size_t threads, Reduce reduce)
+{
+    const auto size = static_cast<std::size_t>(std::distance(first, last));
+    const auto workers = threads != 0 ? threads : std::max(1u, std::thread::hardware_concurrency());
+    const auto chunks = std::max<std::size_t>(1, std::min<std::size_t>(workers, size / minParallelReduceChunkSize));
+    const auto chunkSize = size / chunks;
+
+    auto reduceChunk = [=](std::size_t index) {
+        auto chunkFirst = first + static_cast<std::ptrdiff_t>(index * chunkSize);
+        auto chunkLast = index + 1 == chunks ? last : chunkFirst + static_cast<std::ptrdiff_t>(chunkSize);
+        return reduce(chunkFirst, chunkLast);
+    };
+
+    std::vector<std::future<decltype(reduceChunk(0))>> partials;
+    for(std::size_t index = 1; index < chunks; ++index)
+    {
+        partials.push_back(std::async(std::launch::async, reduceChunk, index));
+    }
+    auto result = reduceChunk(0);
+    for(auto& partial : partials)
+    {
+        result = result + partial.get();
+    }
+    return result;
+}
+
+template<typename Element, typename Accumulator>
+inline auto meanOf(std::size_t size, const Accumulator& sum)
+{
+    using Mean = mean_t<Element>;
+    return static_cast<Mean>(accumulatedValue(sum)) / static_cast<Mean>(size);
+}
+
+// Population variance from the deviations around the rounded mean, two-pass with the
+// correction term of Chan, Golub and LeVeque.
+template<typename F>
+inline F varianceOf(std::size_t size, const Deviations<F>& deviations)
+{
+    const F sum = deviations.sum.value();
+    return (deviations.squares.value() - sum * sum / static_cast<F>(size)) / static_cast<F>(size);
+}
+
+template<typename Range>
+using range_value_t = iterator_value_t<decltype(reduceBegin(std::declval<const Range&>()))>;
+}
+
+// Sum of the elements. Integers add up exactly modulo 2^64, floating point values with
+// compensated additions, so the result is as good as adding up in twice the precision.
+// Contiguous ranges of integers, float and double are reduced four 64-bit lanes at a time
+// in independent accumulators. Other element types are added up with + from Element{}.
+template<typename Range>
+inline auto sum(ReduceKernel kernel, const Range& range)
+{
+    return detail::accumulatedValue(detail::sumElements(kernel, detail::reduceBegin(range), detail::reduceEnd(range)));
+}
+
+template<typename Range>
+inline auto sum(const Range& range)
+{
+    return sum(defaultReduceKernel(), range);
+}
+
+// NaN for empty ranges. Integers are added up in an IntegerTotal, so unlike sum() the
+// mean of 64-bit values near their limits does not wrap.
+template<typename Range>
+inline auto mean(ReduceKernel kernel, const Range& range)
+{
+    static_assert(std::is_arithmetic_v<detail::range_value_t<Range>>, "mean requires arithmetic elements");
+    const auto first = detail::reduceBegin(range);
+    const auto last = detail::reduceEnd(range);
+    return detail::meanOf<detail::range_value_t<Range>>(static_cast<std::size_t>(std::distance(first, last)),
+                                           detail::sumForMean(kernel, first, last));
+}
+
+template<typename Range>
+inline auto mean(const Range& range)
+{
+    return mean(defaultReduceKernel(), range);
+}
+
+// Population variance, a second pass over the range around the mean. NaN for empty ranges.
+template<typename Range>
+inline auto variance(ReduceKernel kernel, const Range& range)
+{
+    const auto average = mean(kernel, range);
+    const auto first = detail::reduceBegin(range);
+    const auto last = detail::reduceEnd(range);
+    return detail::varianceOf(static_cast<std::size_t>(std::distance(first, last)),
+                              detail::sumDeviations(kernel, first, last, average));
+}
+
+template<typename Range>
+inline auto variance(const Range& range)
+{
+    return variance(defaultReduceKernel(), range);
+}
+
+// Same results as sum, mean and variance for ranges split into up to threads chunks (0
+// means one per hardware thread, ranges under 64Ki elements per chunk stay on the calling
+// thread). Floating point results may differ from the sequential ones in the last bits.
+template<typename Range>
+inline auto sumParallel(const Range& range, std::size_t threads = 0)
+{
+    static_assert(traits::is_random_access_range<const Range>, "parallel reductions require a random access range");
+    const auto kernel = defaultReduceKernel();
+    return detail::accumulatedValue(detail::reduceChunks(
+        detail::reduceBegin(range), detail::reduceEnd(range), threads,
+        [kernel](auto first, auto last) { return detail::sumElements(kernel, first, last); }));
+}
+
+template<typename Range>
+inline auto meanParallel(const Range& range, std::size_t threads = 0)
+{
+    static_assert(traits::is_random_access_range<const Range>, "parallel reductions require a random access range");
+    static_assert(std::is_arithmetic_v<detail::range_value_t<Range>>, "mean requires arithmetic elements");
+    const auto kernel = defaultReduceKernel();
+    const auto first = detail::reduceBegin(range);
+    const auto last = detail::reduceEnd(range);
+    return detail::meanOf<detail::range_value_t<Range>>(
+        static_cast<std::size_t>(std::distance(first, last)),
+        detail::reduceChunks(first, last, threads, [kernel](auto first, auto last) {
+            return detail::sumForMean(kernel, first, last);
+        }));
+}
+
+template<typename Range>
+inline auto varianceParallel(const Range& range, std::size_t threads = 0)
+{
+    const auto average = meanParallel(range, threads);
+    const auto kernel = defaultReduceKernel();
+    const auto first = detail::reduceBegin(range);
+    const auto last = detail::reduceEnd(range);
+    return detail::varianceOf(static_cast<std::size_t>(std::distance(first, last)),
+                              detail::reduceChunks(first, last, threads, [kernel, average](auto first, auto last) {
+                                  return detail::sumDeviations(kernel, first, last, average);
+                              }));
+}
+}
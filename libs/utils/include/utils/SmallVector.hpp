@@ -0,0 +1,392 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include "traits/IsTriviallyRelocatable.hpp"
+
+namespace utils
+{
+// Vector keeping up to N elements in place, only larger sizes are allocated on the heap.
+// Growing moves elements with memcpy when traits::is_trivially_relocatable<T>.
+template<typename T, std::size_t N>
+class small_vector
+{
+    static_assert(N > 0, "small_vector needs room for at least one inline element");
+
+public:
+    using value_type = T;
+    using size_type = std::size_t;
+    using difference_type = std::ptrdiff_t;
+    using reference = T&;
+    using const_reference = const T&;
+    using pointer = T*;
+    using const_pointer = const T*;
+    using iterator = T*;
+    using const_iterator = const T*;
+
+    small_vector() = default;
+
+    small_vector(std::initializer_list<T> values)
+        : small_vector(values.begin(), values.end())
+    {}
+
+    // The filling constructors delegate to the default one, so ~small_vector frees what
+    // they built when an element constructor throws halfway.
+    small_vector(size_type count, const T& value)
+        : small_vector()
+    {
+        reserve(count);
+        std::uninitialized_fill_n(data_, count, value);
+        size_ = count;
+    }
+
+    template<typename Iterator, typename = typename std::iterator_traits<Iterator>::iterator_category>
+    small_vector(Iterator first, Iterator last)
+        : small_vector()
+    {
+        if constexpr(std::is_base_of_v<std::forward_iterator_tag, typename std::iterator_traits<Iterator>::iterator_category>)
+        {
+            reserve(static_cast<size_type>(std::distance(first, last)));
+        }
+        for(; first != last; ++first)
+        {
+            emplace_back(*first);
+        }
+    }
+
+    small_vector(const small_vector& other)
+        : small_vector(other.begin(), other.end())
+    {}
+
+    // Steals the buffer of a spilled vector, inline elements are relocated one by one.
+    small_vector(small_vector&& other) noexcept(std::is_nothrow_move_constructible_v<T>)
+    {
+        takeFrom(other);
+    }
+
+    small_vector& operator=(const small_vector& other)
+    {
+        if(this != &other)
+        {
+            clear();
+            reserve(other.size_);
+            std::uninitialized_copy(other.begin(), other.end(), data_);
+            size_ = other.size_;
+        }
+        return *this;
+    }
+
+    small_vector& operator=(small_vector&& other) noexcept(std::is_nothrow_move_constructible_v<T>)
+    {
+        if(this != &other)
+        {
+            clear();
+            releaseHeap();
+            takeFrom(other);
+        }
+        return *this;
+    }
+
+    ~small_vector()
+    {
+        clear();
+        releaseHeap();
+    }
+
+    iterator begin() { return data_; }
+    iterator end() { return data_ + size_; }
+    const_iterator begin() const { return data_; }
+    const_iterator end() const { return data_ + size_; }
+    const_iterator cbegin() const { return data_; }
+    const_iterator cend() const { return data_ + size_; }
+
+    T* data() { return data_; }
+    const T* data() const { return data_; }
+    size_type size() const { return size_; }
+    size_type capacity() const { return capacity_; }
+    bool empty() const { return size_ == 0; }
+    static constexpr size_type inline_capacity() { return N; }
+
+    // True while the elements live in the inline buffer.
+    bool is_inline() const { return data_ == inlineData(); }
+
+    T& operator[](size_type index) { return data_[index]; }
+    const T& operator[](size_type index) const { return data_[index]; }
+
+    T& at(size_type index)
+    {
+        checkIndex(index);
+        return data_[index];
+    }
+
+    const T& at(size_type index) const
+    {
+        checkIndex(index);
+        return data_[index];
+    }
+
+    T& front() { return data_[0]; }
+    const T& front() const { return data_[0]; }
+    T& back() { return data_[size_ - 1]; }
+    const T& back() const { return data_[size_ - 1]; }
+
+    void reserve(size_type capacity)
+    {
+        if(capacity > capacity_)
+        {
+            reallocate(capacity);
+        }
+    }
+
+    template<typename... Args>
+    T& emplace_back(Args&&... args)
+    {
+        if(size_ == capacity_)
+        {
+            return growAndEmplace(std::forward<Args>(args)...);
+        }
+        auto* element = ::new(static_cast<void*>(data_ + size_)) T(std::forward<Args>(args)...);
+        ++size_;
+        return *element;
+    }
+
+    void push_back(const T& value) { emplace_back(value); }
+    void push_back(T&& value) { emplace_back(std::move(value)); }
+
+    void pop_back()
+    {
+        --size_;
+        std::destroy_at(data_ + size_);
+    }
+
+    void resize(size_type size)
+    {
+        resizeWith(size, [](T* first, size_type count) { std::uninitialized_value_construct_n(first, count); });
+    }
+
+    void resize(size_type size, const T& value)
+    {
+        // value may be one of the elements, reallocating would end its lifetime first.
+        if(size > capacity_)
+        {
+            const T copy = value;
+            reallocate(grownCapacity(size));
+            return resize(size, copy);
+        }
+        resizeWith(size, [&value](T* first, size_type count) { std::uninitialized_fill_n(first, count, value); });
+    }
+
+    void clear()
+    {
+        std::destroy_n(data_, size_);
+        size_ = 0;
+    }
+
+    friend bool operator==(const small_vector& lhs, const small_vector& rhs)
+    {
+        return std::equal(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
+    }
+
+    friend bool operator!=(const small_vector& lhs, const small_vector& rhs)
+    {
+        return not(lhs == rhs);
+    }
+
+private:
+    T* inlineData() { return std::launder(reinterpret_cast<T*>(inline_)); }
+    const T* inlineData() const { return std::launder(reinterpret_cast<const T*>(inline_)); }
+
+    void checkIndex(size_type index) const
+    {
+        if(index >= size_)
+        {
+            throw std::out_of_range{"small_vector::at"};
+        }
+    }
+
+    // Moves count elements into uninitialized storage at to and ends their lifetime at from.
+    // The elements at from are destroyed only once all of them are built at to, so a
+    // throwing copy leaves from untouched and to empty.
+    static void relocate(T* from, size_type count, T* to)
+    {
+        if constexpr(traits::is_trivially_relocatable<T>)
+        {
+            if(count != 0)
+            {
+                std::memcpy(static_cast<void*>(to), static_cast<const void*>(from), count * sizeof(T));
+            }
+        }
+        else
+        {
+            size_type index = 0;
+            try
+            {
+                for(; index < count; ++index)
+                {
+                    ::new(static_cast<void*>(to + index)) T(std::move_if_noexcept(from[index]));
+                }
+            }
+            catch(...)
+            {
+                std::destroy(to, to + index);
+                throw;
+            }
+            std::destroy(from, from + count);
+        }
+    }
+
+    static T* allocate(size_type capacity)
+    {
+        if constexpr(alignof(T) > __STDCPP_DEFAULT_NEW_ALIGNMENT__)
+        {
+            return static_cast<T*>(::operator new(capacity * sizeof(T), std::align_val_t{alignof(T)}));
+        }
+        else
+        {
+            return static_cast<T*>(::operator new(capacity * sizeof(T)));
+        }
+    }
+
+    static void deallocate(T* data)
+    {
+        if constexpr(alignof(T) > __STDCPP_DEFAULT_NEW_ALIGNMENT__)
+        {
+            ::operator delete(data, std::align_val_t{alignof(T)});
+        }
+        else
+        {
+            ::operator delete(data);
+        }
+    }
+
+    size_type grownCapacity(size_type required) const
+    {
+        return std::max(required, 2 * capacity_);
+    }
+
+    void reallocate(size_type capacity)
+    {
+        auto* data = allocate(capacity);
+        try
+        {
+            relocate(data_, size_, data);
+        }
+        catch(...)
+        {
+            deallocate(data);
+            throw;
+        }
+        releaseHeap();
+        data_ = data;
+        capacity_ = capacity;
+    }
+
+    // The new element is constructed before the old ones move, args may refer into them.
+    template<typename... Args>
+    T& growAndEmplace(Args&&... args)
+    {
+        const auto capacity = grownCapacity(size_ + 1);
+        auto* data = allocate(capacity);
+        T* element;
+        try
+        {
+            element = ::new(static_cast<void*>(data + size_)) T(std::forward<Args>(args)...);
+        }
+        catch(...)
+        {
+            deallocate(data);
+            throw;
+        }
+        try
+        {
+            relocate(data_, size_, data);
+        }
+        catch(...)
+        {
+            std::destroy_at(element);
+            deallocate(data);
+            throw;
+        }
+        releaseHeap();
+        data_ = data;
+        capacity_ = capacity;
+        ++size_;
+        return *element;
+    }
+
+    template<typename Construct>
+    void resizeWith(size_type size, Construct construct)
+    {
+        if(size < size_)
+        {
+            std::destroy(data_ + size, data_ + size_);
+        }
+        else if(size > size_)
+        {
+            if(size > capacity_)
+            {
+                reallocate(grownCapacity(size));
+            }
+            construct(data_ + size_, size - size_);
+        }
+        size_ = size;
+    }
+
+    void releaseHeap()
+    {
+        if(not is_inline())
+        {
+            deallocate(data_);
+            data_ = inlineData();
+            capacity_ = N;
+        }
+    }
+
+    // Expects this to be empty and inline.
+    void takeFrom(small_vector& other)
+    {
+        if(other.is_inline())
+        {
+            relocate(other.data_, other.size_, data_);
+        }
+        else
+        {
+            data_ = other.data_;
+            capacity_ = other.capacity_;
+            other.data_ = other.inlineData();
+            other.capacity_ = N;
+        }
+        size_ = other.size_;
+        other.size_ = 0;
+    }
+
+    alignas(T) unsigned char inline_[N * sizeof(T)];
+    T* data_{inlineData()};
+    size_type size_{};
+    size_type capacity_{N};
+};
+
+namespace detail
+{
+template<typename, typename = void>
+constexpr bool is_iterator{};
+
+template<typename T>
+constexpr bool is_iterator<T, std::void_t<typename std::iterator_traits<T>::iterator_category>> = true;
+}
+
+// small_vector v{1, 2, 3} is a small_vector<int, 3>, mixed element types do not deduce.
+// Neither do iterators, small_vector v(first, last) has no capacity to deduce and must not
+// become a small_vector of two iterators.
+template<typename T, typename... Ts>
+small_vector(T, Ts...)
+    -> small_vector<std::enable_if_t<(std::is_same_v<T, Ts> and ...) and not detail::is_iterator<T>, T>, 1 + sizeof...(Ts)>;
+}
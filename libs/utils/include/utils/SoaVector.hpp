@@ -0,0 +1,382 @@
+#pragma once
+
+#include <cstddef>
+#include <initializer_list>
+#include <iterator>
+#include <stdexcept>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include "traits/TieFields.hpp"
+#include "utils/Vector.hpp"
+
+namespace utils
+{
+// Contiguous view of one soa_vector column. It has data() and size(), so the range
+// utilities see it as a contiguous range, e.g. sum(people.column<1>()) runs the AVX2 kernel.
+template<typename T>
+class ColumnSpan
+{
+public:
+    using value_type = std::remove_cv_t<T>;
+    using iterator = T*;
+
+    ColumnSpan() = default;
+    ColumnSpan(T* data, std::size_t size)
+        : data_{data}, size_{size}
+    {}
+
+    T* data() const { return data_; }
+    std::size_t size() const { return size_; }
+    bool empty() const { return size_ == 0; }
+    T* begin() const { return data_; }
+    T* end() const { return data_ + size_; }
+    T& operator[](std::size_t index) const { return data_[index]; }
+
+private:
+    T* data_{};
+    std::size_t size_{};
+};
+
+// One row of a soa_vector: references into every column, standing in for an Aggregate.
+// Converts to an Aggregate, is assigned from one, compares with one and gives the fields
+// through get<I>() and structured bindings.
+template<typename Aggregate, typename... Refs>
+class SoaRow
+{
+public:
+    explicit SoaRow(Refs... fields)
+        : fields_{fields...}
+    {}
+
+    SoaRow(const SoaRow&) = default;
+
+    // Assigns the values, like the element a reference stands for.
+    const SoaRow& operator=(const SoaRow& other) const
+    {
+        fields_ = other.fields_;
+        return *this;
+    }
+
+    const SoaRow& operator=(const Aggregate& value) const
+    {
+        fields_ = traits::tieFields(value);
+        return *this;
+    }
+
+    const SoaRow& operator=(Aggregate&& value) const
+    {
+        std::apply([this](auto&... fields) { fields_ = std::forward_as_tuple(std::move(fields)...); },
+                   traits::tieFields(value));
+        return *this;
+    }
+
+    operator Aggregate() const
+    {
+        return std::apply([](const auto&... fields) { return Aggregate{fields...}; }, fields_);
+    }
+
+    const std::tuple<Refs...>& tie() const { return fields_; }
+
+    template<std::size_t Index>
+    decltype(auto) get() const
+    {
+        return std::get<Index>(fields_);
+    }
+
+    friend bool operator==(const SoaRow& lhs, const SoaRow& rhs) { return lhs.fields_ == rhs.fields_; }
+    friend bool operator!=(const SoaRow& lhs, const SoaRow& rhs) { return not(lhs == rhs); }
+    friend bool operator==(const SoaRow& lhs, const Aggregate& rhs) { return lhs.fields_ == traits::tieFields(rhs); }
+    friend bool operator==(const Aggregate& lhs, const SoaRow& rhs) { return rhs == lhs; }
+    friend bool operator!=(const SoaRow& lhs, const Aggregate& rhs) { return not(lhs == rhs); }
+    friend bool operator!=(const Aggregate& lhs, const SoaRow& rhs) { return not(rhs == lhs); }
+
+private:
+    mutable std::tuple<Refs...> fields_;
+};
+
+template<std::size_t Index, typename Aggregate, typename... Refs>
+decltype(auto) get(const SoaRow<Aggregate, Refs...>& row)
+{
+    return row.template get<Index>();
+}
+
+namespace detail
+{
+template<typename Aggregate, typename Fields>
+struct SoaTraits;
+
+template<typename Aggregate, typename... Fields>
+struct SoaTraits<Aggregate, traits::TypeList<Fields...>>
+{
+    static_assert(not(std::is_reference_v<Fields> or ...), "soa_vector can not store reference members");
+
+    using Columns = std::tuple<utils::vector<std::remove_cv_t<Fields>>...>;
+    using Row = SoaRow<Aggregate, std::remove_cv_t<Fields>&...>;
+    using ConstRow = SoaRow<Aggregate, const std::remove_cv_t<Fields>&...>;
+};
+
+// Random access iterator over rows, dereferencing gives a SoaRow by value.
+template<typename Soa, typename Row>
+class SoaIterator
+{
+public:
+    using iterator_category = std::random_access_iterator_tag;
+    using value_type = typename std::remove_const_t<Soa>::value_type;
+    using difference_type = std::ptrdiff_t;
+    using reference = Row;
+    using pointer = void;
+
+    SoaIterator() = default;
+    SoaIterator(Soa* soa, std::size_t index)
+        : soa_{soa}, index_{index}
+    {}
+
+    Row operator*() const { return (*soa_)[index_]; }
+    Row operator[](difference_type offset) const { return (*soa_)[index_ + static_cast<std::size_t>(offset)]; }
+
+    SoaIterator& operator++()
+    {
+        ++index_;
+        return *this;
+    }
+
+    SoaIterator operator++(int)
+    {
+        auto copy = *this;
+        ++index_;
+        return copy;
+    }
+
+    SoaIterator& operator--()
+    {
+        --index_;
+        return *this;
+    }
+
+    SoaIterator operator--(int)
+    {
+        auto copy = *this;
+        --index_;
+        return copy;
+    }
+
+    SoaIterator& operator+=(difference_type offset)
+    {
+        index_ = static_cast<std::size_t>(static_cast<difference_type>(index_) + offset);
+        return *this;
+    }
+
+    SoaIterator& operator-=(difference_type offset) { return *this += -offset; }
+
+    friend SoaIterator operator+(SoaIterator it, difference_type offset) { return it += offset; }
+    friend SoaIterator operator+(difference_type offset, SoaIterator it) { return it += offset; }
+    friend SoaIterator operator-(SoaIterator it, difference_type offset) { return it -= offset; }
+
+    friend difference_type operator-(const SoaIterator& lhs, const SoaIterator& rhs)
+    {
+        return static_cast<difference_type>(lhs.index_) - static_cast<difference_type>(rhs.index_);
+    }
+
+    friend bool operator==(const SoaIterator& lhs, const SoaIterator& rhs) { return lhs.index_ == rhs.index_; }
+    friend bool operator!=(const SoaIterator& lhs, const SoaIterator& rhs) { return lhs.index_ != rhs.index_; }
+    friend bool operator<(const SoaIterator& lhs, const SoaIterator& rhs) { return lhs.index_ < rhs.index_; }
+    friend bool operator>(const SoaIterator& lhs, const SoaIterator& rhs) { return lhs.index_ > rhs.index_; }
+    friend bool operator<=(const SoaIterator& lhs, const SoaIterator& rhs) { return lhs.index_ <= rhs.index_; }
+    friend bool operator>=(const SoaIterator& lhs, const SoaIterator& rhs) { return lhs.index_ >= rhs.index_; }
+
+private:
+    Soa* soa_{};
+    std::size_t index_{};
+};
+}
+
+// Stores a reflectable aggregate (see traits::is_reflectable) as one utils::vector per
+// field, so a scan over one field reads only that field's memory. Rows are proxies,
+// columns are contiguous spans.
+template<typename Aggregate>
+class soa_vector
+{
+    static_assert(traits::is_reflectable<Aggregate>, "soa_vector needs an aggregate with 1 to 16 fields");
+
+    using Traits = detail::SoaTraits<Aggregate, traits::declared_fields_t<Aggregate>>;
+    static constexpr std::size_t fieldCount{std::tuple_size_v<typename Traits::Columns>};
+
+public:
+    using value_type = Aggregate;
+    using size_type = std::size_t;
+    using difference_type = std::ptrdiff_t;
+    using reference = typename Traits::Row;
+    using const_reference = typename Traits::ConstRow;
+    using iterator = detail::SoaIterator<soa_vector, reference>;
+    using const_iterator = detail::SoaIterator<const soa_vector, const_reference>;
+
+    template<std::size_t Index>
+    using column_type = typename std::tuple_element_t<Index, typename Traits::Columns>::value_type;
+
+    soa_vector() = default;
+
+    soa_vector(std::initializer_list<Aggregate> values)
+    {
+        reserve(values.size());
+        for(const auto& value : values)
+        {
+            push_back(value);
+        }
+    }
+
+    size_type size() const { return std::get<0>(columns_).size(); }
+    bool empty() const { return size() == 0; }
+
+    void reserve(size_type capacity)
+    {
+        std::apply([capacity](auto&... columns) { (columns.reserve(capacity), ...); }, columns_);
+    }
+
+    void push_back(const Aggregate& value)
+    {
+        pushFields(traits::tieFields(value), std::make_index_sequence<fieldCount>{});
+    }
+
+    void push_back(Aggregate&& value)
+    {
+        std::apply([this](auto&... fields) { pushFields(std::forward_as_tuple(std::move(fields)...), std::make_index_sequence<fieldCount>{}); },
+                   traits::tieFields(value));
+    }
+
+    // One argument per field, in declaration order.
+    template<typename... Args>
+    reference emplace_back(Args&&... args)
+    {
+        static_assert(sizeof...(Args) == fieldCount, "emplace_back takes one argument per field");
+        pushFields(std::forward_as_tuple(std::forward<Args>(args)...), std::make_index_sequence<fieldCount>{});
+        return back();
+    }
+
+    void pop_back()
+    {
+        std::apply([](auto&... columns) { (columns.pop_back(), ...); }, columns_);
+    }
+
+    void resize(size_type size)
+    {
+        resizeColumns(size, std::make_index_sequence<fieldCount>{});
+    }
+
+    void clear()
+    {
+        std::apply([](auto&... columns) { (columns.clear(), ...); }, columns_);
+    }
+
+    reference operator[](size_type index) { return row<reference>(*this, index, std::make_index_sequence<fieldCount>{}); }
+
+    const_reference operator[](size_type index) const
+    {
+        return row<const_reference>(*this, index, std::make_index_sequence<fieldCount>{});
+    }
+
+    reference at(size_type index)
+    {
+        checkIndex(index);
+        return (*this)[index];
+    }
+
+    const_reference at(size_type index) const
+    {
+        checkIndex(index);
+        return (*this)[index];
+    }
+
+    reference front() { return (*this)[0]; }
+    const_reference front() const { return (*this)[0]; }
+    reference back() { return (*this)[size() - 1]; }
+    const_reference back() const { return (*this)[size() - 1]; }
+
+    iterator begin() { return {this, 0}; }
+    iterator end() { return {this, size()}; }
+    const_iterator begin() const { return {this, 0}; }
+    const_iterator end() const { return {this, size()}; }
+    const_iterator cbegin() const { return begin(); }
+    const_iterator cend() const { return end(); }
+
+    template<std::size_t Index>
+    ColumnSpan<column_type<Index>> column()
+    {
+        auto& column = std::get<Index>(columns_);
+        return {column.data(), column.size()};
+    }
+
+    template<std::size_t Index>
+    ColumnSpan<const column_type<Index>> column() const
+    {
+        const auto& column = std::get<Index>(columns_);
+        return {column.data(), column.size()};
+    }
+
+private:
+    void checkIndex(size_type index) const
+    {
+        if(index >= size())
+        {
+            throw std::out_of_range{"soa_vector::at"};
+        }
+    }
+
+    // Each column grows on its own, arguments may refer into the columns and
+    // vector::emplace_back builds the element before it relocates. When one throws, the
+    // columns already filled are shrunk back so all stay in step.
+    template<typename Fields, std::size_t... Is>
+    void pushFields(Fields&& fields, std::index_sequence<Is...>)
+    {
+        std::size_t filled{};
+        try
+        {
+            ((std::get<Is>(columns_).emplace_back(std::get<Is>(std::forward<Fields>(fields))), ++filled), ...);
+        }
+        catch(...)
+        {
+            ((Is < filled ? std::get<Is>(columns_).pop_back() : void()), ...);
+            throw;
+        }
+    }
+
+    // Only growing can throw, the columns already grown are then shrunk back like in
+    // pushFields().
+    template<std::size_t... Is>
+    void resizeColumns(size_type size, std::index_sequence<Is...>)
+    {
+        const auto previous = this->size();
+        std::size_t resized{};
+        try
+        {
+            ((std::get<Is>(columns_).resize(size), ++resized), ...);
+        }
+        catch(...)
+        {
+            ((Is < resized ? std::get<Is>(columns_).resize(previous) : void()), ...);
+            throw;
+        }
+    }
+
+    template<typename Row, typename Self, std::size_t... Is>
+    static Row row(Self& self, size_type index, std::index_sequence<Is...>)
+    {
+        return Row{std::get<Is>(self.columns_)[index]...};
+    }
+
+    typename Traits::Columns columns_;
+};
+}
+
+namespace std
+{
+template<typename Aggregate, typename... Refs>
+struct tuple_size<utils::SoaRow<Aggregate, Refs...>> : std::integral_constant<std::size_t, sizeof...(Refs)>
+{};
+
+template<std::size_t Index, typename Aggregate, typename... Refs>
+struct tuple_element<Index, utils::SoaRow<Aggregate, Refs...>>
+{
+    using type = std::tuple_element_t<Index, std::tuple<Refs...>>;
+};
+}
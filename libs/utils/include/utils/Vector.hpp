@@ -0,0 +1,446 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <memory_resource>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include "traits/IsTriviallyRelocatable.hpp"
+#include "utils/CompressedPair.hpp"
+
+namespace utils
+{
+// Vector whose storage and elements go through Allocator. Elements are constructed with
+// allocator_traits::construct, so a polymorphic_allocator hands its resource on to
+// allocator-aware elements such as std::pmr::string.
+template<typename T, typename Allocator = std::allocator<T>>
+class vector
+{
+    using AllocatorTraits = std::allocator_traits<Allocator>;
+
+public:
+    using value_type = T;
+    using allocator_type = Allocator;
+    using size_type = std::size_t;
+    using difference_type = std::ptrdiff_t;
+    using reference = T&;
+    using const_reference = const T&;
+    using pointer = T*;
+    using const_pointer = const T*;
+    using iterator = T*;
+    using const_iterator = const T*;
+
+    vector() noexcept(noexcept(Allocator())) = default;
+
+    explicit vector(const Allocator& allocator) noexcept
+        : storage_{allocator, nullptr}
+    {}
+
+    // The filling constructors delegate to this one, so ~vector frees what they built
+    // when an element constructor throws halfway.
+    explicit vector(size_type count, const Allocator& allocator = Allocator())
+        : vector(allocator)
+    {
+        resize(count);
+    }
+
+    vector(size_type count, const T& value, const Allocator& allocator = Allocator())
+        : vector(allocator)
+    {
+        resize(count, value);
+    }
+
+    template<typename Iterator, typename = typename std::iterator_traits<Iterator>::iterator_category>
+    vector(Iterator first, Iterator last, const Allocator& allocator = Allocator())
+        : vector(allocator)
+    {
+        if constexpr(std::is_base_of_v<std::forward_iterator_tag, typename std::iterator_traits<Iterator>::iterator_category>)
+        {
+            reserve(static_cast<size_type>(std::distance(first, last)));
+        }
+        for(; first != last; ++first)
+        {
+            emplace_back(*first);
+        }
+    }
+
+    vector(std::initializer_list<T> values, const Allocator& allocator = Allocator())
+        : vector(values.begin(), values.end(), allocator)
+    {}
+
+    vector(const vector& other)
+        : vector(other, AllocatorTraits::select_on_container_copy_construction(other.storedAllocator()))
+    {}
+
+    vector(const vector& other, const Allocator& allocator)
+        : vector(other.begin(), other.end(), allocator)
+    {}
+
+    vector(vector&& other) noexcept
+        : storage_{std::move(other.storedAllocator()), nullptr}
+    {
+        steal(other);
+    }
+
+    // Takes the buffer only if allocator can free it, otherwise moves the elements over.
+    vector(vector&& other, const Allocator& allocator)
+        : vector(allocator)
+    {
+        if(storedAllocator() == other.storedAllocator())
+        {
+            steal(other);
+        }
+        else
+        {
+            reserve(other.size_);
+            for(auto& element : other)
+            {
+                emplace_back(std::move(element));
+            }
+        }
+    }
+
+    vector& operator=(const vector& other)
+    {
+        if(this != &other)
+        {
+            clear();
+            if constexpr(AllocatorTraits::propagate_on_container_copy_assignment::value)
+            {
+                if(storedAllocator() != other.storedAllocator())
+                {
+                    deallocate();
+                }
+                storedAllocator() = other.storedAllocator();
+            }
+            reserve(other.size_);
+            for(const auto& element : other)
+            {
+                emplace_back(element);
+            }
+        }
+        return *this;
+    }
+
+    vector& operator=(vector&& other) noexcept(AllocatorTraits::propagate_on_container_move_assignment::value or
+                                               AllocatorTraits::is_always_equal::value)
+    {
+        if(this == &other)
+        {
+            return *this;
+        }
+        clear();
+        if constexpr(AllocatorTraits::propagate_on_container_move_assignment::value)
+        {
+            deallocate();
+            storedAllocator() = std::move(other.storedAllocator());
+            steal(other);
+        }
+        else if(storedAllocator() == other.storedAllocator())
+        {
+            deallocate();
+            steal(other);
+        }
+        else
+        {
+            reserve(other.size_);
+            for(auto& element : other)
+            {
+                emplace_back(std::move(element));
+            }
+            other.clear();
+        }
+        return *this;
+    }
+
+    ~vector()
+    {
+        clear();
+        deallocate();
+    }
+
+    allocator_type get_allocator() const { return storedAllocator(); }
+
+    iterator begin() { return elements(); }
+    iterator end() { return elements() + size_; }
+    const_iterator begin() const { return elements(); }
+    const_iterator end() const { return elements() + size_; }
+    const_iterator cbegin() const { return elements(); }
+    const_iterator cend() const { return elements() + size_; }
+
+    T* data() { return elements(); }
+    const T* data() const { return elements(); }
+    size_type size() const { return size_; }
+    size_type capacity() const { return capacity_; }
+    bool empty() const { return size_ == 0; }
+
+    T& operator[](size_type index) { return elements()[index]; }
+    const T& operator[](size_type index) const { return elements()[index]; }
+
+    T& at(size_type index)
+    {
+        checkIndex(index);
+        return elements()[index];
+    }
+
+    const T& at(size_type index) const
+    {
+        checkIndex(index);
+        return elements()[index];
+    }
+
+    T& front() { return elements()[0]; }
+    const T& front() const { return elements()[0]; }
+    T& back() { return elements()[size_ - 1]; }
+    const T& back() const { return elements()[size_ - 1]; }
+
+    void reserve(size_type capacity)
+    {
+        if(capacity > capacity_)
+        {
+            reallocate(capacity);
+        }
+    }
+
+    template<typename... Args>
+    T& emplace_back(Args&&... args)
+    {
+        if(size_ == capacity_)
+        {
+            return growAndEmplace(std::forward<Args>(args)...);
+        }
+        AllocatorTraits::construct(storedAllocator(), elements() + size_, std::forward<Args>(args)...);
+        return elements()[size_++];
+    }
+
+    void push_back(const T& value) { emplace_back(value); }
+    void push_back(T&& value) { emplace_back(std::move(value)); }
+
+    void pop_back()
+    {
+        AllocatorTraits::destroy(storedAllocator(), elements() + --size_);
+    }
+
+    void resize(size_type size)
+    {
+        resizeWith(size, [this](T* element) { AllocatorTraits::construct(storedAllocator(), element); });
+    }
+
+    void resize(size_type size, const T& value)
+    {
+        // value may be one of the elements, reallocating would free it before the copies.
+        if(size > capacity_)
+        {
+            const T copy = value;
+            reallocate(grownCapacity(size));
+            return resize(size, copy);
+        }
+        resizeWith(size, [this, &value](T* element) { AllocatorTraits::construct(storedAllocator(), element, value); });
+    }
+
+    void clear()
+    {
+        destroy(elements(), elements() + size_);
+        size_ = 0;
+    }
+
+    void swap(vector& other) noexcept
+    {
+        if constexpr(AllocatorTraits::propagate_on_container_swap::value)
+        {
+            std::swap(storedAllocator(), other.storedAllocator());
+        }
+        std::swap(elements(), other.elements());
+        std::swap(size_, other.size_);
+        std::swap(capacity_, other.capacity_);
+    }
+
+    friend void swap(vector& lhs, vector& rhs) noexcept
+    {
+        lhs.swap(rhs);
+    }
+
+    friend bool operator==(const vector& lhs, const vector& rhs)
+    {
+        return std::equal(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
+    }
+
+    friend bool operator!=(const vector& lhs, const vector& rhs)
+    {
+        return not(lhs == rhs);
+    }
+
+private:
+    Allocator& storedAllocator() { return storage_.first(); }
+    const Allocator& storedAllocator() const { return storage_.first(); }
+    T*& elements() { return storage_.second(); }
+    T* elements() const { return storage_.second(); }
+
+    void checkIndex(size_type index) const
+    {
+        if(index >= size_)
+        {
+            throw std::out_of_range{"vector::at"};
+        }
+    }
+
+    void destroy(T* first, T* last)
+    {
+        if constexpr(not std::is_trivially_destructible_v<T>)
+        {
+            for(; first != last; ++first)
+            {
+                AllocatorTraits::destroy(storedAllocator(), first);
+            }
+        }
+    }
+
+    void deallocate()
+    {
+        if(elements() != nullptr)
+        {
+            AllocatorTraits::deallocate(storedAllocator(), elements(), capacity_);
+            elements() = nullptr;
+            capacity_ = 0;
+        }
+    }
+
+    void steal(vector& other)
+    {
+        elements() = std::exchange(other.elements(), nullptr);
+        size_ = std::exchange(other.size_, 0);
+        capacity_ = std::exchange(other.capacity_, 0);
+    }
+
+    // Moves the elements into uninitialized storage at to and ends their lifetime. The old
+    // elements are destroyed only once every new one is built, so a throwing copy leaves
+    // the vector untouched and to empty.
+    void relocate(T* to)
+    {
+        if constexpr(traits::is_trivially_relocatable<T>)
+        {
+            if(size_ != 0)
+            {
+                std::memcpy(static_cast<void*>(to), static_cast<const void*>(elements()), size_ * sizeof(T));
+            }
+        }
+        else
+        {
+            size_type index = 0;
+            try
+            {
+                for(; index < size_; ++index)
+                {
+                    AllocatorTraits::construct(storedAllocator(), to + index, std::move_if_noexcept(elements()[index]));
+                }
+            }
+            catch(...)
+            {
+                destroy(to, to + index);
+                throw;
+            }
+            destroy(elements(), elements() + size_);
+        }
+    }
+
+    size_type grownCapacity(size_type required) const
+    {
+        return std::max(required, 2 * capacity_);
+    }
+
+    void reallocate(size_type capacity)
+    {
+        T* data = AllocatorTraits::allocate(storedAllocator(), capacity);
+        try
+        {
+            relocate(data);
+        }
+        catch(...)
+        {
+            AllocatorTraits::deallocate(storedAllocator(), data, capacity);
+            throw;
+        }
+        deallocate();
+        elements() = data;
+        capacity_ = capacity;
+    }
+
+    // The new element is constructed before the old ones move, args may refer into them.
+    template<typename... Args>
+    T& growAndEmplace(Args&&... args)
+    {
+        const auto capacity = grownCapacity(size_ + 1);
+        T* data = AllocatorTraits::allocate(storedAllocator(), capacity);
+        try
+        {
+            AllocatorTraits::construct(storedAllocator(), data + size_, std::forward<Args>(args)...);
+        }
+        catch(...)
+        {
+            AllocatorTraits::deallocate(storedAllocator(), data, capacity);
+            throw;
+        }
+        try
+        {
+            relocate(data);
+        }
+        catch(...)
+        {
+            AllocatorTraits::destroy(storedAllocator(), data + size_);
+            AllocatorTraits::deallocate(storedAllocator(), data, capacity);
+            throw;
+        }
+        deallocate();
+        elements() = data;
+        capacity_ = capacity;
+        return elements()[size_++];
+    }
+
+    template<typename Construct>
+    void resizeWith(size_type size, Construct construct)
+    {
+        if(size < size_)
+        {
+            destroy(elements() + size, elements() + size_);
+            size_ = size;
+            return;
+        }
+        if(size > capacity_)
+        {
+            reallocate(grownCapacity(size));
+        }
+        for(; size_ < size; ++size_)
+        {
+            construct(elements() + size_);
+        }
+    }
+
+    // Stateless allocators take no space, like in std::vector.
+    compressed_pair<Allocator, T*> storage_{};
+    size_type size_{};
+    size_type capacity_{};
+};
+
+template<typename Iterator, typename Allocator = std::allocator<typename std::iterator_traits<Iterator>::value_type>,
+         typename = typename std::iterator_traits<Iterator>::iterator_category, typename = typename Allocator::value_type>
+vector(Iterator, Iterator, Allocator = Allocator())
+    -> vector<typename std::iterator_traits<Iterator>::value_type, Allocator>;
+
+// vector v(first, last, &arena) allocates from the memory resource.
+template<typename Iterator, typename Resource, typename = typename std::iterator_traits<Iterator>::iterator_category,
+         typename = std::enable_if_t<std::is_base_of_v<std::pmr::memory_resource, Resource>>>
+vector(Iterator, Iterator, Resource*)
+    -> vector<typename std::iterator_traits<Iterator>::value_type,
+              std::pmr::polymorphic_allocator<typename std::iterator_traits<Iterator>::value_type>>;
+
+namespace pmr
+{
+template<typename T>
+using vector = utils::vector<T, std::pmr::polymorphic_allocator<T>>;
+}
+}
@@ -0,0 +1,294 @@
+#include <gtest/gtest.h>
+#include "utils/AsyncLog.hpp"
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <future>
+#include <map>
+#include <mutex>
+#include <sstream>
+#include <stdexcept>
+#include <streambuf>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace ::testing;
+
+namespace
+{
+// Stream buffer whose first write blocks until release() is called, which keeps the
+// background thread of the log busy while the test fills the ring.
+class StallingBuffer : public std::stringbuf
+{
+public:
+    void waitUntilStalled() { stalled_.get_future().wait(); }
+    void release() { released_.set_value(); }
+
+protected:
+    std::streamsize xsputn(const char* text, std::streamsize count) override
+    {
+        if(first_)
+        {
+            first_ = false;
+            stalled_.set_value();
+            released_.get_future().wait();
+        }
+        return std::stringbuf::xsputn(text, count);
+    }
+
+private:
+    bool first_{true};
+    std::promise<void> stalled_;
+    std::promise<void> released_;
+};
+
+// Stream buffer the test may read while the background thread of the log writes to it.
+// xsputn of std::stringbuf calls overflow, hence the recursive mutex.
+class LockedBuffer : public std::stringbuf
+{
+public:
+    std::string text()
+    {
+        std::lock_guard<std::recursive_mutex> lock{mutex_};
+        return str();
+    }
+
+protected:
+    std::streamsize xsputn(const char* text, std::streamsize count) override
+    {
+        std::lock_guard<std::recursive_mutex> lock{mutex_};
+        return std::stringbuf::xsputn(text, count);
+    }
+
+    int_type overflow(int_type c) override
+    {
+        std::lock_guard<std::recursive_mutex> lock{mutex_};
+        return std::stringbuf::overflow(c);
+    }
+
+private:
+    std::recursive_mutex mutex_;
+};
+
+struct Celsius
+{
+    double degrees;
+};
+
+std::ostream& operator<<(std::ostream& os, const Celsius& celsius)
+{
+    return os << celsius.degrees << " C";
+}
+
+struct ThrowingCopy
+{
+    ThrowingCopy() = default;
+    ThrowingCopy(const ThrowingCopy&) { throw std::runtime_error{"copy"}; }
+};
+
+std::ostream& operator<<(std::ostream& os, const ThrowingCopy&)
+{
+    return os << "never";
+}
+
+struct ThrowingFormat
+{
+};
+
+std::ostream& operator<<(std::ostream&, const ThrowingFormat&)
+{
+    throw std::runtime_error{"format"};
+}
+
+std::vector<std::string> lines(const std::string& text)
+{
+    std::vector<std::string> result;
+    std::istringstream stream{text};
+    for(std::string line; std::getline(stream, line);)
+    {
+        result.push_back(line);
+    }
+    return result;
+}
+}
+
+TEST(AsyncLogTests, shouldFormatValuesOnBackgroundThread)
+{
+    std::ostringstream os;
+    {
+        utils::AsyncLog log{os};
+        log.log("Test ", 1, ' ', std::vector<int>{1, 2, 3});
+        log.log(std::map<int, std::string>{{1, "Test"}, {2, "Suite"}});
+        log.log(std::string("Simple"), " ", 2.5, ' ', true);
+        log.flush();
+        EXPECT_EQ(os.str(), "Test 1 [1, 2, 3]\n[{1, Test}, {2, Suite}]\nSimple 2.5 1\n");
+        log.log("last");
+    }
+    EXPECT_EQ(os.str(), "Test 1 [1, 2, 3]\n[{1, Test}, {2, Suite}]\nSimple 2.5 1\nlast\n");
+}
+
+TEST(AsyncLogTests, shouldCaptureRecordsLargerThanSlot)
+{
+    std::ostringstream os;
+    utils::AsyncLog log{os};
+    std::array<int, 64> large{};
+    large.fill(7);
+    log.log(large);
+    log.flush();
+    EXPECT_EQ(os.str(), utils::formatRange(large) + "\n");
+}
+
+TEST(AsyncLogTests, shouldDropRecordsWhenFull)
+{
+    StallingBuffer buffer;
+    std::ostream os{&buffer};
+    utils::AsyncLog log{os, {8, utils::OverflowPolicy::Drop}};
+    EXPECT_TRUE(log.log(0));
+    buffer.waitUntilStalled();
+
+    std::size_t accepted{};
+    for(int i = 1; i <= 20; ++i)
+    {
+        accepted += log.log(i);
+    }
+    EXPECT_EQ(accepted, 8u);
+    EXPECT_EQ(log.dropped(), 12u);
+
+    buffer.release();
+    log.flush();
+    EXPECT_EQ(lines(buffer.str()), (std::vector<std::string>{"0", "1", "2", "3", "4", "5", "6", "7", "8"}));
+}
+
+TEST(AsyncLogTests, shouldGrowWhenFull)
+{
+    StallingBuffer buffer;
+    std::ostream os{&buffer};
+    utils::AsyncLog log{os, {4, utils::OverflowPolicy::Grow}};
+    log.log(0);
+    buffer.waitUntilStalled();
+
+    std::vector<std::string> expected{"0"};
+    for(int i = 1; i <= 100; ++i)
+    {
+        EXPECT_TRUE(log.log(i));
+        expected.push_back(std::to_string(i));
+    }
+
+    buffer.release();
+    log.flush();
+    EXPECT_EQ(log.dropped(), 0u);
+    EXPECT_EQ(lines(buffer.str()), expected);
+}
+
+TEST(AsyncLogTests, shouldKeepOrderOfEachProducer)
+{
+    constexpr int producers{4};
+    constexpr int records{2000};
+
+    for(auto policy : {utils::OverflowPolicy::Block, utils::OverflowPolicy::Grow})
+    {
+        std::ostringstream os;
+        {
+            utils::AsyncLog log{os, {16, policy}};
+            std::vector<std::thread> threads;
+            for(int producer = 0; producer < producers; ++producer)
+            {
+                threads.emplace_back([&log, producer] {
+                    for(int i = 0; i < records; ++i)
+                    {
+                        log.log(producer, ' ', i);
+                    }
+                });
+            }
+            for(auto& thread : threads)
+            {
+                thread.join();
+            }
+        }
+
+        std::array<int, producers> next{};
+        const auto written = lines(os.str());
+        ASSERT_EQ(written.size(), static_cast<std::size_t>(producers * records));
+        for(const auto& line : written)
+        {
+            std::istringstream stream{line};
+            int producer{};
+            int i{};
+            stream >> producer >> i;
+            EXPECT_EQ(i, next[producer]++);
+        }
+    }
+}
+
+TEST(AsyncLogTests, shouldWriteOwnRecordsBeforeFlushReturns)
+{
+    constexpr int producers{4};
+    constexpr int records{500};
+
+    LockedBuffer buffer;
+    std::ostream os{&buffer};
+    utils::AsyncLog log{os, {16, utils::OverflowPolicy::Block, std::chrono::microseconds{1}}};
+    std::atomic<int> missing{};
+    std::vector<std::thread> threads;
+    for(int producer = 0; producer < producers; ++producer)
+    {
+        threads.emplace_back([&, producer] {
+            for(int i = 0; i < records; ++i)
+            {
+                const auto line = "<" + std::to_string(producer) + ' ' + std::to_string(i) + ">\n";
+                log.log(line);
+                log.flush();
+                missing += buffer.text().find(line) == std::string::npos;
+            }
+        });
+    }
+    for(auto& thread : threads)
+    {
+        thread.join();
+    }
+    EXPECT_EQ(missing.load(), 0);
+}
+
+TEST(AsyncLogTests, shouldFormatTypesWithOwnStreamOperator)
+{
+    std::ostringstream os;
+    utils::AsyncLog log{os};
+    const std::vector<Celsius> readings{{20.5}, {-3}};
+    log.log("now ", Celsius{21}, ' ', readings, ' ', std::pair<int, Celsius>{1, {2}});
+    log.flush();
+
+    std::ostringstream expected;
+    expected << "now 21 C " << utils::printRange(readings) << " {1, 2 C}\n";
+    EXPECT_EQ(os.str(), expected.str());
+}
+
+TEST(AsyncLogTests, shouldFlushRecordsLoggedAfterFailedCapture)
+{
+    for(int round = 0; round < 100; ++round)
+    {
+        std::ostringstream os;
+        utils::AsyncLog log{os};
+        const ThrowingCopy throwing;
+        EXPECT_THROW(log.log(throwing), std::runtime_error);
+        log.log("after ", round);
+        log.flush();
+        EXPECT_EQ(os.str(), "after " + std::to_string(round) + "\n");
+    }
+}
+
+TEST(AsyncLogTests, shouldKeepWritingAfterFormattingThrows)
+{
+    std::ostringstream os;
+    {
+        utils::AsyncLog log{os};
+        log.log("before ", ThrowingFormat{});
+        log.log(std::array<ThrowingFormat, 200>{});
+        log.log("after");
+        log.flush();
+        EXPECT_EQ(log.failed(), 2u);
+        log.log("last");
+    }
+    EXPECT_EQ(os.str(), "<record could not be formatted>\n<record could not be formatted>\nafter\nlast\n");
+}
@@ -0,0 +1,130 @@
+#include <gtest/gtest.h>
+#include "utils/BinaryCodec.hpp"
+#include "utils/MappedFile.hpp"
+
+#include <array>
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <limits>
+#include <list>
+#include <map>
+#include <set>
+#include <string>
+#include <string_view>
+#include <vector>
+
+using namespace ::testing;
+
+namespace
+{
+struct Point
+{
+    int x;
+    float y;
+
+    bool operator==(const Point& other) const { return x == other.x and y == other.y; }
+};
+
+template<typename T, utils::IntegerEncoding Encoding = utils::IntegerEncoding::Fixed>
+std::optional<T> roundTrip(const T& value)
+{
+    return utils::decodeBinary<T, Encoding>(utils::encodeBinary<Encoding>(value));
+}
+}
+
+TEST(BinaryCodecTests, shouldRoundTripRanges)
+{
+    const std::vector<int> vec_int{1, -2, 3};
+    EXPECT_EQ(roundTrip(vec_int), vec_int);
+    EXPECT_EQ(roundTrip(std::vector<int>{}), std::vector<int>{});
+
+    const std::list<double> list_double{1.5, -2.25};
+    EXPECT_EQ(roundTrip(list_double), list_double);
+
+    const std::map<int, std::vector<std::string>> map_with_vec{{1, {"Test", "Suite"}}, {2, {}}};
+    EXPECT_EQ(roundTrip(map_with_vec), map_with_vec);
+
+    const std::set<std::pair<std::string, bool>> set_pair{{"Test", true}, {"Case", false}};
+    EXPECT_EQ(roundTrip(set_pair), set_pair);
+
+    const std::vector<std::vector<char>> vec_with_vec{{'a', 'b'}, {}, {'c'}};
+    EXPECT_EQ(roundTrip(vec_with_vec), vec_with_vec);
+
+    const std::vector<Point> vec_point{{1, 2.5f}, {-3, 4.0f}};
+    EXPECT_EQ(roundTrip(vec_point), vec_point);
+
+    const std::vector<bool> vec_bool{true, false, true};
+    EXPECT_EQ(roundTrip(vec_bool), vec_bool);
+    EXPECT_EQ((roundTrip<std::vector<bool>, utils::IntegerEncoding::Varint>(vec_bool)), vec_bool);
+    EXPECT_EQ(utils::encodeBinary(vec_bool), utils::encodeBinary(std::array<bool, 3>{true, false, true}));
+
+    // Addresses mean nothing to the decoding side, encodeBinary rejects pointers.
+    static_assert(not utils::detail::is_binary_leaf<int*>);
+    static_assert(not utils::detail::is_binary_leaf<const Point*>);
+}
+
+TEST(BinaryCodecTests, shouldRoundTripVarints)
+{
+    using Encoding = utils::IntegerEncoding;
+    const std::vector<std::int64_t> vec_long{0, -1, 1, std::numeric_limits<std::int64_t>::min(),
+                                             std::numeric_limits<std::int64_t>::max()};
+    EXPECT_EQ((roundTrip<std::vector<std::int64_t>, Encoding::Varint>(vec_long)), vec_long);
+
+    const std::map<unsigned, std::string> map_string{{1, "Test"}, {300, "Suite"}};
+    EXPECT_EQ((roundTrip<std::map<unsigned, std::string>, Encoding::Varint>(map_string)), map_string);
+
+    const std::vector<int> small(100, 5);
+    EXPECT_EQ(utils::encodeBinary<Encoding::Varint>(small).size(), 101u);
+    EXPECT_EQ(utils::encodeBinary<Encoding::Fixed>(small).size(), 404u);
+}
+
+TEST(BinaryCodecTests, shouldEncodeContiguousRangesAsAlignedBlocks)
+{
+    const std::vector<std::int32_t> vec_int{1, 2};
+    const auto bytes = utils::encodeBinary(vec_int);
+    ASSERT_EQ(bytes.size(), 12u);
+    EXPECT_EQ(bytes[0], 2);
+    EXPECT_EQ(bytes.substr(1, 3), std::string(3, '\0'));
+    EXPECT_EQ(bytes.substr(4), std::string(reinterpret_cast<const char*>(vec_int.data()), 8));
+
+    const std::list<std::int32_t> list_int{1, 2};
+    EXPECT_EQ(utils::encodeBinary(list_int), bytes);
+    EXPECT_EQ(utils::decodeBinary<std::list<std::int32_t>>(bytes), list_int);
+}
+
+TEST(BinaryCodecTests, shouldRejectMalformedInput)
+{
+    const auto bytes = utils::encodeBinary(std::vector<std::string>{"Test", "Suite"});
+    EXPECT_FALSE(utils::decodeBinary<std::vector<std::string>>(bytes.substr(0, bytes.size() - 1)));
+    EXPECT_FALSE(utils::decodeBinary<std::vector<std::string>>(bytes + 'x'));
+    EXPECT_FALSE(utils::decodeBinary<std::vector<int>>(std::string("\xff\xff\xff\xff\x0f", 5)));
+    EXPECT_FALSE(utils::decodeBinary<std::vector<bool>>(std::string("\x01\x02", 2)));
+
+    std::vector<std::string> vec_str;
+    auto [ptr, ec] = utils::decodeBinaryFrom(bytes.data(), bytes.data() + 3, vec_str);
+    EXPECT_EQ(ec, std::errc::invalid_argument);
+}
+
+TEST(BinaryCodecTests, shouldDecodeViewsFromMappedFile)
+{
+    const std::string path{::testing::TempDir() + "BinaryCodecTests.bin"};
+    const std::map<std::string, std::vector<double>> map_with_vec{{"Test", {1.5, 2.5}}, {"Suite", {}}};
+    std::ofstream{path, std::ios::binary} << utils::encodeBinary(map_with_vec);
+
+    {
+        const utils::MappedFile file{path};
+        std::vector<std::pair<std::string_view, utils::ArrayView<double>>> views;
+        auto [ptr, ec] = utils::decodeBinaryFrom(file.data(), file.data() + file.size(), views);
+        ASSERT_EQ(ec, std::errc{});
+        EXPECT_EQ(ptr, file.data() + file.size());
+        ASSERT_EQ(views.size(), 2u);
+        EXPECT_EQ(views[0].first, "Suite");
+        EXPECT_TRUE(views[0].second.empty());
+        EXPECT_EQ(views[1].first, "Test");
+        EXPECT_EQ(std::vector<double>(views[1].second.begin(), views[1].second.end()), (std::vector<double>{1.5, 2.5}));
+        EXPECT_GE(views[1].first.data(), file.data());
+        EXPECT_LT(views[1].first.data(), file.data() + file.size());
+    }
+    std::remove(path.c_str());
+}
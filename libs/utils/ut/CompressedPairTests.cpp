@@ -0,0 +1,83 @@
+#include <gtest/gtest.h>
+#include "utils/CompressedPair.hpp"
+#include "utils/Vector.hpp"
+
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <string>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+using namespace ::testing;
+
+namespace
+{
+struct Empty
+{};
+
+struct OtherEmpty
+{};
+
+struct FinalEmpty final
+{};
+}
+
+TEST(CompressedPairTests, shouldTakeNoSpaceForEmptyMembers)
+{
+    static_assert(sizeof(utils::compressed_pair<int, Empty>) == sizeof(int));
+    static_assert(sizeof(utils::compressed_pair<Empty, int*>) == sizeof(int*));
+    static_assert(sizeof(utils::compressed_pair<std::allocator<int>, int*>) == sizeof(int*));
+    static_assert(sizeof(utils::compressed_pair<std::less<int>, std::hash<int>>) == 1);
+    static_assert(sizeof(utils::compressed_pair<Empty, OtherEmpty>) == 1);
+
+    // Two subobjects of one type need two addresses, final classes can not be bases.
+    static_assert(sizeof(utils::compressed_pair<Empty, Empty>) == 2);
+    static_assert(sizeof(utils::compressed_pair<FinalEmpty, int>) == sizeof(std::pair<FinalEmpty, int>));
+
+    // A stateless allocator leaves utils::vector at three pointers, like std::vector.
+    static_assert(sizeof(utils::vector<int>) == 3 * sizeof(void*));
+}
+
+TEST(CompressedPairTests, shouldStayTriviallyCopyableAndRelocatable)
+{
+    static_assert(std::is_trivially_copyable_v<utils::compressed_pair<int, Empty>>);
+    static_assert(std::is_trivially_copyable_v<utils::compressed_pair<int, double>>);
+    static_assert(not std::is_trivially_copyable_v<std::pair<int, double>>);
+    static_assert(not std::is_trivially_copyable_v<utils::compressed_pair<std::string, int>>);
+
+    static_assert(traits::is_trivially_relocatable<utils::compressed_pair<int, Empty>>);
+    static_assert(not traits::is_trivially_relocatable<utils::compressed_pair<std::string, int>>);
+}
+
+TEST(CompressedPairTests, shouldDeduceAndAccessMembers)
+{
+    using namespace std::string_literals;
+    utils::compressed_pair pair{"THX"s, 1011};
+    static_assert(std::is_same_v<decltype(pair), utils::compressed_pair<std::string, int>>);
+    EXPECT_EQ(pair.first(), "THX");
+    EXPECT_EQ(pair.second(), 1011);
+
+    auto& [prefix, number] = pair;
+    number = 1138;
+    EXPECT_EQ(prefix, "THX");
+    EXPECT_EQ(pair.second(), 1138);
+
+    utils::compressed_pair<std::string, int> other{"THZ", 1};
+    swap(pair, other);
+    EXPECT_EQ(other, (utils::compressed_pair<std::string, int>{"THX", 1138}));
+    EXPECT_NE(pair, other);
+}
+
+TEST(CompressedPairTests, shouldBeTupleLike)
+{
+    using Pair = utils::compressed_pair<int, std::string>;
+    static_assert(std::tuple_size_v<Pair> == 2);
+    static_assert(std::is_same_v<std::tuple_element_t<1, Pair>, std::string>);
+
+    Pair pair{1, "one"};
+    EXPECT_EQ(get<0>(pair), 1);
+    const auto moved = get<1>(std::move(pair));
+    EXPECT_EQ(moved, "one");
+}
@@ -0,0 +1,247 @@
+#include <gtest/gtest.h>
+#include "hash/Hash.hpp"
+#include "utils/ConcurrentMap.hpp"
+#include "utils/RangePrinter.hpp"
+
+#include <algorithm>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <tuple>
+#include <vector>
+
+using namespace ::testing;
+using namespace std::string_literals;
+
+namespace
+{
+// Like the fold-expressions exercise: private fields, reachable only through tie().
+class Person
+{
+public:
+    Person(std::string name, std::string surname, unsigned age)
+        : name_{std::move(name)}, surname_{std::move(surname)}, age_{age}
+    {}
+
+    auto tie() const
+    {
+        return std::tie(name_, surname_, age_);
+    }
+
+private:
+    std::string name_;
+    std::string surname_;
+    unsigned age_;
+};
+
+// Copy-only value: copying throws once copiesLeft runs out, construction from a negative id
+// throws right away.
+struct Fragile
+{
+    static inline int alive{};
+    static inline int copiesLeft{-1};
+
+    explicit Fragile(int id)
+        : id{id}
+    {
+        if(id < 0)
+        {
+            throw std::invalid_argument{"id"};
+        }
+        ++alive;
+    }
+    Fragile(const Fragile& other)
+        : id{other.id}
+    {
+        if(copiesLeft-- == 0)
+        {
+            throw std::runtime_error{"copy"};
+        }
+        ++alive;
+    }
+    ~Fragile() { --alive; }
+
+    int id;
+};
+
+template<typename Range>
+std::string toString(const Range& range)
+{
+    std::stringstream os;
+    os << utils::printRange(range);
+    return os.str();
+}
+}
+
+TEST(ConcurrentMapTests, shouldInsertFindAndErase)
+{
+    utils::concurrent_map<std::string, int> map{4};
+
+    EXPECT_EQ(map.shard_count(), 4u);
+    EXPECT_TRUE(map.empty());
+    EXPECT_TRUE(map.try_emplace("one", 1));
+    EXPECT_TRUE(map.insert({"two", 2}));
+    EXPECT_FALSE(map.try_emplace("one", 10));
+    EXPECT_EQ(map.find("one"s), 1);
+
+    EXPECT_FALSE(map.insert_or_assign("one", 11));
+    EXPECT_TRUE(map.insert_or_assign("three", 3));
+    EXPECT_EQ(map.find(std::string_view{"one"}), 11);
+    EXPECT_EQ(map.find("four"), std::nullopt);
+    EXPECT_EQ(map.size(), 3u);
+
+    EXPECT_TRUE(map.update("two", [](int& value) { value *= 10; }));
+    EXPECT_FALSE(map.update("four", [](int& value) { value = 0; }));
+    EXPECT_EQ(map.find("two"), 20);
+
+    EXPECT_EQ(map.erase("two"), 1u);
+    EXPECT_EQ(map.erase("two"), 0u);
+    EXPECT_FALSE(map.contains("two"));
+    EXPECT_EQ(map.size(), 2u);
+
+    map.clear();
+    EXPECT_TRUE(map.empty());
+}
+
+TEST(ConcurrentMapTests, shouldFindTiedKeysThroughTheirTuple)
+{
+    const Person person{"Mariusz", "Kowalski", 25};
+    utils::concurrent_map<Person, std::string> map;
+    map.try_emplace(person, "developer");
+
+    EXPECT_EQ(utils::TiedHash{}(person), hash::hash_tuple(person.tie()));
+    EXPECT_EQ(map.find(std::make_tuple("Mariusz"s, "Kowalski"s, 25u)), "developer");
+    const auto name = "Mariusz"s, surname = "Kowalski"s;
+    const auto age = 25u;
+    EXPECT_TRUE(map.contains(std::tie(name, surname, age)));
+    EXPECT_FALSE(map.contains(std::make_tuple("Mariusz"s, "Kowalski"s, 26u)));
+}
+
+TEST(ConcurrentMapTests, shouldConvertQueriesThatWouldHashApart)
+{
+    utils::concurrent_map<double, int> doubles{4};
+    doubles.try_emplace(1.0, 10);
+    EXPECT_TRUE(doubles.contains(1));
+    EXPECT_EQ(doubles.find(1.0f), 10);
+
+    utils::concurrent_map<long long, int> numbers{4};
+    numbers.try_emplace(-1, 1);
+    numbers.try_emplace(7, 7);
+    EXPECT_EQ(numbers.find(-1), 1);
+    EXPECT_EQ(numbers.find(7u), 7);
+    EXPECT_EQ(numbers.find(static_cast<short>(7)), 7);
+}
+
+TEST(ConcurrentMapTests, shouldGrowAndReuseErasedSlots)
+{
+    utils::concurrent_map<int, int> map{2};
+
+    for(int round = 0; round < 20; ++round)
+    {
+        for(int key = 0; key < 1000; ++key)
+        {
+            map.insert_or_assign(key, key + round);
+        }
+        for(int key = 0; key < 1000; key += 2)
+        {
+            map.erase(key);
+        }
+        ASSERT_EQ(map.size(), 500u);
+    }
+    EXPECT_EQ(map.find(999), 999 + 19);
+    EXPECT_FALSE(map.contains(998));
+
+    map.reserve(100000);
+    EXPECT_EQ(map.find(1), 1 + 19);
+    EXPECT_EQ(map.size(), 500u);
+}
+
+TEST(ConcurrentMapTests, shouldKeepEntriesWhenGrowthCopyThrows)
+{
+    {
+        utils::concurrent_map<int, Fragile> map{1};
+        int inserted{};
+        // The first table has 16 slots and takes 14 keys before it grows.
+        for(; inserted < 14; ++inserted)
+        {
+            map.try_emplace(inserted, inserted);
+        }
+        Fragile::copiesLeft = 5;
+        EXPECT_THROW(map.try_emplace(inserted, inserted), std::runtime_error);
+        Fragile::copiesLeft = -1;
+        EXPECT_EQ(map.size(), 14u);
+        EXPECT_EQ(Fragile::alive, 14);
+        for(int key = 0; key < inserted; ++key)
+        {
+            EXPECT_TRUE(map.visit(key, [key](const Fragile& value) { EXPECT_EQ(value.id, key); }));
+        }
+        EXPECT_TRUE(map.try_emplace(inserted, inserted));
+        EXPECT_EQ(map.size(), 15u);
+    }
+    EXPECT_EQ(Fragile::alive, 0);
+}
+
+TEST(ConcurrentMapTests, shouldNotUseUpSlotsWhenConstructionThrows)
+{
+    utils::detail::SwissTable<int, Fragile> table;
+    const auto hashOf = [](int key) { return static_cast<std::size_t>(key) * 0x9E3779B97F4A7C15u; };
+    table.emplace(hashOf(0), hashOf, std::piecewise_construct, std::forward_as_tuple(0), std::forward_as_tuple(0));
+    const auto capacity = table.capacity();
+    for(int key = 1; key < 100; ++key)
+    {
+        EXPECT_THROW(table.emplace(hashOf(key), hashOf, std::piecewise_construct, std::forward_as_tuple(key),
+                                   std::forward_as_tuple(-1)),
+                     std::invalid_argument);
+    }
+    EXPECT_EQ(table.capacity(), capacity);
+    EXPECT_EQ(table.size(), 1u);
+}
+
+TEST(ConcurrentMapTests, shouldKeepEveryWriteFromManyThreads)
+{
+    constexpr int threadCount = 4;
+    constexpr int keysPerThread = 5000;
+    utils::concurrent_map<int, int> map{8};
+    map.try_emplace(-1, 0);
+
+    std::vector<std::thread> threads;
+    for(int thread = 0; thread < threadCount; ++thread)
+    {
+        threads.emplace_back([&map, thread] {
+            for(int key = thread * keysPerThread; key < (thread + 1) * keysPerThread; ++key)
+            {
+                map.try_emplace(key, key);
+                map.update(-1, [](int& counter) { ++counter; });
+                map.contains(key / 2);
+            }
+        });
+    }
+    for(auto& thread : threads)
+    {
+        thread.join();
+    }
+
+    EXPECT_EQ(map.size(), threadCount * keysPerThread + 1u);
+    EXPECT_EQ(map.find(-1), threadCount * keysPerThread);
+    for(int key = 0; key < threadCount * keysPerThread; ++key)
+    {
+        ASSERT_EQ(map.find(key), key);
+    }
+}
+
+TEST(ConcurrentMapTests, shouldPrintASnapshot)
+{
+    utils::concurrent_map<std::string, int> map;
+    map.try_emplace("Suite", 1);
+    EXPECT_EQ(toString(map), "[{Suite, 1}]");
+    std::stringstream compact;
+    compact << utils::printRange<utils::CompactStyle>(map);
+    EXPECT_EQ(compact.str(), "[{Suite,1}]");
+
+    map.try_emplace("Test", 2);
+    auto snapshot = map.snapshot();
+    std::sort(snapshot.begin(), snapshot.end());
+    EXPECT_EQ(toString(snapshot), "[{Suite, 1}, {Test, 2}]");
+}
@@ -0,0 +1,201 @@
+#include <gtest/gtest.h>
+#include "utils/ConcurrentMap.hpp"
+#include "utils/FdSink.hpp"
+#include "utils/Generator.hpp"
+#include "utils/RangeFormatter.hpp"
+
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+#include <limits>
+#include <list>
+#include <map>
+#include <memory>
+#include <numeric>
+#include <optional>
+#include <sstream>
+#include <string>
+#include <system_error>
+#include <vector>
+
+#include <fcntl.h>
+#include <unistd.h>
+
+using namespace ::testing;
+
+namespace
+{
+// Printable through operator<< only, which writeValue() does not know.
+struct Point
+{
+    int x;
+    int y;
+
+    friend std::ostream& operator<<(std::ostream& os, const Point& point)
+    {
+        return os << '(' << point.x << ' ' << point.y << ')';
+    }
+};
+
+class FdSinkTests : public Test
+{
+protected:
+    FdSinkTests()
+        : fd_{::open(path_.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0600)}
+    {}
+
+    ~FdSinkTests() override
+    {
+        ::close(fd_);
+        std::remove(path_.c_str());
+    }
+
+    std::string written() const
+    {
+        std::ifstream file{path_};
+        return {std::istreambuf_iterator<char>{file}, std::istreambuf_iterator<char>{}};
+    }
+
+    template<typename Printer>
+    static std::string streamed(const Printer& printer)
+    {
+        std::ostringstream os;
+        os << printer;
+        return os.str();
+    }
+
+    const std::string path_{::testing::TempDir() + "FdSinkTests.txt"};
+    const int fd_;
+};
+}
+
+TEST_F(FdSinkTests, shouldWriteSameTextAsStream)
+{
+    const std::vector<int> vec_int{1, -2, 3};
+    const std::map<int, std::vector<std::string>> map_with_vec{{1, {"Test", "Suite"}}, {2, {"Case"}}};
+    const std::list<double> list_double{1.5, 2.0};
+    {
+        utils::FdSink sink{fd_};
+        sink << utils::printRange(vec_int) << '\n'
+             << utils::printRange(map_with_vec) << "\n"
+             << utils::printRange<utils::CompactStyle>(map_with_vec) << std::string("\n")
+             << utils::printRange(list_double, " | ") << ' ' << 42;
+    }
+    EXPECT_EQ(written(), streamed(utils::printRange(vec_int)) + '\n' +
+                         streamed(utils::printRange(map_with_vec)) + '\n' +
+                         streamed(utils::printRange<utils::CompactStyle>(map_with_vec)) + '\n' +
+                         streamed(utils::printRange(list_double, " | ")) + " 42");
+}
+
+TEST_F(FdSinkTests, shouldWriteSameJsonAsStream)
+{
+    const std::vector<std::string> vec_str{"a\"b", "c,d", std::string(utils::FdSink::borrowThreshold, 'e') + "\n"};
+    const std::map<char, std::vector<bool>> map_flags{{'x', {true, false}}};
+    const std::vector<double> vec_double{0.5, std::numeric_limits<double>::quiet_NaN()};
+    {
+        utils::FdSink sink{fd_};
+        sink << utils::printRange<utils::JsonStyle>(vec_str) << '\n'
+             << utils::printRange<utils::JsonStyle>(map_flags) << '\n'
+             << utils::printRange<utils::JsonStyle>(vec_double);
+    }
+    EXPECT_EQ(written(), streamed(utils::printRange<utils::JsonStyle>(vec_str)) + '\n' +
+                         streamed(utils::printRange<utils::JsonStyle>(map_flags)) + '\n' +
+                         streamed(utils::printRange<utils::JsonStyle>(vec_double)));
+    EXPECT_EQ(streamed(utils::printRange<utils::JsonStyle>(map_flags)), R"([["x",[true,false]]])");
+
+    std::string text;
+    utils::StringWriter writer{text};
+    utils::writeRange<utils::JsonStyle>(writer, vec_str.begin(), vec_str.begin() + 2, utils::JsonStyle::delimiter);
+    EXPECT_EQ(text, R"(["a\"b","c,d"])");
+}
+
+TEST_F(FdSinkTests, shouldBorrowLongStrings)
+{
+    const std::vector<std::string> vec_str{std::string(1000, 'a'), "short", std::string(utils::FdSink::borrowThreshold, 'b')};
+    auto sink = std::make_unique<utils::FdSink>(fd_);
+    *sink << utils::printRange(vec_str);
+    EXPECT_FALSE(sink->hasBorrowed());
+    EXPECT_EQ(written(), utils::formatRange(vec_str));
+}
+
+TEST_F(FdSinkTests, shouldCopyLongStringsOfSinglePassRanges)
+{
+    auto makeLines = [] {
+        return utils::generator<std::string>{[index = 0]() mutable -> std::optional<std::string> {
+            ++index;
+            return index <= 20 ? std::optional{std::string(index == 10 ? 70000 : 200, static_cast<char>('a' + index))}
+                               : std::nullopt;
+        }};
+    };
+    {
+        utils::FdSink sink{fd_};
+        sink << utils::printRange(makeLines());
+        sink << makeLines();
+    }
+    const auto expected = utils::formatRange(makeLines());
+    EXPECT_EQ(written(), expected + expected);
+}
+
+TEST_F(FdSinkTests, shouldSplitOutputLargerThanOneBatch)
+{
+    std::vector<long long> vec_long(100000);
+    std::iota(vec_long.begin(), vec_long.end(), -50000);
+    std::vector<std::string> vec_str(3000, std::string(200, 'c'));
+    {
+        utils::FdSink sink{fd_};
+        sink << utils::printRange(vec_long) << utils::printRange(vec_str, "");
+    }
+    EXPECT_EQ(written(), utils::formatRange(vec_long) + utils::formatRange(vec_str, ""));
+}
+
+TEST_F(FdSinkTests, shouldStreamElementsWithJustAnOperator)
+{
+    const std::vector<Point> points{{1, 2}, {3, 4}};
+    const std::map<int, std::vector<Point>> nested{{1, points}};
+    {
+        utils::FdSink sink{fd_};
+        sink << utils::printRange(points) << '\n' << utils::printRange(nested, "; ") << '\n' << points;
+    }
+    EXPECT_EQ(written(), streamed(utils::printRange(points)) + '\n' + streamed(utils::printRange(nested, "; ")) + '\n' +
+                         streamed(utils::printRange(points)));
+}
+
+TEST_F(FdSinkTests, shouldWriteBoundedRanges)
+{
+    std::vector<int> vec_int(100);
+    std::iota(vec_int.begin(), vec_int.end(), 0);
+    const std::vector<Point> points(10, Point{5, 6});
+    {
+        utils::FdSink sink{fd_};
+        sink << utils::printRange(vec_int, utils::PrintLimits{3, 2}) << '\n'
+             << utils::printRange<utils::CompactStyle>(points, utils::PrintLimits{2, 1});
+    }
+    EXPECT_EQ(written(), streamed(utils::printRange(vec_int, utils::PrintLimits{3, 2})) + '\n' +
+                         streamed(utils::printRange<utils::CompactStyle>(points, utils::PrintLimits{2, 1})));
+}
+
+TEST_F(FdSinkTests, shouldWriteSnapshotsOfConcurrentContainers)
+{
+    utils::concurrent_map<int, std::string> map;
+    map.try_emplace(1, "one");
+    map.try_emplace(2, std::string(utils::FdSink::borrowThreshold, 'b'));
+    {
+        utils::FdSink sink{fd_};
+        sink << utils::printRange(map) << '\n' << utils::printRange<utils::JsonStyle>(map) << '\n'
+             << utils::printRange(map, utils::PrintLimits{1});
+    }
+    EXPECT_EQ(written(), streamed(utils::printRange(map)) + '\n' + streamed(utils::printRange<utils::JsonStyle>(map)) +
+                         '\n' + streamed(utils::printRange(map, utils::PrintLimits{1})));
+}
+
+TEST_F(FdSinkTests, shouldReportWriteErrors)
+{
+    utils::FdSink sink{-1};
+    sink.write("Test");
+    EXPECT_THROW(sink.flush(), std::system_error);
+}
+
+TEST(FdSinkBackendTests, shouldAlwaysSupportWritev)
+{
+    EXPECT_TRUE(utils::isFdBackendSupported(utils::FdBackend::Writev));
+}
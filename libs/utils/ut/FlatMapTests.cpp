@@ -0,0 +1,186 @@
+#include <gtest/gtest.h>
+#include "utils/FlatMap.hpp"
+#include "utils/RangePrinter.hpp"
+
+#include <algorithm>
+#include <map>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+using namespace ::testing;
+using namespace std::string_literals;
+
+namespace
+{
+struct Label
+{
+    explicit Label(char text)
+        : text{text}
+    {}
+
+    char text;
+};
+
+// Constructing from a negative number throws.
+struct Positive
+{
+    Positive(int value)
+        : value{value}
+    {
+        if(value < 0)
+        {
+            throw std::invalid_argument{"negative"};
+        }
+    }
+
+    int value;
+};
+
+// Move assignment throws, constructions do not.
+struct Unassignable
+{
+    Unassignable() = default;
+    Unassignable(char text)
+        : text{text}
+    {}
+    Unassignable(const Unassignable&) = default;
+    Unassignable(Unassignable&&) = default;
+    Unassignable& operator=(const Unassignable&) = default;
+    Unassignable& operator=(Unassignable&&)
+    {
+        throw std::runtime_error{"assign"};
+    }
+
+    char text{};
+};
+
+template<typename Range>
+std::string toString(const Range& range)
+{
+    std::stringstream os;
+    os << utils::printRange(range);
+    return os.str();
+}
+}
+
+TEST(FlatMapTests, shouldPrintLikeStdMap)
+{
+    const std::map<int, std::string> map{{2, "Suite"}, {1, "Test"}};
+    const utils::flat_map<int, std::string> flat{{2, "Suite"}, {1, "Test"}};
+
+    EXPECT_EQ(toString(flat), toString(map));
+    EXPECT_EQ(toString(flat.keys()), "[1, 2]");
+    EXPECT_EQ(toString(flat.values()), "[Test, Suite]");
+}
+
+TEST(FlatMapTests, shouldInsertLookUpAndErase)
+{
+    utils::flat_map<std::string, int> map;
+    map["THZ"] = 1012;
+    EXPECT_TRUE(map.try_emplace("THX", 1011).second);
+    EXPECT_FALSE(map.try_emplace("THX", 0).second);
+    EXPECT_FALSE(map.insert({"THZ", 0}).second);
+    EXPECT_TRUE(map.insert_or_assign("ABC", 1).second);
+    EXPECT_FALSE(map.insert_or_assign("ABC", 2).second);
+
+    EXPECT_EQ(toString(map), "[{ABC, 2}, {THX, 1011}, {THZ, 1012}]");
+    EXPECT_EQ(map.at("THX"), 1011);
+    EXPECT_THROW(map.at("XYZ"), std::out_of_range);
+    EXPECT_EQ((*map.find("THZ")).second, 1012);
+    map.find("THZ")->second += 1;
+    EXPECT_EQ(map.find("THZ")->first, "THZ");
+    EXPECT_EQ(std::as_const(map).find("THZ")->second, 1013);
+    map.find("THZ")->second -= 1;
+    EXPECT_EQ(map.find("XYZ"), map.end());
+    EXPECT_EQ(map.lower_bound("B") - map.begin(), 1);
+    EXPECT_EQ(map.upper_bound("THX") - map.begin(), 2);
+
+    for(auto [key, value] : map)
+    {
+        value += static_cast<int>(key.size());
+    }
+    EXPECT_EQ(map.at("ABC"), 5);
+
+    EXPECT_EQ(map.erase("THX"), 1u);
+    EXPECT_EQ(map.erase("THX"), 0u);
+    EXPECT_EQ(toString(map), "[{ABC, 5}, {THZ, 1015}]");
+}
+
+TEST(FlatMapTests, shouldMergeInsertedRangesAndKeepExistingValues)
+{
+    utils::flat_map<int, char> map{{2, 'b'}, {4, 'd'}};
+    const std::vector<std::pair<int, char>> batch{{5, 'e'}, {1, 'a'}, {4, 'x'}, {3, 'c'}, {1, 'y'}};
+    map.insert(batch.begin(), batch.end());
+
+    EXPECT_EQ(toString(map), "[{1, a}, {2, b}, {3, c}, {4, d}, {5, e}]");
+    EXPECT_EQ(map, (utils::flat_map<int, char>{utils::sorted_unique, {{1, 'a'}, {2, 'b'}, {3, 'c'}, {4, 'd'}, {5, 'e'}}}));
+
+    map.insert(utils::sorted_unique, batch.begin() + 1, batch.begin() + 2);
+    EXPECT_EQ(map.size(), 5u);
+
+    // Values without a default constructor are merged into fresh containers instead.
+    utils::flat_map<int, Label> labels;
+    labels.try_emplace(2, 'b');
+    const std::vector<std::pair<int, Label>> newLabels{{3, Label{'c'}}, {1, Label{'a'}}, {2, Label{'x'}}};
+    labels.insert(newLabels.begin(), newLabels.end());
+    std::string texts;
+    for(const auto& [key, label] : labels)
+    {
+        texts += label.text;
+    }
+    EXPECT_EQ(texts, "abc");
+
+    // Values whose move assignment may throw are not merged in place either.
+    const std::vector<std::pair<int, Unassignable>> stored{{2, 'b'}, {4, 'd'}};
+    const std::vector<std::pair<int, Unassignable>> added{{1, 'a'}, {3, 'c'}};
+    utils::flat_map<int, Unassignable> unassignable{utils::sorted_unique, stored.begin(), stored.end()};
+    unassignable.insert(utils::sorted_unique, added.begin(), added.end());
+    texts.clear();
+    for(const auto& [key, value] : unassignable)
+    {
+        texts += value.text;
+    }
+    EXPECT_EQ(texts, "abcd");
+}
+
+TEST(FlatMapTests, shouldDeduceTemplateArguments)
+{
+    // std::map m1{{"THX"s, 1011}, {"THZ"s, 1012}} does not deduce, the pairs have to be spelled.
+    utils::flat_map map{std::pair{"THZ"s, 1012}, std::pair{"THX"s, 1011}};
+    static_assert(std::is_same_v<decltype(map), utils::flat_map<std::string, int>>);
+    EXPECT_EQ(toString(map), "[{THX, 1011}, {THZ, 1012}]");
+
+    const std::map<std::string, int> ordered{{"THX"s, 1011}};
+    utils::flat_map fromIterators(ordered.begin(), ordered.end());
+    static_assert(std::is_same_v<decltype(fromIterators), utils::flat_map<std::string, int>>);
+
+    utils::flat_map fromContainers{std::vector<int>{3, 1, 2}, std::vector<char>{'c', 'a', 'b'}};
+    static_assert(std::is_same_v<decltype(fromContainers),
+                                 utils::flat_map<int, char, std::less<int>, std::vector<int>, std::vector<char>>>);
+    EXPECT_EQ(toString(fromContainers), "[{1, a}, {2, b}, {3, c}]");
+}
+
+TEST(FlatMapTests, shouldRejectContainersOfDifferentSizes)
+{
+    EXPECT_THROW((utils::flat_map<int, char>{utils::vector<int>{3, 1, 2}, utils::vector<char>{'c', 'a'}}),
+                 std::invalid_argument);
+    EXPECT_THROW((utils::flat_map<int, char>{utils::sorted_unique, utils::vector<int>{1}, utils::vector<char>{'a', 'b'}}),
+                 std::invalid_argument);
+}
+
+TEST(FlatMapTests, shouldDropKeyWhenValueConstructorThrows)
+{
+    utils::flat_map<std::string, Positive> map;
+    map.try_emplace("b", 2);
+    EXPECT_THROW(map.try_emplace("a", -1), std::invalid_argument);
+    EXPECT_THROW(map.try_emplace("c", -3), std::invalid_argument);
+
+    EXPECT_EQ(map.size(), 1u);
+    EXPECT_EQ(map.keys().size(), map.values().size());
+    EXPECT_FALSE(map.contains("a"));
+    EXPECT_EQ(map.at("b").value, 2);
+}
@@ -0,0 +1,90 @@
+#include <gtest/gtest.h>
+#include "utils/FlatSet.hpp"
+#include "utils/RangePrinter.hpp"
+
+#include <algorithm>
+#include <functional>
+#include <numeric>
+#include <sstream>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+using namespace ::testing;
+using namespace std::string_literals;
+
+namespace
+{
+template<typename Range>
+std::string toString(const Range& range)
+{
+    std::stringstream os;
+    os << utils::printRange(range);
+    return os.str();
+}
+}
+
+TEST(FlatSetTests, shouldKeepKeysSortedAndUnique)
+{
+    utils::flat_set<int> set{5, 1, 3, 1, 5};
+
+    EXPECT_EQ(toString(set), "[1, 3, 5]");
+    EXPECT_TRUE(set.insert(4).second);
+    EXPECT_FALSE(set.insert(3).second);
+    EXPECT_EQ(*set.emplace(0).first, 0);
+    EXPECT_EQ(toString(set), "[0, 1, 3, 4, 5]");
+
+    EXPECT_EQ(set.erase(3), 1u);
+    EXPECT_EQ(set.erase(3), 0u);
+    EXPECT_EQ(*set.erase(set.find(0)), 1);
+    EXPECT_EQ(toString(set), "[1, 4, 5]");
+}
+
+TEST(FlatSetTests, shouldFindBoundsLikeTheStandardAlgorithms)
+{
+    std::vector<int> keys(100);
+    std::iota(keys.begin(), keys.end(), 0);
+    std::transform(keys.begin(), keys.end(), keys.begin(), [](int key) { return key * 2; });
+    const utils::flat_set<int> set{utils::sorted_unique, keys.begin(), keys.end()};
+
+    for(int key = -1; key <= 200; ++key)
+    {
+        ASSERT_EQ(set.lower_bound(key) - set.begin(), std::lower_bound(keys.begin(), keys.end(), key) - keys.begin());
+        ASSERT_EQ(set.upper_bound(key) - set.begin(), std::upper_bound(keys.begin(), keys.end(), key) - keys.begin());
+        ASSERT_EQ(set.contains(key), key >= 0 and key % 2 == 0 and key < 200);
+    }
+    EXPECT_EQ(utils::flat_set<int>{}.lower_bound(1), utils::flat_set<int>{}.end());
+}
+
+TEST(FlatSetTests, shouldMergeInsertedRanges)
+{
+    utils::flat_set<std::string> set{"b"s, "d"s};
+    const std::vector<std::string> batch{"e", "a", "d", "c", "a"};
+    set.insert(batch.begin(), batch.end());
+    EXPECT_EQ(toString(set), "[a, b, c, d, e]");
+
+    set.insert({"f"s, "0"s});
+    EXPECT_EQ(toString(set), "[0, a, b, c, d, e, f]");
+
+    utils::flat_set<int, std::greater<int>> descending{1, 3, 2};
+    const std::vector<int> sorted{5, 4, 3};
+    descending.insert(utils::sorted_unique, sorted.begin(), sorted.end());
+    EXPECT_EQ(toString(descending), "[5, 4, 3, 2, 1]");
+}
+
+TEST(FlatSetTests, shouldDeduceTemplateArguments)
+{
+    utils::flat_set set{3, 1, 2};
+    static_assert(std::is_same_v<decltype(set), utils::flat_set<int>>);
+
+    const std::vector<long> values{2, 1};
+    utils::flat_set fromIterators(values.begin(), values.end());
+    static_assert(std::is_same_v<decltype(fromIterators), utils::flat_set<long>>);
+
+    utils::flat_set fromContainer{std::vector<char>{'b', 'a'}, std::greater<char>{}};
+    static_assert(std::is_same_v<decltype(fromContainer), utils::flat_set<char, std::greater<char>, std::vector<char>>>);
+    EXPECT_EQ(toString(fromContainer), "[b, a]");
+
+    EXPECT_EQ(set, (utils::flat_set{utils::sorted_unique, {1, 2, 3}}));
+    EXPECT_EQ(std::move(set).extract().size(), 3u);
+}
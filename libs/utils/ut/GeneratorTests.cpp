@@ -0,0 +1,92 @@
+#include <gtest/gtest.h>
+#include "utils/Generator.hpp"
+#include "utils/RangeFormatter.hpp"
+#include "utils/RangePrinter.hpp"
+
+#include <optional>
+#include <sstream>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+using namespace ::testing;
+
+namespace
+{
+// 1, 2, ..., last and counts how often it was asked.
+struct Counter
+{
+    std::optional<int> operator()()
+    {
+        ++*calls;
+        return next <= last ? std::optional<int>{next++} : std::nullopt;
+    }
+
+    int last;
+    int* calls;
+    int next{1};
+};
+}
+
+TEST(GeneratorTests, shouldYieldValuesUntilTheSourceIsExhausted)
+{
+    int calls{};
+    utils::generator<int> numbers{Counter{3, &calls}};
+    EXPECT_EQ(calls, 0);
+
+    std::vector<int> values;
+    for(auto value : numbers)
+    {
+        values.push_back(value);
+    }
+    EXPECT_EQ(values, (std::vector<int>{1, 2, 3}));
+    EXPECT_EQ(calls, 4);
+
+    auto it = numbers.begin();
+    EXPECT_TRUE(it == numbers.end());
+}
+
+TEST(GeneratorTests, shouldPrintWhileValuesAreProduced)
+{
+    int calls{};
+    const utils::generator<int> numbers{Counter{5, &calls}};
+    std::ostringstream os;
+    os << utils::printRange(numbers, " ");
+    EXPECT_EQ(os.str(), "[1 2 3 4 5]");
+
+    utils::generator words{[word = std::string{}]() mutable -> std::optional<std::string> {
+        word += 'a';
+        return word.size() <= 3 ? std::optional{word} : std::nullopt;
+    }};
+    static_assert(std::is_same_v<decltype(words), utils::generator<std::string>>);
+    EXPECT_EQ(utils::formatRange(words), "[a, aa, aaa]");
+}
+
+TEST(GeneratorTests, shouldSharePositionBetweenCopies)
+{
+    int calls{};
+    utils::generator<int> numbers{Counter{4, &calls}};
+    auto copy = numbers;
+
+    auto it = numbers.begin();
+    EXPECT_EQ(*it++, 1);
+    EXPECT_EQ(*it, 2);
+    ++it;
+
+    std::ostringstream os;
+    os << utils::printRange(copy);
+    EXPECT_EQ(os.str(), "[3, 4]");
+    EXPECT_TRUE(it == numbers.end());
+}
+
+TEST(GeneratorTests, shouldPrintIntegersAcrossStagedBatchesLikeAVector)
+{
+    int calls{};
+    const utils::generator<int> numbers{Counter{1000, &calls}};
+    std::vector<int> expected(1000);
+    for(int i = 0; i < 1000; ++i)
+    {
+        expected[static_cast<std::size_t>(i)] = i + 1;
+    }
+    EXPECT_EQ(utils::formatRange(numbers), utils::formatRange(expected));
+}
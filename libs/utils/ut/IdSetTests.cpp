@@ -0,0 +1,102 @@
+#include <gtest/gtest.h>
+#include "utils/IdSet.hpp"
+
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+using namespace ::testing;
+
+namespace
+{
+constexpr unsigned sparseId(std::size_t i)
+{
+    return static_cast<unsigned>(i * 2654435761u % 1000003u);
+}
+
+template<utils::IdStrategy Strategy, unsigned... IDs>
+void expectLookupOf(const std::vector<unsigned>& queries)
+{
+    using Lookup = utils::IdLookup<Strategy, IDs...>;
+    using Reference = utils::IdLookup<utils::IdStrategy::Linear, IDs...>;
+    for(auto id : queries)
+    {
+        EXPECT_EQ(Lookup::contains(id), Reference::contains(id)) << "id " << id;
+        EXPECT_EQ(Lookup::index(id), Reference::index(id)) << "id " << id;
+    }
+}
+
+// Every member, its neighbours and a few far away ids, against the || fold.
+template<unsigned... IDs>
+void expectAllStrategiesAgree()
+{
+    std::vector<unsigned> queries{0, 1, 4294967295u, 4294967294u};
+    for(auto id : {IDs...})
+    {
+        queries.insert(queries.end(), {id - 1, id, id + 1});
+    }
+    if constexpr(utils::detail::idSpan<IDs...> <= utils::detail::maxBitsetSpan)
+    {
+        expectLookupOf<utils::IdStrategy::Bitset, IDs...>(queries);
+    }
+    expectLookupOf<utils::IdStrategy::BinarySearch, IDs...>(queries);
+    expectLookupOf<utils::IdStrategy::PerfectHash, IDs...>(queries);
+}
+
+template<std::size_t... Is>
+void expectSparsePackAgrees(std::index_sequence<Is...>)
+{
+    expectLookupOf<utils::IdStrategy::BinarySearch, sparseId(Is)...>({sparseId(0), sparseId(sizeof...(Is) - 1), 5, 77});
+    expectLookupOf<utils::IdStrategy::PerfectHash, sparseId(Is)...>({sparseId(0), sparseId(sizeof...(Is) - 1), 5, 77});
+    for(std::size_t i = 0; i < sizeof...(Is); ++i)
+    {
+        EXPECT_TRUE((utils::IdSet<sparseId(Is)...>::contains(sparseId(i))));
+        EXPECT_EQ((utils::IdSet<sparseId(Is)...>::index(sparseId(i))), i);
+    }
+    EXPECT_EQ((utils::IdSet<sparseId(Is)...>::index(1)), sizeof...(Is));
+}
+}
+
+TEST(IdSetTests, shouldKeepTheHasIdCallSyntax)
+{
+    static_assert(utils::has_id<100, 200, 300>(100));
+    static_assert(not utils::has_id<100, 200, 300>(400));
+    static_assert(utils::has_id<100>(100));
+    static_assert(utils::index_of_id<100, 200, 300>(300) == 2);
+    static_assert(utils::index_of_id<100, 200, 300>(400) == 3);
+}
+
+TEST(IdSetTests, shouldPickStrategyFromThePack)
+{
+    using utils::IdStrategy;
+    using utils::detail::chooseContainsStrategy;
+    using utils::detail::chooseIndexStrategy;
+    EXPECT_EQ((chooseContainsStrategy<1, 2, 3>()), IdStrategy::Linear);
+    EXPECT_EQ((chooseContainsStrategy<1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 40>()), IdStrategy::Bitset);
+    EXPECT_EQ((chooseContainsStrategy<1, 20000, 3, 4, 5, 6, 7, 8, 9, 10, 40>()), IdStrategy::PerfectHash);
+    EXPECT_EQ((chooseIndexStrategy<1, 2>()), IdStrategy::Linear);
+    EXPECT_EQ((chooseIndexStrategy<1, 2, 3>()), IdStrategy::PerfectHash);
+}
+
+TEST(IdSetTests, shouldAgreeWithTheFoldForEveryStrategy)
+{
+    expectAllStrategiesAgree<100>();
+    expectAllStrategiesAgree<100, 200, 300>();
+    expectAllStrategiesAgree<0, 4294967295u>();
+    expectAllStrategiesAgree<7, 3, 7, 1, 3>();
+    expectAllStrategiesAgree<5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 63, 64, 65, 127, 128>();
+}
+
+TEST(IdSetTests, shouldReturnTheFirstPositionOfDuplicates)
+{
+    EXPECT_EQ((utils::IdLookup<utils::IdStrategy::Linear, 7, 3, 7>::index(7)), 0u);
+    EXPECT_EQ((utils::IdLookup<utils::IdStrategy::Bitset, 7, 3, 7>::index(7)), 0u);
+    EXPECT_EQ((utils::IdLookup<utils::IdStrategy::BinarySearch, 7, 3, 7>::index(3)), 1u);
+    EXPECT_EQ((utils::IdLookup<utils::IdStrategy::PerfectHash, 7, 3, 7>::index(7)), 0u);
+}
+
+TEST(IdSetTests, shouldHashLargeSparsePacks)
+{
+    expectSparsePackAgrees(std::make_index_sequence<100>{});
+    expectSparsePackAgrees(std::make_index_sequence<1024>{});
+}
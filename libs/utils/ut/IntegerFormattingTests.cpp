@@ -0,0 +1,146 @@
+#include <gtest/gtest.h>
+#include "utils/IntegerFormatting.hpp"
+#include "utils/RangeFormatter.hpp"
+#include "utils/RangePrinter.hpp"
+
+#include <array>
+#include <cstdint>
+#include <limits>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace ::testing;
+
+namespace
+{
+const std::array<utils::IntegerKernel, 3> allKernels{
+    utils::IntegerKernel::Scalar, utils::IntegerKernel::Sse2, utils::IntegerKernel::Avx2};
+
+template<typename T>
+std::string expectedText(const std::vector<T>& values, const std::string& delimiter)
+{
+    std::string text;
+    for(std::size_t i = 0; i < values.size(); ++i)
+    {
+        text += (i == 0 ? "" : delimiter) + std::to_string(values[i]);
+    }
+    return text;
+}
+
+template<typename T>
+std::string formatWith(const std::vector<T>& values, const std::string& delimiter, utils::IntegerKernel kernel)
+{
+    std::string text(values.size() * (utils::maxFormattedIntegerSize<T> + delimiter.size()) + utils::formatIntegersPadding,
+                     '\0');
+    auto end = utils::formatIntegers(values.data(), values.data() + values.size(), delimiter, text.data(), kernel);
+    text.resize(static_cast<std::size_t>(end - text.data()));
+    return text;
+}
+
+template<typename T>
+std::vector<T> makeValues()
+{
+    std::vector<T> values{0, 1, 9, 10, 99, 100, std::numeric_limits<T>::max(), std::numeric_limits<T>::min()};
+    for(T power = 1; power <= std::numeric_limits<T>::max() / 10; power *= 10)
+    {
+        values.insert(values.end(), {T(power - 1), power, T(power * 10 - 1)});
+        if constexpr(std::is_signed_v<T>)
+        {
+            values.insert(values.end(), {T(-power), T(1 - power)});
+        }
+    }
+
+    std::mt19937_64 engine{2020};
+    std::uniform_int_distribution<T> distribution{std::numeric_limits<T>::min(), std::numeric_limits<T>::max()};
+    for(int i = 0; i < 1000; ++i)
+    {
+        values.push_back(distribution(engine));
+        values.push_back(static_cast<T>(distribution(engine) % 100000));
+    }
+    return values;
+}
+
+template<typename T>
+void expectAllKernelsMatchToString()
+{
+    const auto values = makeValues<T>();
+    for(auto kernel : allKernels)
+    {
+        if(utils::isIntegerKernelSupported(kernel))
+        {
+            EXPECT_EQ(formatWith(values, ", ", kernel), expectedText(values, ", "));
+            EXPECT_EQ(formatWith(values, "", kernel), expectedText(values, ""));
+        }
+    }
+}
+}
+
+TEST(IntegerFormattingTests, shouldFormatShortIntegers)
+{
+    expectAllKernelsMatchToString<short>();
+    expectAllKernelsMatchToString<unsigned short>();
+}
+
+TEST(IntegerFormattingTests, shouldFormat32BitIntegers)
+{
+    expectAllKernelsMatchToString<std::int32_t>();
+    expectAllKernelsMatchToString<std::uint32_t>();
+}
+
+TEST(IntegerFormattingTests, shouldFormat64BitIntegers)
+{
+    expectAllKernelsMatchToString<std::int64_t>();
+    expectAllKernelsMatchToString<std::uint64_t>();
+}
+
+#ifdef __SIZEOF_INT128__
+TEST(IntegerFormattingTests, shouldLeaveIntegersWiderThan64BitsToTheScalarPath)
+{
+    static_assert(not utils::is_kernel_integer_v<__int128>);
+    static_assert(not utils::is_kernel_integer_v<unsigned __int128>);
+    static_assert(utils::is_kernel_integer_v<std::uint64_t>);
+
+    const std::vector<__int128> wide{static_cast<__int128>(1) << 100, -(static_cast<__int128>(1) << 70)};
+    EXPECT_EQ(utils::formatRange(wide), "[1267650600228229401496703205376, -1180591620717411303424]");
+}
+#endif
+
+TEST(IntegerFormattingTests, shouldFormatSingleElementAndEmptyRange)
+{
+    for(auto kernel : allKernels)
+    {
+        if(utils::isIntegerKernelSupported(kernel))
+        {
+            EXPECT_EQ(formatWith(std::vector<int>{-7}, ", ", kernel), "-7");
+            EXPECT_EQ(formatWith(std::vector<int>{}, ", ", kernel), "");
+        }
+    }
+}
+
+TEST(IntegerFormattingTests, shouldRespectStreamFormattingFlags)
+{
+    std::vector<int> vec_int{10, 255};
+
+    std::stringstream hex_stream;
+    hex_stream << std::hex << utils::printRange(vec_int);
+    EXPECT_EQ(hex_stream.str(), "[a, ff]");
+
+    std::stringstream showpos_stream;
+    showpos_stream << std::showpos << utils::printRange(vec_int);
+    EXPECT_EQ(showpos_stream.str(), "[+10, +255]");
+}
+
+TEST(IntegerFormattingTests, shouldPrintLargeIntegralRangesThroughStream)
+{
+    std::vector<long> vec_long(5000);
+    for(std::size_t i = 0; i < vec_long.size(); ++i)
+    {
+        vec_long[i] = static_cast<long>(i * i) - 1000;
+    }
+
+    std::stringstream stream;
+    stream << utils::printRange(vec_long, ";");
+    EXPECT_EQ(stream.str(), "[" + expectedText(vec_long, ";") + "]");
+}
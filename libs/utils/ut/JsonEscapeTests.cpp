@@ -0,0 +1,72 @@
+#include <gtest/gtest.h>
+#include "utils/JsonEscape.hpp"
+
+#include <array>
+#include <string>
+
+using namespace ::testing;
+
+namespace
+{
+const std::array<utils::EscapeKernel, 3> allKernels{
+    utils::EscapeKernel::Scalar, utils::EscapeKernel::Sse2, utils::EscapeKernel::Avx2};
+
+std::string escapeWith(const std::string& text, utils::EscapeKernel kernel)
+{
+    std::string escaped;
+    utils::escapeJson(text, [&escaped](std::string_view piece) { escaped += piece; }, kernel);
+    return escaped;
+}
+}
+
+TEST(JsonEscapeTests, shouldFindFirstByteToEscapeAtEveryPosition)
+{
+    for(auto kernel : allKernels)
+    {
+        if(not utils::isEscapeKernelSupported(kernel))
+        {
+            continue;
+        }
+        for(char special : {'"', '\\', '\0', '\n', '\x1f'})
+        {
+            for(std::size_t size = 0; size < 80; ++size)
+            {
+                for(std::size_t position = 0; position <= size; ++position)
+                {
+                    // Bytes around the escaped ones that stay as they are.
+                    std::string text;
+                    for(std::size_t i = 0; i < size; ++i)
+                    {
+                        text += "x \x7f\x80!~"[i % 6];
+                    }
+                    if(position < size)
+                    {
+                        text[position] = special;
+                    }
+                    const auto* first = text.data();
+                    EXPECT_EQ(utils::findJsonEscape(first, first + size, kernel) - first,
+                              static_cast<std::ptrdiff_t>(position))
+                        << "size " << size << ", position " << position;
+                }
+            }
+        }
+    }
+}
+
+TEST(JsonEscapeTests, shouldEscapeQuotesBackslashesAndControlCharacters)
+{
+    for(auto kernel : allKernels)
+    {
+        if(utils::isEscapeKernelSupported(kernel))
+        {
+            EXPECT_EQ(escapeWith("", kernel), "");
+            EXPECT_EQ(escapeWith("plain text", kernel), "plain text");
+            EXPECT_EQ(escapeWith("say \"hi\"\\", kernel), "say \\\"hi\\\"\\\\");
+            EXPECT_EQ(escapeWith("a\bb\fc\nd\re\tf", kernel), "a\\bb\\fc\\nd\\re\\tf");
+            EXPECT_EQ(escapeWith(std::string{"\0\x01\x1f", 3}, kernel), "\\u0000\\u0001\\u001f");
+            EXPECT_EQ(escapeWith("za\xc5\xbc\xc3\xb3\xc5\x82\xc4\x87 \x7f", kernel), "za\xc5\xbc\xc3\xb3\xc5\x82\xc4\x87 \x7f");
+            EXPECT_EQ(escapeWith(std::string(40, 'x') + "\"" + std::string(40, 'y'), kernel),
+                      std::string(40, 'x') + "\\\"" + std::string(40, 'y'));
+        }
+    }
+}
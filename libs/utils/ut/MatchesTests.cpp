@@ -0,0 +1,116 @@
+#include <gtest/gtest.h>
+#include "utils/Matches.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <list>
+#include <string>
+#include <vector>
+
+using namespace ::testing;
+
+namespace
+{
+enum class Color : std::uint8_t
+{
+    Red,
+    Green,
+    Blue
+};
+
+constexpr std::array<utils::MatchKernel, 3> kernels{utils::MatchKernel::Scalar, utils::MatchKernel::Avx2,
+                                                    utils::MatchKernel::Avx512};
+
+// Every kernel, and every size around the vector widths, has to agree with std::count.
+template<typename T, typename... Args>
+void expectCountResults(const std::vector<T>& values, const Args&... args)
+{
+    for(auto kernel : kernels)
+    {
+        if(not utils::isMatchKernelSupported(kernel))
+        {
+            continue;
+        }
+        for(std::size_t size : {std::size_t{0}, std::size_t{1}, std::size_t{31}, std::size_t{64}, std::size_t{129}, values.size()})
+        {
+            const std::vector<T> prefix(values.begin(), values.begin() + std::min(size, values.size()));
+            const std::array<std::size_t, sizeof...(Args)> expected{
+                static_cast<std::size_t>(std::count(prefix.begin(), prefix.end(), args))...};
+            EXPECT_EQ(utils::matchCounts(kernel, prefix, args...), expected) << "kernel " << static_cast<int>(kernel);
+
+            std::size_t total{};
+            for(auto count : expected)
+            {
+                total += count;
+            }
+            EXPECT_EQ(utils::matches(kernel, prefix, args...), total) << "kernel " << static_cast<int>(kernel);
+        }
+    }
+}
+
+template<typename T>
+std::vector<T> makeValues(std::size_t size, std::size_t period)
+{
+    std::vector<T> values(size);
+    for(std::size_t i = 0; i < size; ++i)
+    {
+        values[i] = static_cast<T>(i % period);
+    }
+    return values;
+}
+}
+
+TEST(MatchesTests, shouldCountLikeTheFoldOfStdCount)
+{
+    std::vector<int> v{1, 2, 3, 4, 5};
+    EXPECT_EQ(utils::matches(v, 2, 3), 2u);
+    EXPECT_EQ(utils::matches(v, 6, 7, 8), 0u);
+    EXPECT_EQ(utils::matches(v, 2, 2), 2u);
+    EXPECT_EQ(utils::matchCounts(v, 5, 1, 9), (std::array<std::size_t, 3>{1, 1, 0}));
+}
+
+TEST(MatchesTests, shouldCountEveryLaneWidth)
+{
+    expectCountResults(makeValues<std::int8_t>(1000, 7), 0, 3, 6, -1);
+    expectCountResults(makeValues<std::uint16_t>(1000, 11), 1, 10, 12);
+    expectCountResults(makeValues<int>(1000, 13), 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15);
+    expectCountResults(makeValues<std::uint64_t>(1000, 5), 4u, 0u, 4u);
+    expectCountResults(makeValues<double>(1000, 9), 8.0, 0.0, 0.5);
+    expectCountResults(makeValues<float>(1000, 9), 8.0f, 1.0f);
+    expectCountResults(makeValues<Color>(1000, 3), Color::Red, Color::Blue);
+}
+
+TEST(MatchesTests, shouldNotWrapNarrowCounters)
+{
+    const std::vector<std::uint8_t> zeros(100000, 0);
+    expectCountResults(zeros, 0, 0, 1);
+    EXPECT_EQ(utils::matches(zeros, 0, 0, 0), 300000u);
+}
+
+TEST(MatchesTests, shouldKeepMixedTypeComparisons)
+{
+    const std::vector<std::uint8_t> bytes{0, 44, 255, 44};
+    expectCountResults(bytes, 300, -1, 255, 44);
+
+    const std::vector<int> ints{-1, 1, -1};
+    expectCountResults(ints, 4294967295u, 1u, 'a');
+
+    const std::vector<double> doubles{0.0, -0.0, std::nan(""), 1.0};
+    expectCountResults(doubles, 0.0, std::nan(""), 1);
+
+    const std::vector<int> large{16777217, 16777216};
+    expectCountResults(large, 16777216.0f);
+}
+
+TEST(MatchesTests, shouldCountOtherRangesInOnePass)
+{
+    const std::list<std::string> words{"Test", "Suite", "Test", "Case"};
+    EXPECT_EQ(utils::matches(words, "Test", std::string{"Case"}), 3u);
+    EXPECT_EQ(utils::matchCounts(words, "Suite", "Test"), (std::array<std::size_t, 2>{1, 2}));
+
+    const int array[]{1, 2, 2, 3};
+    EXPECT_EQ(utils::matches(array, 2, 3), 3u);
+}
@@ -0,0 +1,88 @@
+#include <gtest/gtest.h>
+#include "utils/MonotonicArena.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <memory_resource>
+
+using namespace ::testing;
+
+namespace
+{
+struct CountingResource : std::pmr::memory_resource
+{
+    std::size_t allocations{};
+    std::size_t deallocations{};
+
+    void* do_allocate(std::size_t bytes, std::size_t alignment) override
+    {
+        ++allocations;
+        return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+    }
+
+    void do_deallocate(void* pointer, std::size_t bytes, std::size_t alignment) override
+    {
+        ++deallocations;
+        std::pmr::new_delete_resource()->deallocate(pointer, bytes, alignment);
+    }
+
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override
+    {
+        return this == &other;
+    }
+};
+
+bool isAligned(const void* pointer, std::size_t alignment)
+{
+    return reinterpret_cast<std::uintptr_t>(pointer) % alignment == 0;
+}
+}
+
+TEST(MonotonicArenaTests, shouldServeTheCallerBufferFirst)
+{
+    CountingResource upstream;
+    alignas(std::max_align_t) std::byte buffer[256];
+    utils::MonotonicArena arena{buffer, sizeof(buffer), &upstream};
+
+    auto* first = static_cast<std::byte*>(arena.allocate(1, 1));
+    auto* second = arena.allocate(8, 8);
+    EXPECT_EQ(first, buffer);
+    EXPECT_TRUE(isAligned(second, 8));
+    EXPECT_EQ(upstream.allocations, 0u);
+
+    EXPECT_TRUE(isAligned(arena.allocate(300, 64), 64));
+    EXPECT_EQ(upstream.allocations, 1u);
+    EXPECT_EQ(arena.upstream_allocations(), 1u);
+
+    arena.release();
+    EXPECT_EQ(upstream.deallocations, 1u);
+    EXPECT_EQ(arena.allocate(1, 1), static_cast<void*>(buffer));
+}
+
+TEST(MonotonicArenaTests, shouldGrowChunksGeometrically)
+{
+    CountingResource upstream;
+    utils::MonotonicArena arena{256, &upstream};
+    for(int i = 0; i < 1000; ++i)
+    {
+        EXPECT_NE(arena.allocate(64, 16), nullptr);
+    }
+    // 64000 bytes from chunks of 256, 512, 1024, ... bytes.
+    EXPECT_LE(upstream.allocations, 9u);
+}
+
+TEST(MonotonicArenaTests, shouldKeepTheLargestChunkOnReset)
+{
+    CountingResource upstream;
+    utils::MonotonicArena arena{256, &upstream};
+    for(int request = 0; request < 10; ++request)
+    {
+        for(int i = 0; i < 100; ++i)
+        {
+            EXPECT_NE(arena.allocate(32, 8), nullptr);
+        }
+        arena.reset();
+    }
+    EXPECT_EQ(upstream.allocations - upstream.deallocations, 1u);
+    EXPECT_LE(upstream.allocations, 6u);
+}
@@ -0,0 +1,87 @@
+#include <gtest/gtest.h>
+#include "utils/ParallelRangeFormatter.hpp"
+
+#include <iomanip>
+#include <numeric>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace ::testing;
+
+namespace
+{
+std::vector<double> makeDoubles(std::size_t size)
+{
+    std::vector<double> vec(size);
+    for(std::size_t i = 0; i < size; ++i)
+    {
+        vec[i] = static_cast<double>(i) / 3.0 - 1000.0;
+    }
+    return vec;
+}
+}
+
+TEST(ParallelRangeFormatterTests, shouldFormatSmallRangesSequentially)
+{
+    std::vector<int> empty_vec{};
+    EXPECT_EQ(utils::formatRangeParallel(empty_vec, 4), "[]");
+
+    std::vector<std::string> vec_str{"Simple", "Test", "Case"};
+    EXPECT_EQ(utils::formatRangeParallel(vec_str, 4), "[Simple, Test, Case]");
+}
+
+TEST(ParallelRangeFormatterTests, shouldKeepDelimitersAtChunkBoundaries)
+{
+    const auto vec_double = makeDoubles(100003);
+
+    for(std::size_t threads : {1u, 2u, 3u, 4u, 7u})
+    {
+        EXPECT_EQ(utils::formatRangeParallel(vec_double, threads), utils::formatRange(vec_double));
+        EXPECT_EQ(utils::formatRangeParallel(vec_double, threads, ";"), utils::formatRange(vec_double, ";"));
+    }
+}
+
+TEST(ParallelRangeFormatterTests, shouldStreamChunksInOrder)
+{
+    std::vector<int> vec_int(70000);
+    std::iota(vec_int.begin(), vec_int.end(), 0);
+
+    std::stringstream parallel, sequential;
+    parallel << utils::printRangeParallel(vec_int, 4);
+    sequential << utils::printRange(vec_int);
+
+    EXPECT_EQ(parallel.str(), sequential.str());
+}
+
+TEST(ParallelRangeFormatterTests, shouldHonourStreamFormatting)
+{
+    std::vector<int> vec_int(70000);
+    std::iota(vec_int.begin(), vec_int.end(), 0);
+    const auto vec_double = makeDoubles(70000);
+
+    std::stringstream parallel, sequential;
+    parallel << std::hex << utils::printRangeParallel(vec_int, 4) << std::dec;
+    sequential << std::hex << utils::printRange(vec_int) << std::dec;
+    parallel << std::fixed << std::setprecision(2) << utils::printRangeParallel(vec_double, 4);
+    sequential << std::fixed << std::setprecision(2) << utils::printRange(vec_double);
+
+    EXPECT_EQ(parallel.str(), sequential.str());
+    EXPECT_NE(parallel.str().find("[0, 1, 2, 3, 4, 5, 6, 7, 8, 9, a, b"), std::string::npos);
+}
+
+TEST(ParallelRangeFormatterTests, shouldUseStyleLiteralsAndPendingWidth)
+{
+    std::vector<int> vec_int(70000);
+    std::iota(vec_int.begin(), vec_int.end(), 0);
+
+    std::stringstream parallel, sequential;
+    parallel << utils::printRangeParallel<utils::CompactStyle>(vec_int, 4);
+    sequential << utils::printRange<utils::CompactStyle>(vec_int);
+    parallel << std::setw(4) << utils::printRangeParallel(std::vector<int>{1, 2}, 4) << 7;
+    sequential << std::setw(4) << utils::printRange(std::vector<int>{1, 2}) << 7;
+
+    EXPECT_EQ(parallel.str(), sequential.str());
+    EXPECT_NE(parallel.str().find("[0,1,2,"), std::string::npos);
+    EXPECT_NE(parallel.str().find("   [1, 2]7"), std::string::npos);
+}
@@ -0,0 +1,49 @@
+#include <gtest/gtest.h>
+#include "utils/MonotonicArena.hpp"
+#include "utils/PoolResource.hpp"
+#include "utils/Vector.hpp"
+
+#include <cstddef>
+#include <memory_resource>
+
+using namespace ::testing;
+
+TEST(PoolResourceTests, shouldReuseDeallocatedBlocks)
+{
+    utils::PoolResource pool;
+    auto* first = pool.allocate(24, 8);
+    pool.deallocate(first, 24, 8);
+    EXPECT_EQ(pool.allocate(32, 8), first);
+
+    // Blocks of other sizes come from other pools.
+    EXPECT_NE(pool.allocate(16, 8), first);
+}
+
+TEST(PoolResourceTests, shouldForwardLargeAndOverAlignedRequests)
+{
+    utils::MonotonicArena arena;
+    utils::PoolResource pool{&arena};
+    EXPECT_NE(arena.allocate(1, 1), nullptr);
+    const auto before = arena.upstream_allocations();
+
+    EXPECT_NE(pool.allocate(1 << 13, 8), nullptr);
+    EXPECT_NE(pool.allocate(64, 64), nullptr);
+    EXPECT_GT(arena.upstream_allocations(), before);
+    EXPECT_EQ(pool.upstream_resource(), &arena);
+}
+
+TEST(PoolResourceTests, shouldRecycleBuffersOfGrowingVectors)
+{
+    utils::MonotonicArena arena;
+    utils::PoolResource pool{&arena};
+    for(int round = 0; round < 100; ++round)
+    {
+        utils::pmr::vector<int> v{&pool};
+        for(int i = 0; i < 512; ++i)
+        {
+            v.push_back(i);
+        }
+        EXPECT_EQ(v[511], 511);
+    }
+    EXPECT_LE(arena.upstream_allocations(), 10u);
+}
@@ -0,0 +1,165 @@
+#include <gtest/gtest.h>
+#include "utils/RangeFormatter.hpp"
+
+#include <array>
+#include <map>
+#include <set>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+using namespace ::testing;
+
+template <typename Range>
+std::string toString(const Range& range, const char* delimiter = ", ")
+{
+    std::array<char, 256> buffer{};
+    auto [ptr, ec] = utils::formatRangeTo(buffer.data(), buffer.data() + buffer.size(), range, delimiter);
+    EXPECT_EQ(ec, std::errc{});
+    return std::string(buffer.data(), ptr);
+}
+
+template <typename Range>
+std::string toStreamString(const Range& range)
+{
+    std::stringstream os;
+    os << utils::printRange(range);
+    return os.str();
+}
+
+TEST(RangeFormatterTests, shouldFormatVector)
+{
+    std::vector<int> empty_vec{};
+    EXPECT_EQ(toString(empty_vec), "[]");
+
+    std::vector<int> vec_int{1, 2};
+    EXPECT_EQ(toString(vec_int), "[1, 2]");
+
+    std::vector<char> vec_char{'a', 'b', 'c'};
+    EXPECT_EQ(toString(vec_char), "[a, b, c]");
+
+    std::vector<std::string> vec_str{"Simple", "Test", "Case"};
+    EXPECT_EQ(toString(vec_str), "[Simple, Test, Case]");
+}
+
+TEST(RangeFormatterTests, shouldFormatInnerContainer)
+{
+    std::vector<std::set<int>> vec_with_set {{1, 2, 3}, {4, 5, 6}};
+    EXPECT_EQ(toString(vec_with_set), "[[1, 2, 3], [4, 5, 6]]");
+
+    std::vector<std::vector<std::string>> vec_with_str_vec {{"Test", "Suite"}};
+    EXPECT_EQ(toString(vec_with_str_vec), "[[Test, Suite]]");
+
+    std::map<int, std::vector<std::string>> map_with_vec{{1, {"Test", "Suite"}}};
+    EXPECT_EQ(toString(map_with_vec), "[{1, [Test, Suite]}]");
+}
+
+TEST(RangeFormatterTests, shouldFormatMap)
+{
+    std::map<int, int> map_int{{1, 3}, {2, 4}};
+    EXPECT_EQ(toString(map_int), "[{1, 3}, {2, 4}]");
+
+    std::map<int, std::string> map_string{{1, "Test"}, {2, "Suite"}};
+    EXPECT_EQ(toString(map_string), "[{1, Test}, {2, Suite}]");
+}
+
+namespace
+{
+struct Person
+{
+    std::string full_name{};
+    unsigned age{};
+    double height{};
+};
+}
+
+TEST(RangeFormatterTests, shouldFormatAggregatesFieldByField)
+{
+    std::vector<Person> persons{{"Mariusz Kowalski", 25, 1.8}, {"Jan Kowalski", 40, 1.75}};
+    EXPECT_EQ(toString(persons), "[{Mariusz Kowalski, 25, 1.8}, {Jan Kowalski, 40, 1.75}]");
+    EXPECT_EQ(toString(persons), toStreamString(persons));
+    EXPECT_EQ(utils::formattedSize(persons), toStreamString(persons).size());
+}
+
+TEST(RangeFormatterTests, shouldFormatStringLikesAsText)
+{
+    std::vector<std::string_view> vec_str_view{"Simple", "Test"};
+    EXPECT_EQ(toString(vec_str_view), "[Simple, Test]");
+    EXPECT_EQ(toString(vec_str_view), toStreamString(vec_str_view));
+
+    std::map<std::string_view, const char*> map_c_str{{"Test", "Case"}};
+    EXPECT_EQ(toString(map_c_str), "[{Test, Case}]");
+    EXPECT_EQ(toString(map_c_str), toStreamString(map_c_str));
+}
+
+TEST(RangeFormatterTests, shouldMatchStreamOutputForArithmeticTypes)
+{
+    std::vector<double> vec_double{0.0, -1.5, 3.14159265, 1e-7, 123456789.0, 1e300};
+    EXPECT_EQ(toString(vec_double), toStreamString(vec_double));
+
+    std::vector<bool> vec_bool{true, false};
+    EXPECT_EQ(toString(vec_bool), toStreamString(vec_bool));
+
+    std::vector<long long> vec_long{-9223372036854775807LL, 0, 42};
+    EXPECT_EQ(toString(vec_long), toStreamString(vec_long));
+
+    std::vector<const char*> vec_c_str{"Simple", "Test"};
+    EXPECT_EQ(toString(vec_c_str), toStreamString(vec_c_str));
+}
+
+TEST(RangeFormatterTests, shouldUseCustomDelimiter)
+{
+    int arr[]{1, 2, 3};
+    EXPECT_EQ(toString(arr, "; "), "[1; 2; 3]");
+}
+
+TEST(RangeFormatterTests, shouldReportOverflow)
+{
+    std::vector<int> vec_int{100, 200, 300};
+    std::array<char, 8> buffer{};
+
+    auto [ptr, ec] = utils::formatRangeTo(buffer.data(), buffer.data() + buffer.size(), vec_int);
+    EXPECT_EQ(ec, std::errc::value_too_large);
+    EXPECT_EQ(ptr, buffer.data() + buffer.size());
+}
+
+TEST(RangeFormatterTests, shouldAppendToInlineBuffer)
+{
+    utils::InlineBuffer<16> buffer;
+    std::vector<int> vec_int{1, 2};
+
+    EXPECT_TRUE(utils::formatRangeTo(buffer, vec_int));
+    EXPECT_TRUE(utils::formatRangeTo(buffer, vec_int, ","));
+    EXPECT_EQ(buffer.view(), "[1, 2][1,2]");
+
+    EXPECT_FALSE(utils::formatRangeTo(buffer, vec_int));
+    EXPECT_EQ(buffer.view(), "[1, 2][1,2]");
+}
+
+TEST(RangeFormatterTests, shouldComputeFormattedSize)
+{
+    std::vector<int> empty_vec{};
+    EXPECT_EQ(utils::formattedSize(empty_vec), 2u);
+
+    std::vector<long long> vec_long{0, 9, 10, -10, 99999, -100000, -9223372036854775807LL - 1};
+    EXPECT_EQ(utils::formattedSize(vec_long), toStreamString(vec_long).size());
+
+    std::vector<unsigned long long> vec_unsigned{18446744073709551615ULL, 1000};
+    EXPECT_EQ(utils::formattedSize(vec_unsigned, ","), 27u);
+
+    std::vector<double> vec_double{0.5, -1e-7, 123456789.0};
+    EXPECT_EQ(utils::formattedSize(vec_double), toStreamString(vec_double).size());
+
+    std::map<int, std::vector<std::string>> map_with_vec{{1, {"Test", "Suite"}}, {20, {}}};
+    EXPECT_EQ(utils::formattedSize(map_with_vec), toStreamString(map_with_vec).size());
+}
+
+TEST(RangeFormatterTests, shouldFormatRangeToString)
+{
+    std::map<int, std::vector<std::string>> map_with_vec{{1, {"Test", "Suite"}}, {2, {"Case"}}};
+    EXPECT_EQ(utils::formatRange(map_with_vec), "[{1, [Test, Suite]}, {2, [Case]}]");
+
+    std::vector<int> vec_int{1, 2, 3};
+    EXPECT_EQ(utils::formatRange(vec_int, " "), "[1 2 3]");
+}
@@ -0,0 +1,117 @@
+#include <gtest/gtest.h>
+#include "utils/MappedFile.hpp"
+#include "utils/RangeFormatter.hpp"
+#include "utils/RangeParser.hpp"
+
+#include <cstdio>
+#include <fstream>
+#include <map>
+#include <set>
+#include <string>
+#include <string_view>
+#include <vector>
+
+using namespace ::testing;
+
+template <typename Range>
+void expectRoundTrip(const Range& range)
+{
+    const auto text = utils::formatRange(range);
+    EXPECT_EQ(utils::parseRange<Range>(text), range) << text;
+}
+
+TEST(RangeParserTests, shouldParseVector)
+{
+    expectRoundTrip(std::vector<int>{});
+    expectRoundTrip(std::vector<int>{1, 2});
+    expectRoundTrip(std::vector<char>{'a', 'b', 'c'});
+    expectRoundTrip(std::vector<std::string>{"Simple", "Test", "Case"});
+    expectRoundTrip(std::vector<long long>{-9223372036854775807LL - 1, 0, 9223372036854775807LL});
+    expectRoundTrip(std::vector<bool>{true, false});
+}
+
+TEST(RangeParserTests, shouldParseInnerContainer)
+{
+    expectRoundTrip(std::vector<std::set<int>>{{1, 2, 3}, {4, 5, 6}});
+    expectRoundTrip(std::vector<std::vector<std::string>>{{"Test", "Suite"}});
+    expectRoundTrip(std::map<int, std::vector<std::string>>{{1, {"Test", "Suite"}}, {2, {}}});
+}
+
+TEST(RangeParserTests, shouldParseMap)
+{
+    expectRoundTrip(std::map<int, int>{{1, 3}, {2, 4}});
+    expectRoundTrip(std::map<int, std::string>{{1, "Test"}, {2, "Suite"}});
+    expectRoundTrip(std::map<std::string, int>{{"Test,Case", 1}, {"[Suite]", 2}});
+}
+
+TEST(RangeParserTests, shouldParseFloatingPoint)
+{
+    EXPECT_EQ(utils::parseRange<std::vector<double>>("[1.5, -2.25, 1e-07]"), (std::vector<double>{1.5, -2.25, 1e-7}));
+}
+
+TEST(RangeParserTests, shouldParseStringsContainingStructuralCharacters)
+{
+    EXPECT_EQ(utils::parseRange<std::vector<std::string>>("[a,b, {c}, x[y, long text with commas, and more]"),
+              (std::vector<std::string>{"a,b", "{c}", "x[y", "long text with commas", "and more"}));
+}
+
+TEST(RangeParserTests, shouldUseCustomDelimiter)
+{
+    EXPECT_EQ(utils::parseRange<std::vector<int>>("[1;2;3]", ";"), (std::vector<int>{1, 2, 3}));
+    EXPECT_EQ(utils::parseRange<std::vector<std::string>>("[a b; c]", "; "), (std::vector<std::string>{"a b", "c"}));
+}
+
+TEST(RangeParserTests, shouldPointIntoInputForStringViews)
+{
+    const std::string text{"[{1, [Test, Suite]}]"};
+    auto parsed = utils::parseRange<std::map<int, std::vector<std::string_view>>>(text);
+
+    ASSERT_TRUE(parsed.has_value());
+    const auto& words = parsed->at(1);
+    ASSERT_EQ(words.size(), 2u);
+    EXPECT_EQ(words[0], "Test");
+    EXPECT_EQ(words[0].data(), text.data() + 6);
+    EXPECT_EQ(words[1].data(), text.data() + 12);
+}
+
+TEST(RangeParserTests, shouldReportErrorPosition)
+{
+    const std::string_view text{"[1, 2, x]"};
+    std::vector<int> vec_int;
+
+    auto [ptr, ec] = utils::parseRangeFrom(text.data(), text.data() + text.size(), vec_int);
+    EXPECT_EQ(ec, std::errc::invalid_argument);
+    EXPECT_EQ(ptr, text.data() + 7);
+    EXPECT_EQ(vec_int, (std::vector<int>{1, 2}));
+
+    EXPECT_FALSE(utils::parseRange<std::vector<int>>("[1, 2"));
+    EXPECT_FALSE(utils::parseRange<std::vector<int>>("[1, 2] trailing"));
+    EXPECT_FALSE((utils::parseRange<std::map<int, int>>("[{1 2}]")));
+}
+
+TEST(RangeParserTests, shouldRejectEmptyDelimiter)
+{
+    const std::string_view text{"[a, b]"};
+    std::vector<std::string> vec_string;
+
+    auto [ptr, ec] = utils::parseRangeFrom(text.data(), text.data() + text.size(), vec_string, "");
+    EXPECT_EQ(ec, std::errc::invalid_argument);
+    EXPECT_EQ(ptr, text.data());
+    EXPECT_TRUE(vec_string.empty());
+    EXPECT_FALSE(utils::parseRange<std::vector<int>>("[1]", ""));
+}
+
+TEST(RangeParserTests, shouldParseMappedFile)
+{
+    const std::string path{::testing::TempDir() + "RangeParserTests.txt"};
+    const std::map<int, std::vector<std::string>> map_with_vec{{1, {"Test", "Suite"}}, {2, {"Case"}}};
+    std::ofstream{path} << utils::formatRange(map_with_vec);
+
+    {
+        const utils::MappedFile file{path};
+        EXPECT_EQ((utils::parseRange<std::map<int, std::vector<std::string>>>(file.view())), map_with_vec);
+    }
+    std::remove(path.c_str());
+
+    EXPECT_THROW(utils::MappedFile{path}, std::system_error);
+}
@@ -1,6 +1,17 @@
 #include <gtest/gtest.h>
+#include "utils/Generator.hpp"
 #include "utils/RangePrinter.hpp"
 
+#include <array>
+#include <forward_list>
+#include <iomanip>
+#include <iterator>
+#include <limits>
+#include <list>
+#include <numeric>
+#include <optional>
+#include <sstream>
+
 using namespace ::testing;
 
 template <typename Range>
@@ -46,3 +57,226 @@ TEST(RangePrinterTests, shouldPrintMap)
     std::map<int, std::string> map_string{{1, "Test"}, {2, "Suite"}};
     EXPECT_EQ(toString(map_string), "[{1, Test}, {2, Suite}]");
 }
+
+namespace
+{
+struct Person
+{
+    std::string full_name{};
+    unsigned age{};
+};
+
+struct Team
+{
+    std::string name{};
+    std::vector<Person> members{};
+};
+
+struct Printable
+{
+    int id{};
+};
+
+std::ostream& operator<<(std::ostream& os, const Printable& printable)
+{
+    return os << "Printable#" << printable.id;
+}
+}
+
+TEST(RangePrinterTests, shouldPrintAggregatesFieldByField)
+{
+    std::vector<Person> persons{{"Mariusz Kowalski", 25}, {"Jan Kowalski", 40}};
+    EXPECT_EQ(toString(persons), "[{Mariusz Kowalski, 25}, {Jan Kowalski, 40}]");
+
+    std::map<int, Team> map_team{{1, {"Test", {{"Jan Kowalski", 40}}}}};
+    EXPECT_EQ(toString(map_team), "[{1, {Test, [{Jan Kowalski, 40}]}}]");
+
+    std::vector<Printable> vec_printable{{1}, {2}};
+    EXPECT_EQ(toString(vec_printable), "[Printable#1, Printable#2]");
+
+    std::stringstream padded;
+    padded << std::setw(3) << utils::makeValuePrinter(Person{"Jan Kowalski", 40});
+    EXPECT_EQ(padded.str(), "  {Jan Kowalski, 40}");
+}
+
+TEST(RangePrinterTests, shouldPrintStringLikesAsText)
+{
+    std::vector<std::string_view> vec_str_view{"Simple", "Test"};
+    EXPECT_EQ(toString(vec_str_view), "[Simple, Test]");
+
+    std::vector<const char*> vec_c_str{"Test", "Case"};
+    EXPECT_EQ(toString(vec_c_str), "[Test, Case]");
+
+    std::map<std::string_view, int> map_str_view{{"Suite", 1}};
+    EXPECT_EQ(toString(map_str_view), "[{Suite, 1}]");
+
+    std::stringstream padded;
+    padded << std::setw(6) << utils::makeValuePrinter(std::string{"x"}) << "|"
+           << std::setw(5) << utils::makeValuePrinter<utils::JsonStyle>(std::string_view{"y"}) << "|";
+    EXPECT_EQ(padded.str(), "     x|  \"y\"|");
+
+    std::stringstream null_c_str;
+    null_c_str << utils::makeValuePrinter(static_cast<const char*>(nullptr));
+    EXPECT_TRUE(null_c_str.bad());
+}
+
+struct ParenthesesStyle : utils::DefaultStyle
+{
+    static constexpr std::string_view open{"("};
+    static constexpr std::string_view close{")"};
+    static constexpr std::string_view delimiter{" | "};
+    static constexpr std::string_view pairOpen{"<"};
+    static constexpr std::string_view pairDelimiter{": "};
+    static constexpr std::string_view pairClose{">"};
+};
+
+template <typename Style, typename Range>
+std::string toStyledString(const Range& range)
+{
+    std::stringstream os;
+    os << utils::printRange<Style>(range);
+    return os.str();
+}
+
+TEST(RangePrinterTests, shouldPrintWithCompileTimeStyle)
+{
+    std::map<int, int> map_int{{1, 3}, {2, 4}};
+    EXPECT_EQ(toStyledString<utils::DefaultStyle>(map_int), toString(map_int));
+    EXPECT_EQ(toStyledString<utils::CompactStyle>(map_int), "[{1,3},{2,4}]");
+
+    std::vector<int> vec_int{1, 2, 3};
+    EXPECT_EQ(toStyledString<utils::CompactStyle>(vec_int), "[1,2,3]");
+    EXPECT_EQ(toStyledString<ParenthesesStyle>(vec_int), "(1 | 2 | 3)");
+}
+
+TEST(RangePrinterTests, shouldApplyStyleToInnerContainers)
+{
+    std::map<int, std::vector<std::string>> map_with_vec{{1, {"Test", "Suite"}}, {2, {}}};
+    EXPECT_EQ(toStyledString<ParenthesesStyle>(map_with_vec), "(<1: (Test | Suite)> | <2: ()>)");
+
+    std::vector<std::set<char>> vec_with_set{{'a', 'b'}, {'c'}};
+    EXPECT_EQ(toStyledString<utils::CompactStyle>(vec_with_set), "[[a,b],[c]]");
+}
+
+namespace
+{
+// Characters up to the terminating zero, the end is only known when it is reached.
+struct NullTerminated
+{
+    struct Sentinel
+    {};
+
+    const char* begin() const { return text; }
+    Sentinel end() const { return {}; }
+
+    friend bool operator==(const char* it, Sentinel) { return *it == '\0'; }
+    friend bool operator!=(const char* it, Sentinel) { return *it != '\0'; }
+
+    const char* text;
+};
+}
+
+TEST(RangePrinterTests, shouldPrintSinglePassAndSentinelRanges)
+{
+    std::istringstream numbers{"1 2 3"};
+    std::stringstream os;
+    os << utils::printRange(std::istream_iterator<int>{numbers}, std::istream_iterator<int>{});
+    EXPECT_EQ(os.str(), "[1, 2, 3]");
+
+    EXPECT_EQ(toString(NullTerminated{"abc"}), "[a, b, c]");
+    std::stringstream compact;
+    compact << utils::printRange<utils::CompactStyle>(NullTerminated{"xy"}.begin(), NullTerminated::Sentinel{});
+    EXPECT_EQ(compact.str(), "[x,y]");
+
+    std::istringstream words{"Test Case"};
+    std::stringstream braced;
+    braced << utils::printRange(std::istream_iterator<std::string>{words}, {}) << ' '
+           << utils::printRange<utils::CompactStyle>(std::istream_iterator<int>{numbers}, {});
+    EXPECT_EQ(braced.str(), "[Test, Case] []");
+}
+
+TEST(RangePrinterTests, shouldPadOpeningBracketWithPendingWidth)
+{
+    const std::vector<int> vec_int{1, 2};
+    const std::list<int> list_int{1, 2};
+    std::istringstream numbers{"1 2"};
+
+    std::stringstream os;
+    os << std::setw(8) << utils::printRange(vec_int) << 7 << '\n';
+    os << std::setw(8) << utils::printRange(list_int) << 7 << '\n';
+    os << std::setw(8) << utils::printRange(std::istream_iterator<int>{numbers}, std::istream_iterator<int>{}) << 7 << '\n';
+    os << std::setw(4) << utils::makeValuePrinter(std::pair{1, 2}) << 7;
+    EXPECT_EQ(os.str(), "       [1, 2]7\n       [1, 2]7\n       [1, 2]7\n   {1, 2}7");
+}
+
+template <typename Range>
+std::string toString(const Range& range, const utils::PrintLimits& limits)
+{
+    std::stringstream os;
+    os << utils::printRange(range, limits);
+    return os.str();
+}
+
+TEST(RangePrinterTests, shouldPrintHeadAndTailOfLargeRanges)
+{
+    std::vector<int> numbers(100);
+    std::iota(numbers.begin(), numbers.end(), 1);
+    EXPECT_EQ(toString(numbers, {3, 2}), "[1, 2, 3, ... (95 more), 99, 100]");
+    EXPECT_EQ(toString(numbers, {0, 2}), "[... (98 more), 99, 100]");
+    EXPECT_EQ(toString(std::vector<int>{1, 2, 3, 4, 5}, {3, 2}), "[1, 2, 3, 4, 5]");
+    EXPECT_EQ(toString(std::vector<int>{1, 2, 3, 4, 5, 6}, {3, 2}), "[1, 2, 3, ... (1 more), 5, 6]");
+
+    std::stringstream padded;
+    padded << std::setw(4) << utils::printRange(std::vector<int>{1, 2, 3}, {1, 1}) << 7;
+    EXPECT_EQ(padded.str(), "   [1, ... (1 more), 3]7");
+
+    EXPECT_EQ(toString(std::set<int>{1, 2, 3, 4, 5, 6}, {1, 1}), "[1, ... (4 more), 6]");
+    EXPECT_EQ(toString(std::forward_list<int>{1, 2, 3, 4}, {2, 1}), "[1, 2, ...]");
+    EXPECT_EQ(toString(std::forward_list<int>{1, 2}, {2, 1}), "[1, 2]");
+}
+
+TEST(RangePrinterTests, shouldApplyLimitsToInnerContainers)
+{
+    std::map<int, std::vector<std::string>> map{{1, {"a", "b", "c"}}, {2, {"d"}}, {3, {}}};
+    EXPECT_EQ(toString(map, {2, 0, 1}), "[{1, [...]}, {2, [...]}, ... (1 more)]");
+    EXPECT_EQ(toString(map, {1}), "[{1, [a, ... (2 more)]}, ... (2 more)]");
+
+    std::stringstream compact;
+    compact << utils::printRange<utils::CompactStyle>(map, {1, 1});
+    EXPECT_EQ(compact.str(), "[{1,[a,... (1 more),c]},... (1 more),{3,[]}]");
+}
+
+TEST(RangePrinterTests, shouldCutOutputAtMaxBytes)
+{
+    std::vector<int> numbers(1000);
+    std::iota(numbers.begin(), numbers.end(), 1);
+    utils::PrintLimits limits;
+    limits.maxBytes = 10;
+
+    std::stringstream os;
+    os << utils::printRange(numbers, limits) << " and on";
+    EXPECT_EQ(os.str(), "[1, 2, 3, ... and on");
+
+    // Never ending sources stop once the limit is reached.
+    utils::generator<int> naturals{[next = 0]() mutable { return std::optional<int>{next++}; }};
+    EXPECT_EQ(toString(naturals, limits), "[0, 1, 2, ...");
+    EXPECT_EQ(toString(naturals, {2}), "[4, 5, ...]");
+}
+
+TEST(RangePrinterTests, shouldPrintJson)
+{
+    std::map<std::string, std::vector<int>> map{{"a, [b]", {1, 2}}, {"say \"hi\"\n", {}}};
+    std::stringstream os;
+    os << utils::printRange<utils::JsonStyle>(map);
+    EXPECT_EQ(os.str(), R"([["a, [b]",[1,2]],["say \"hi\"\n",[]]])");
+
+    std::stringstream scalars;
+    scalars << utils::printRange<utils::JsonStyle>(std::vector<char>{'x', '"'}) << ' '
+            << utils::printRange<utils::JsonStyle>(std::array<bool, 2>{true, false}) << ' '
+            << utils::printRange<utils::JsonStyle>(std::vector<double>{0.5, std::numeric_limits<double>::infinity()});
+    EXPECT_EQ(scalars.str(), R"(["x","\""] [true,false] [0.5,null])");
+
+    std::stringstream aggregates;
+    aggregates << utils::printRange<utils::JsonStyle>(std::vector<Person>{{"Jan \\ Kowalski", 40}});
+    EXPECT_EQ(aggregates.str(), R"([["Jan \\ Kowalski",40]])");
+}
@@ -0,0 +1,167 @@
+#include <gtest/gtest.h>
+#include "utils/Reductions.hpp"
+
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <list>
+#include <numeric>
+#include <type_traits>
+#include <vector>
+
+using namespace ::testing;
+
+namespace
+{
+constexpr std::array<utils::ReduceKernel, 2> kernels{utils::ReduceKernel::Scalar, utils::ReduceKernel::Avx2};
+
+// Every kernel, and every size around the vector widths, has to agree with a 64-bit accumulate.
+template<typename T>
+void expectIntegerSums(const std::vector<T>& values)
+{
+    for(auto kernel : kernels)
+    {
+        if(not utils::isReduceKernelSupported(kernel))
+        {
+            continue;
+        }
+        for(std::size_t size : {std::size_t{0}, std::size_t{1}, std::size_t{15}, std::size_t{16}, std::size_t{17}, values.size()})
+        {
+            const std::vector<T> prefix(values.begin(), values.begin() + static_cast<std::ptrdiff_t>(std::min(size, values.size())));
+            const auto expected = std::accumulate(prefix.begin(), prefix.end(), utils::sum_t<T>{});
+            EXPECT_EQ(utils::sum(kernel, prefix), expected) << "kernel " << static_cast<int>(kernel) << " size " << size;
+        }
+    }
+}
+
+template<typename T>
+std::vector<T> makeIntegers(std::size_t size)
+{
+    std::vector<T> values(size);
+    for(std::size_t i = 0; i < size; ++i)
+    {
+        values[i] = static_cast<T>(i * 2654435761u);
+    }
+    return values;
+}
+}
+
+TEST(ReductionsTests, shouldSumIntegersInSixtyFourBits)
+{
+    static_assert(std::is_same_v<decltype(utils::sum(std::vector<int>{})), std::int64_t>);
+    static_assert(std::is_same_v<decltype(utils::sum(std::vector<unsigned char>{})), std::uint64_t>);
+
+    expectIntegerSums(makeIntegers<std::int8_t>(1000));
+    expectIntegerSums(makeIntegers<std::uint16_t>(1000));
+    expectIntegerSums(makeIntegers<std::int32_t>(1000));
+    expectIntegerSums(makeIntegers<std::uint32_t>(1000));
+    expectIntegerSums(makeIntegers<std::int64_t>(1000));
+
+    const std::vector<int> large(100, 2'000'000'000);
+    EXPECT_EQ(utils::sum(large), 200'000'000'000);
+}
+
+TEST(ReductionsTests, shouldSumAnyIterableRange)
+{
+    const std::list<int> list{1, 2, 3, 4};
+    EXPECT_EQ(utils::sum(list), 10);
+    EXPECT_DOUBLE_EQ(utils::mean(list), 2.5);
+    EXPECT_DOUBLE_EQ(utils::variance(list), 1.25);
+
+    const std::array<double, 3> array{0.5, 1.5, 2.0};
+    EXPECT_DOUBLE_EQ(utils::sum(array), 4.0);
+
+    using namespace std::chrono_literals;
+    const std::vector<std::chrono::milliseconds> durations{10ms, 20ms, 30ms};
+    EXPECT_EQ(utils::sum(durations), 60ms);
+}
+
+TEST(ReductionsTests, shouldCompensateFloatingPointRounding)
+{
+    for(auto kernel : kernels)
+    {
+        if(not utils::isReduceKernelSupported(kernel))
+        {
+            continue;
+        }
+        // Plain + gives 0, Kahan summation gives 0 as well.
+        const std::vector<double> cancelling{1.0, 1e100, 1.0, -1e100};
+        EXPECT_EQ(utils::sum(kernel, cancelling), 2.0) << "kernel " << static_cast<int>(kernel);
+
+        const std::vector<double> tenths(1'000'003, 0.1);
+        EXPECT_EQ(utils::sum(kernel, tenths), 100000.3) << "kernel " << static_cast<int>(kernel);
+        EXPECT_NE(std::accumulate(tenths.begin(), tenths.end(), 0.0), 100000.3);
+
+        // Floats are added up in double.
+        const std::vector<float> floats(1 << 20, 0.1f);
+        EXPECT_EQ(utils::sum(kernel, floats), static_cast<double>(0.1f) * (1 << 20)) << "kernel " << static_cast<int>(kernel);
+    }
+}
+
+TEST(ReductionsTests, shouldComputeVarianceWithoutCancellation)
+{
+    for(auto kernel : kernels)
+    {
+        if(not utils::isReduceKernelSupported(kernel))
+        {
+            continue;
+        }
+        std::vector<double> shifted;
+        for(int i = 0; i < 25; ++i)
+        {
+            for(double value : {4.0, 7.0, 13.0, 16.0})
+            {
+                shifted.push_back(1e9 + value);
+            }
+        }
+        EXPECT_DOUBLE_EQ(utils::mean(kernel, shifted), 1e9 + 10.0) << "kernel " << static_cast<int>(kernel);
+        EXPECT_DOUBLE_EQ(utils::variance(kernel, shifted), 22.5) << "kernel " << static_cast<int>(kernel);
+
+        const std::vector<int> integers(shifted.begin(), shifted.end());
+        EXPECT_DOUBLE_EQ(utils::variance(kernel, integers), 22.5) << "kernel " << static_cast<int>(kernel);
+    }
+    EXPECT_TRUE(std::isnan(utils::mean(std::vector<double>{})));
+    EXPECT_TRUE(std::isnan(utils::variance(std::vector<int>{})));
+}
+
+TEST(ReductionsTests, shouldAverageIntegersNearTheirLimitsWithoutWrapping)
+{
+    constexpr auto int64Max = std::numeric_limits<std::int64_t>::max();
+    constexpr auto int64Min = std::numeric_limits<std::int64_t>::min();
+    constexpr auto uint64Max = std::numeric_limits<std::uint64_t>::max();
+    for(auto kernel : kernels)
+    {
+        if(not utils::isReduceKernelSupported(kernel))
+        {
+            continue;
+        }
+        EXPECT_DOUBLE_EQ(utils::mean(kernel, std::vector<std::int64_t>{int64Max, int64Max}), static_cast<double>(int64Max));
+        EXPECT_DOUBLE_EQ(utils::mean(kernel, std::vector<std::int64_t>{int64Min, int64Min}), static_cast<double>(int64Min));
+        EXPECT_DOUBLE_EQ(utils::mean(kernel, std::vector<std::int64_t>(3, 4'000'000'000'000'000'000)), 4e18);
+        EXPECT_DOUBLE_EQ(utils::mean(kernel, std::vector<std::uint64_t>{uint64Max, uint64Max}), static_cast<double>(uint64Max));
+        EXPECT_DOUBLE_EQ(utils::variance(kernel, std::vector<std::int64_t>(100, int64Max)), 0.0);
+        EXPECT_DOUBLE_EQ(utils::variance(kernel, std::vector<std::uint64_t>{0, uint64Max}), std::pow(static_cast<double>(uint64Max) / 2, 2));
+
+        const std::vector<std::uint32_t> narrow(1000, std::numeric_limits<std::uint32_t>::max());
+        EXPECT_DOUBLE_EQ(utils::mean(kernel, narrow), static_cast<double>(std::numeric_limits<std::uint32_t>::max()));
+    }
+    // sum() keeps wrapping modulo 2^64.
+    EXPECT_EQ(utils::sum(std::vector<std::uint64_t>{uint64Max, 1}), 0u);
+    const std::vector<std::int64_t> large(1 << 18, int64Max);
+    EXPECT_DOUBLE_EQ(utils::meanParallel(large, 4), static_cast<double>(int64Max));
+}
+
+TEST(ReductionsTests, shouldReduceInParallel)
+{
+    const auto integers = makeIntegers<std::int32_t>(1 << 18);
+    const std::vector<double> doubles(integers.begin(), integers.end());
+    for(std::size_t threads : {std::size_t{0}, std::size_t{1}, std::size_t{3}, std::size_t{4}})
+    {
+        EXPECT_EQ(utils::sumParallel(integers, threads), utils::sum(integers));
+        EXPECT_DOUBLE_EQ(utils::sumParallel(doubles, threads), utils::sum(doubles));
+        EXPECT_DOUBLE_EQ(utils::meanParallel(doubles, threads), utils::mean(doubles));
+        EXPECT_DOUBLE_EQ(utils::varianceParallel(integers, threads), utils::variance(integers));
+    }
+}
@@ -0,0 +1,215 @@
+#include <gtest/gtest.h>
+#include "utils/RangePrinter.hpp"
+#include "utils/SmallVector.hpp"
+
+#include <list>
+#include <memory>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+
+using namespace ::testing;
+
+namespace
+{
+template<typename Range>
+std::string toString(const Range& range)
+{
+    std::stringstream os;
+    os << utils::printRange(range);
+    return os.str();
+}
+
+// Counts live objects, a relocation through memcpy would leave the count unbalanced.
+struct Tracked
+{
+    static inline int alive{};
+
+    explicit Tracked(int value)
+        : value{value}
+    {
+        ++alive;
+    }
+    Tracked(const Tracked& other)
+        : value{other.value}
+    {
+        ++alive;
+    }
+    Tracked(Tracked&& other) noexcept
+        : value{other.value}
+    {
+        ++alive;
+    }
+    ~Tracked()
+    {
+        --alive;
+    }
+
+    int value;
+};
+
+// Copying throws once copiesLeft runs out.
+struct Fragile
+{
+    static inline int alive{};
+    static inline int copiesLeft{};
+
+    Fragile() { ++alive; }
+    Fragile(const Fragile&)
+    {
+        if(copiesLeft-- == 0)
+        {
+            throw std::runtime_error{"copy"};
+        }
+        ++alive;
+    }
+    ~Fragile() { --alive; }
+};
+
+template<typename, typename, typename = void>
+constexpr bool deducesFrom{};
+
+template<typename First, typename Second>
+constexpr bool deducesFrom<First, Second,
+                           std::void_t<decltype(utils::small_vector(std::declval<First>(), std::declval<Second>()))>> = true;
+
+struct Handle
+{
+    std::unique_ptr<int> value;
+};
+}
+
+template<>
+constexpr bool traits::is_trivially_relocatable<Handle> = true;
+
+TEST(SmallVectorTests, shouldDeduceTypeAndInlineCapacity)
+{
+    utils::small_vector v{1, 2, 3};
+    static_assert(std::is_same_v<decltype(v), utils::small_vector<int, 3>>);
+    EXPECT_EQ(v.size(), 3u);
+    EXPECT_TRUE(v.is_inline());
+
+    utils::small_vector copy{v};
+    static_assert(std::is_same_v<decltype(copy), utils::small_vector<int, 3>>);
+    EXPECT_EQ(copy, v);
+
+    // utils::small_vector mixed{1.0, 2}; // does not deduce, like the exercise's array
+
+    // An iterator pair has no capacity to deduce, it must not give a vector of iterators.
+    using Iterator = std::list<int>::const_iterator;
+    static_assert(not deducesFrom<Iterator, Iterator>);
+    static_assert(not deducesFrom<const int*, const int*>);
+    static_assert(deducesFrom<int, int>);
+    const std::list<int> list{1, 2, 3};
+    const utils::small_vector<int, 2> fromIterators(list.begin(), list.end());
+    EXPECT_EQ(fromIterators, (utils::small_vector<int, 2>{1, 2, 3}));
+}
+
+TEST(SmallVectorTests, shouldSpillToTheHeapPastInlineCapacity)
+{
+    utils::small_vector<std::string, 2> v;
+    v.push_back("a");
+    v.emplace_back("b");
+    EXPECT_TRUE(v.is_inline());
+    EXPECT_EQ(v.capacity(), 2u);
+
+    v.emplace_back(3, 'c');
+    EXPECT_FALSE(v.is_inline());
+    EXPECT_EQ(toString(v), "[a, b, ccc]");
+
+    v.pop_back();
+    v.resize(4, "d");
+    EXPECT_EQ(toString(v), "[a, b, d, d]");
+    v.resize(1);
+    EXPECT_EQ(toString(v), "[a]");
+    EXPECT_THROW(v.at(1), std::out_of_range);
+}
+
+TEST(SmallVectorTests, shouldAllowPushingItsOwnElements)
+{
+    utils::small_vector<std::string, 2> v{"first", "second"};
+    v.push_back(v[0]);
+    v.push_back(v[0]);
+    EXPECT_EQ(toString(v), "[first, second, first, first]");
+
+    v.resize(v.capacity() + 1, v[1]);
+    EXPECT_EQ(v.back(), "second");
+    utils::small_vector<int, 2> numbers{7, 8, 9};
+    numbers.resize(8, numbers[0]);
+    EXPECT_EQ(toString(numbers), "[7, 8, 9, 7, 7, 7, 7, 7]");
+}
+
+TEST(SmallVectorTests, shouldMoveInlineAndSpilledStorage)
+{
+    utils::small_vector<std::string, 2> inlined{"a"};
+    auto movedInline = std::move(inlined);
+    EXPECT_EQ(toString(movedInline), "[a]");
+    EXPECT_TRUE(inlined.empty());
+
+    utils::small_vector<std::string, 2> spilled{"a", "b", "c"};
+    const auto* data = spilled.data();
+    auto movedSpilled = std::move(spilled);
+    EXPECT_EQ(movedSpilled.data(), data);
+    EXPECT_TRUE(spilled.is_inline());
+
+    movedInline = movedSpilled;
+    EXPECT_EQ(movedInline, movedSpilled);
+    movedSpilled = std::move(movedInline);
+    EXPECT_EQ(toString(movedSpilled), "[a, b, c]");
+}
+
+TEST(SmallVectorTests, shouldRelocateElementsWhenGrowing)
+{
+    {
+        utils::small_vector<Tracked, 1> tracked;
+        for(int i = 0; i < 100; ++i)
+        {
+            tracked.emplace_back(i);
+        }
+        EXPECT_EQ(Tracked::alive, 100);
+        EXPECT_EQ(tracked[99].value, 99);
+    }
+    EXPECT_EQ(Tracked::alive, 0);
+
+    utils::small_vector<Handle, 1> handles;
+    for(int i = 0; i < 100; ++i)
+    {
+        handles.push_back(Handle{std::make_unique<int>(i)});
+    }
+    EXPECT_EQ(*handles[0].value, 0);
+    EXPECT_EQ(*handles[99].value, 99);
+}
+
+TEST(SmallVectorTests, shouldReleaseElementsWhenConstructionThrows)
+{
+    const std::list<Fragile> source(4);
+    for(int copies : {1, 3})
+    {
+        Fragile::copiesLeft = copies;
+        EXPECT_THROW((utils::small_vector<Fragile, 2>(source.begin(), source.end())), std::runtime_error);
+        Fragile::copiesLeft = copies;
+        EXPECT_THROW((utils::small_vector<Fragile, 2>(4, source.front())), std::runtime_error);
+    }
+    EXPECT_EQ(Fragile::alive, 4);
+}
+
+TEST(SmallVectorTests, shouldKeepElementsWhenGrowthCopyThrows)
+{
+    {
+        utils::small_vector<Fragile, 2> fragiles;
+        fragiles.emplace_back();
+        fragiles.emplace_back();
+        Fragile::copiesLeft = 1;
+        EXPECT_THROW(fragiles.emplace_back(), std::runtime_error);
+        EXPECT_TRUE(fragiles.is_inline());
+        EXPECT_EQ(fragiles.size(), 2u);
+        Fragile::copiesLeft = 0;
+        EXPECT_THROW(fragiles.reserve(8), std::runtime_error);
+        EXPECT_TRUE(fragiles.is_inline());
+        EXPECT_EQ(fragiles.size(), 2u);
+        EXPECT_EQ(Fragile::alive, 2);
+    }
+    EXPECT_EQ(Fragile::alive, 0);
+}
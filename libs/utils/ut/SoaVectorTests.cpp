@@ -0,0 +1,232 @@
+#include <gtest/gtest.h>
+#include "utils/RangeFormatter.hpp"
+#include "utils/RangePrinter.hpp"
+#include "utils/Reductions.hpp"
+#include "utils/SoaVector.hpp"
+
+#include <algorithm>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+
+using namespace ::testing;
+
+namespace
+{
+struct Person
+{
+    std::string full_name{};
+    unsigned age{};
+};
+
+// The example's Employee derives from Person, which structured bindings can not
+// decompose, so the fields are spelled out here.
+struct Employee
+{
+    std::string full_name{};
+    unsigned age{};
+    unsigned salary{};
+};
+
+struct Badge
+{
+    Badge() = default;
+    Badge(int number)
+        : number{number}
+    {
+        if(number < 0)
+        {
+            throw std::invalid_argument{"badge"};
+        }
+    }
+
+    int number{};
+};
+
+struct Visitor
+{
+    std::string name{};
+    Badge badge{};
+};
+
+// Copy-only field whose copy throws once copiesLeft runs out.
+struct Stamp
+{
+    static inline int copiesLeft{-1};
+
+    Stamp(int number)
+        : number{number}
+    {}
+    Stamp(const Stamp& other)
+        : number{other.number}
+    {
+        if(copiesLeft-- == 0)
+        {
+            throw std::runtime_error{"copy"};
+        }
+    }
+
+    int number{};
+};
+
+// Default construction throws while soldOut is set.
+struct Seat
+{
+    static inline bool soldOut{};
+
+    Seat()
+    {
+        if(soldOut)
+        {
+            throw std::runtime_error{"sold out"};
+        }
+    }
+
+    int row{};
+};
+
+struct Booking
+{
+    std::string guest{};
+    Seat seat{};
+};
+
+struct Ticket
+{
+    std::string holder{};
+    Stamp stamp;
+};
+
+template<typename Range>
+std::string toString(const Range& range)
+{
+    std::stringstream os;
+    os << utils::printRange(range);
+    return os.str();
+}
+}
+
+TEST(SoaVectorTests, shouldSplitFieldsIntoColumns)
+{
+    utils::soa_vector<Employee> employees{{"Jan Kowalski", 40, 20000}, {"Anna Nowak", 28, 15000}};
+    employees.push_back({"Piotr Lis", 35, 18000});
+    employees.emplace_back("Ewa Kot", 51u, 25000u);
+
+    static_assert(std::is_same_v<decltype(employees.column<2>()), utils::ColumnSpan<unsigned>>);
+    EXPECT_EQ(employees.size(), 4u);
+    EXPECT_EQ(toString(employees.column<1>()), "[40, 28, 35, 51]");
+    EXPECT_EQ(utils::sum(employees.column<2>()), 78000u);
+
+    const auto& constEmployees = employees;
+    static_assert(std::is_same_v<decltype(constEmployees.column<0>()), utils::ColumnSpan<const std::string>>);
+    EXPECT_EQ(constEmployees.column<0>()[3], "Ewa Kot");
+
+    employees.pop_back();
+    EXPECT_EQ(employees.column<0>().size(), 3u);
+}
+
+TEST(SoaVectorTests, shouldHandOutRowsThatBehaveLikeTheAggregate)
+{
+    utils::soa_vector<Person> people{{"Jan Kowalski", 40}, {"Anna Nowak", 28}};
+
+    auto [name, age] = people[1];
+    age = 29;
+    EXPECT_EQ(name, "Anna Nowak");
+    EXPECT_EQ(people.column<1>()[1], 29u);
+
+    const Person copy = people[0];
+    EXPECT_EQ(copy.full_name, "Jan Kowalski");
+
+    people[0] = Person{"Jan Nowak", 41};
+    EXPECT_EQ(people[0].get<0>(), "Jan Nowak");
+    EXPECT_TRUE((people[0] == Person{"Jan Nowak", 41}));
+    EXPECT_TRUE((people[0] != people[1]));
+
+    people[1] = people[0];
+    EXPECT_EQ(people.column<1>()[1], 41u);
+    EXPECT_THROW(people.at(2), std::out_of_range);
+}
+
+TEST(SoaVectorTests, shouldWorkWithIteratorsAndAlgorithms)
+{
+    utils::soa_vector<Person> people{{"Jan", 40}, {"Anna", 28}, {"Piotr", 35}};
+    const auto over30 = std::count_if(people.begin(), people.end(), [](const auto& row) { return row.template get<1>() > 30; });
+    EXPECT_EQ(over30, 2);
+
+    const auto found = std::find(people.begin(), people.end(), Person{"Anna", 28});
+    EXPECT_EQ(found - people.begin(), 1);
+    EXPECT_EQ((*(people.end() - 1)).get<0>(), "Piotr");
+}
+
+TEST(SoaVectorTests, shouldPrintRowsLikeAggregates)
+{
+    const utils::soa_vector<Person> people{{"Jan Kowalski", 40}, {"Anna Nowak", 28}};
+    EXPECT_EQ(toString(people), "[{Jan Kowalski, 40}, {Anna Nowak, 28}]");
+    EXPECT_EQ(utils::formatRange(people), "[{Jan Kowalski, 40}, {Anna Nowak, 28}]");
+}
+
+TEST(SoaVectorTests, shouldKeepColumnsInStepWhenFieldConstructorThrows)
+{
+    utils::soa_vector<Visitor> visitors;
+    for(int i = 0; i < 5; ++i)
+    {
+        visitors.emplace_back("guest " + std::to_string(i), i);
+        EXPECT_THROW(visitors.emplace_back("intruder", -1), std::invalid_argument);
+        EXPECT_EQ(visitors.column<0>().size(), visitors.size());
+        EXPECT_EQ(visitors.column<1>().size(), visitors.size());
+    }
+    EXPECT_EQ(visitors.size(), 5u);
+    EXPECT_EQ(visitors.back().get<0>(), "guest 4");
+    EXPECT_EQ(visitors.back().get<1>().number, 4);
+}
+
+TEST(SoaVectorTests, shouldKeepRowsWhenColumnGrowthCopyThrows)
+{
+    utils::soa_vector<Ticket> tickets;
+    tickets.reserve(3);
+    for(int i = 0; i < 3; ++i)
+    {
+        tickets.emplace_back("holder " + std::to_string(i), i);
+    }
+    Stamp::copiesLeft = 1;
+    EXPECT_THROW(tickets.emplace_back("late", 3), std::runtime_error);
+    Stamp::copiesLeft = -1;
+    EXPECT_EQ(tickets.column<0>().size(), 3u);
+    EXPECT_EQ(tickets.column<1>().size(), 3u);
+    for(int i = 0; i < 3; ++i)
+    {
+        EXPECT_EQ(tickets[i].get<0>(), "holder " + std::to_string(i));
+        EXPECT_EQ(tickets[i].get<1>().number, i);
+    }
+}
+
+TEST(SoaVectorTests, shouldKeepColumnsInStepWhenResizeThrows)
+{
+    utils::soa_vector<Booking> bookings;
+    bookings.resize(2);
+    Seat::soldOut = true;
+    EXPECT_THROW(bookings.resize(5), std::runtime_error);
+    Seat::soldOut = false;
+    EXPECT_EQ(bookings.size(), 2u);
+    EXPECT_EQ(bookings.column<0>().size(), 2u);
+    EXPECT_EQ(bookings.column<1>().size(), 2u);
+    bookings.resize(1);
+    EXPECT_EQ(bookings.column<1>().size(), 1u);
+}
+
+TEST(SoaVectorTests, shouldEmplaceFieldsReferringIntoItself)
+{
+    utils::soa_vector<Person> people{{"Jan Kowalski with a name too long for the small string buffer", 40}};
+    for(int i = 0; i < 5; ++i)
+    {
+        people.emplace_back(people[0].get<0>(), people[0].get<1>());
+        people.push_back(people.back());
+    }
+    EXPECT_EQ(people.size(), 11u);
+    for(const auto& person : people)
+    {
+        EXPECT_EQ(person, (Person{"Jan Kowalski with a name too long for the small string buffer", 40}));
+    }
+}
@@ -0,0 +1,171 @@
+#include <gtest/gtest.h>
+#include "utils/MonotonicArena.hpp"
+#include "utils/RangePrinter.hpp"
+#include "utils/Vector.hpp"
+
+#include <list>
+#include <memory>
+#include <memory_resource>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+
+using namespace ::testing;
+
+namespace
+{
+// Counts live instances, copying throws once copiesLeft runs out.
+struct Counted
+{
+    static inline int alive{};
+    static inline int copiesLeft{};
+
+    Counted() { ++alive; }
+    Counted(const Counted&)
+    {
+        if(copiesLeft-- == 0)
+        {
+            throw std::runtime_error{"copy"};
+        }
+        ++alive;
+    }
+    ~Counted() { --alive; }
+};
+
+template<typename Range>
+std::string toString(const Range& range)
+{
+    std::stringstream os;
+    os << utils::printRange(range);
+    return os.str();
+}
+}
+
+TEST(VectorTests, shouldDeduceElementAndAllocatorTypes)
+{
+    const std::list<int> range{1, 2, 3};
+
+    utils::vector fromIterators(range.begin(), range.end());
+    static_assert(std::is_same_v<decltype(fromIterators), utils::vector<int>>);
+
+    std::pmr::polymorphic_allocator<int> allocator;
+    utils::vector withAllocator(range.begin(), range.end(), allocator);
+    static_assert(std::is_same_v<decltype(withAllocator), utils::pmr::vector<int>>);
+
+    utils::MonotonicArena arena;
+    utils::vector withResource(range.begin(), range.end(), &arena);
+    static_assert(std::is_same_v<decltype(withResource), utils::pmr::vector<int>>);
+    EXPECT_EQ(withResource.get_allocator().resource(), &arena);
+
+    EXPECT_EQ(toString(withResource), "[1, 2, 3]");
+}
+
+TEST(VectorTests, shouldGrowAndShrink)
+{
+    utils::vector<std::string> v;
+    for(int i = 0; i < 100; ++i)
+    {
+        v.push_back(std::to_string(i));
+    }
+    v.push_back(v[0]);
+    EXPECT_EQ(v.size(), 101u);
+    EXPECT_EQ(v.back(), "0");
+
+    v.resize(3);
+    EXPECT_EQ(toString(v), "[0, 1, 2]");
+    v.resize(5, "x");
+    EXPECT_EQ(toString(v), "[0, 1, 2, x, x]");
+    v.pop_back();
+    EXPECT_EQ(v.size(), 4u);
+    EXPECT_THROW(v.at(4), std::out_of_range);
+
+    v.resize(v.capacity() + 1, v[0]);
+    EXPECT_EQ(v.back(), "0");
+    utils::vector<int> numbers{7};
+    numbers.resize(10, numbers[0]);
+    EXPECT_EQ(toString(numbers), "[7, 7, 7, 7, 7, 7, 7, 7, 7, 7]");
+
+    utils::vector<std::unique_ptr<int>> handles;
+    for(int i = 0; i < 100; ++i)
+    {
+        handles.emplace_back(std::make_unique<int>(i));
+    }
+    EXPECT_EQ(*handles[99], 99);
+}
+
+TEST(VectorTests, shouldPassItsResourceToElements)
+{
+    utils::MonotonicArena arena;
+    utils::pmr::vector<std::pmr::string> strings{&arena};
+    strings.emplace_back("a string too long for the small string buffer");
+    EXPECT_EQ(strings[0].get_allocator().resource(), &arena);
+
+    // Copies use the default resource, moves between resources move the elements.
+    const utils::pmr::vector<std::pmr::string> copy{strings};
+    EXPECT_EQ(copy.get_allocator().resource(), std::pmr::get_default_resource());
+    EXPECT_EQ(copy, strings);
+
+    utils::MonotonicArena other;
+    utils::pmr::vector<std::pmr::string> moved{std::move(strings), &other};
+    EXPECT_EQ(moved[0].get_allocator().resource(), &other);
+    EXPECT_EQ(moved, copy);
+}
+
+TEST(VectorTests, shouldRespectAllocatorPropagationOnAssignment)
+{
+    utils::MonotonicArena first;
+    utils::MonotonicArena second;
+    utils::pmr::vector<int> lhs{{1, 2}, &first};
+    utils::pmr::vector<int> rhs{{3, 4, 5}, &second};
+
+    lhs = rhs;
+    EXPECT_EQ(lhs.get_allocator().resource(), &first);
+    EXPECT_EQ(lhs, rhs);
+
+    lhs = std::move(rhs);
+    EXPECT_EQ(lhs.get_allocator().resource(), &first);
+    EXPECT_EQ(toString(lhs), "[3, 4, 5]");
+
+    utils::vector<int> stdLhs{1};
+    utils::vector<int> stdRhs{2, 3};
+    const auto* data = stdRhs.data();
+    stdLhs = std::move(stdRhs);
+    EXPECT_EQ(stdLhs.data(), data);
+    EXPECT_TRUE(stdRhs.empty());
+}
+
+TEST(VectorTests, shouldReleaseElementsWhenConstructionThrows)
+{
+    const std::list<Counted> source(3);
+    Counted::copiesLeft = 2;
+    EXPECT_THROW((utils::vector<Counted>(source.begin(), source.end())), std::runtime_error);
+    Counted::copiesLeft = 2;
+    EXPECT_THROW((utils::vector<Counted>(3, source.front())), std::runtime_error);
+    Counted::copiesLeft = 2;
+    EXPECT_THROW((utils::vector<Counted>{Counted{}, Counted{}, Counted{}}), std::runtime_error);
+    EXPECT_EQ(Counted::alive, 3);
+}
+
+TEST(VectorTests, shouldKeepElementsWhenGrowthCopyThrows)
+{
+    {
+        utils::vector<Counted> vec;
+        vec.reserve(3);
+        vec.emplace_back();
+        vec.emplace_back();
+        vec.emplace_back();
+        const auto* data = vec.data();
+        Counted::copiesLeft = 2;
+        EXPECT_THROW(vec.emplace_back(), std::runtime_error);
+        EXPECT_EQ(vec.size(), 3u);
+        EXPECT_EQ(vec.data(), data);
+        Counted::copiesLeft = 1;
+        EXPECT_THROW(vec.reserve(8), std::runtime_error);
+        EXPECT_EQ(vec.size(), 3u);
+        EXPECT_EQ(vec.capacity(), 3u);
+        EXPECT_EQ(Counted::alive, 3);
+    }
+    EXPECT_EQ(Counted::alive, 0);
+}